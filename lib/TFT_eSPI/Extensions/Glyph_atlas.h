@@ -0,0 +1,152 @@
+// Glyph atlas and colour runs for the smooth font extension.
+// Plain C++ with no Arduino or TFT_eSPI types, so test/test_font builds it on a host.
+
+#ifndef _GLYPH_ATLAS_H_
+#define _GLYPH_ATLAS_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/***************************************************************************************
+** Class name:              GlyphAtlas
+** Description:             Alpha bitmaps of a font file kept in RAM (PSRAM when fitted),
+**                          so drawGlyph does not seek and read the file for every
+**                          character. The least recently used glyph is evicted when
+**                          GLYPH_ATLAS_SLOTS or the byte budget is reached.
+***************************************************************************************/
+#define GLYPH_ATLAS_SLOTS 96
+
+class GlyphAtlas
+{
+  public:
+
+  // Reads len bytes of bitmap at offset in the font file, false when it cannot
+  typedef bool (*readFn)(void* ctx, uint32_t offset, uint8_t* buf, uint16_t len);
+
+  uint32_t hits   = 0;
+  uint32_t misses = 0;
+  uint32_t bytes  = 0;   // bitmap bytes held
+  uint32_t budget = 0;
+
+  bool begin(uint16_t glyphCount, uint32_t byteBudget)
+  {
+    end();
+    slots  = (glyphSlot*)calloc(GLYPH_ATLAS_SLOTS, sizeof(glyphSlot));
+    slotOf = (uint8_t*)malloc(glyphCount);
+    if (!slots || !slotOf) { end(); return false; }
+    memset(slotOf, 0xFF, glyphCount);
+    budget = byteBudget;
+    bytes = tick = hits = misses = 0;
+    return true;
+  }
+
+  void end(void)
+  {
+    if (slots)
+    {
+      for (uint8_t i = 0; i < GLYPH_ATLAS_SLOTS; i++) if (slots[i].bitmap) free(slots[i].bitmap);
+      free(slots);
+      slots = NULL;
+    }
+    if (slotOf)
+    {
+      free(slotOf);
+      slotOf = NULL;
+    }
+    bytes = 0;
+  }
+
+  // The cached bitmap of glyph gNum (size bytes at offset in the file), read on a miss.
+  // nullptr if it cannot be cached, the caller then reads the file itself.
+  const uint8_t* get(uint16_t gNum, uint32_t offset, uint16_t size, readFn read, void* ctx)
+  {
+    if (!slots || !slotOf) return nullptr;
+
+    uint8_t slot = slotOf[gNum];
+    if (slot != 0xFF)
+    {
+      slots[slot].lastUse = ++tick;
+      hits++;
+      return slots[slot].bitmap;
+    }
+
+    misses++;
+    if (size == 0 || size > budget) return nullptr;
+
+    // Find a free slot, evict least recently used glyphs until the bitmap fits
+    while (true)
+    {
+      uint8_t lru = 0xFF;
+      slot = 0xFF;
+      for (uint8_t i = 0; i < GLYPH_ATLAS_SLOTS; i++)
+      {
+        if (!slots[i].bitmap) { if (slot == 0xFF) slot = i; continue; }
+        if (lru == 0xFF || slots[i].lastUse < slots[lru].lastUse) lru = i;
+      }
+      if (slot != 0xFF && bytes + size <= budget) break;
+      if (lru == 0xFF) return nullptr;
+      slotOf[slots[lru].gNum] = 0xFF;
+      bytes -= slots[lru].size;
+      free(slots[lru].bitmap);
+      slots[lru].bitmap = nullptr;
+    }
+
+    uint8_t* bitmap = nullptr;
+  #if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+    if (psramFound()) bitmap = (uint8_t*)ps_malloc(size);
+    else
+  #endif
+    bitmap = (uint8_t*)malloc(size);
+    if (!bitmap) return nullptr;
+
+    if (!read(ctx, offset, bitmap, size))
+    {
+      free(bitmap);
+      return nullptr;
+    }
+
+    slots[slot].bitmap  = bitmap;
+    slots[slot].gNum    = gNum;
+    slots[slot].size    = size;
+    slots[slot].lastUse = ++tick;
+    slotOf[gNum] = slot;
+    bytes += size;
+    return bitmap;
+  }
+
+  private:
+
+  typedef struct
+  {
+    uint8_t* bitmap;
+    uint16_t gNum;
+    uint16_t size;
+    uint32_t lastUse;
+  } glyphSlot;
+
+  glyphSlot* slots  = NULL;
+  uint8_t*   slotOf = NULL;  // glyph index -> slot, 0xFF when not cached
+  uint32_t   tick   = 0;
+};
+
+/***************************************************************************************
+** Function name:           glyphRuns
+** Description:             Calls out(alpha, length) for each run of equal alpha in a
+**                          glyph bitmap. The bitmap is row after row like the pixels of
+**                          an address window, so runs carry on over the end of a row
+***************************************************************************************/
+template <class Out>
+void glyphRuns(const uint8_t* alpha, uint32_t count, Out out)
+{
+  uint32_t i = 0;
+  while (i < count)
+  {
+    uint8_t  a = alpha[i];
+    uint32_t start = i;
+    while (++i < count && alpha[i] == a);
+    out(a, i - start);
+  }
+}
+
+#endif // _GLYPH_ATLAS_H_
@@ -178,6 +178,9 @@ void TFT_eSPI::loadMetrics(void)
     gBitmap   = (uint32_t*)malloc( gFont.gCount * 4); // seek pointer to glyph bitmap in the file
   }
 
+  gMap = (uint32_t*)malloc( GLYPH_MAP_SIZE * 4 );
+  if (gMap) memset(gMap, 0xFF, GLYPH_MAP_SIZE * 4);
+
 #ifdef SHOW_ASCENT_DESCENT
   Serial.print("ascent  = "); Serial.println(gFont.ascent);
   Serial.print("descent = "); Serial.println(gFont.descent);
@@ -238,6 +241,10 @@ void TFT_eSPI::loadMetrics(void)
 
     bitmapPtr += gWidth[gNum] * gHeight[gNum];
 
+    // First glyph of each map entry wins, later ones are found by getUnicodeIndex()
+    if (gMap && gMap[gUnicode[gNum] % GLYPH_MAP_SIZE] == 0xFFFFFFFF)
+      gMap[gUnicode[gNum] % GLYPH_MAP_SIZE] = ((uint32_t)gUnicode[gNum] << 16) | gNum;
+
     gNum++;
     yield();
   }
@@ -245,7 +252,34 @@ void TFT_eSPI::loadMetrics(void)
   gFont.yAdvance = gFont.maxAscent + gFont.maxDescent;
 
   gFont.spaceWidth = (gFont.ascent + gFont.descent) * 2/7;  // Guess at space width
+
+#ifdef FONT_FS_AVAILABLE
+  if (fs_font)
+  {
+  #if defined (ESP32) && defined (CONFIG_SPIRAM_SUPPORT)
+    gAtlas.begin(gFont.gCount, psramFound() ? 96 * 1024 : 12 * 1024);
+  #else
+    gAtlas.begin(gFont.gCount, 12 * 1024);
+  #endif
+  }
+#endif
+}
+
+
+#ifdef FONT_FS_AVAILABLE
+/***************************************************************************************
+** Function name:           getGlyphBitmap
+** Description:             Return the cached alpha bitmap of a glyph, loading it from the
+**                          font file on a miss. nullptr if it cannot be cached.
+*************************************************************************************x*/
+const uint8_t* TFT_eSPI::getGlyphBitmap(uint16_t gNum)
+{
+  return gAtlas.get(gNum, gBitmap[gNum], gWidth[gNum] * gHeight[gNum], [](void* ctx, uint32_t offset, uint8_t* buf, uint16_t len) {
+    fs::File& file = ((TFT_eSPI*)ctx)->fontFile;
+    return file.seek(offset, fs::SeekSet) && file.read(buf, len) == len;
+  }, this);
 }
+#endif
 
 
 /***************************************************************************************
@@ -296,9 +330,16 @@ void TFT_eSPI::unloadFont( void )
     gBitmap = NULL;
   }
 
+  if (gMap)
+  {
+    free(gMap);
+    gMap = NULL;
+  }
+
   gFont.gArray = nullptr;
 
 #ifdef FONT_FS_AVAILABLE
+  gAtlas.end();
   if (fs_font && fontFile) fontFile.close();
 #endif
 
@@ -340,11 +381,20 @@ uint32_t TFT_eSPI::readInt32(void)
 *************************************************************************************x*/
 bool TFT_eSPI::getUnicodeIndex(uint16_t unicode, uint16_t *index)
 {
+  uint32_t* entry = gMap ? &gMap[unicode % GLYPH_MAP_SIZE] : nullptr;
+
+  if (entry && *entry != 0xFFFFFFFF && (*entry >> 16) == unicode)
+  {
+    *index = *entry & 0xFFFF;
+    return true;
+  }
+
   for (uint16_t i = 0; i < gFont.gCount; i++)
   {
     if (gUnicode[i] == unicode)
     {
       *index = i;
+      if (entry) *entry = ((uint32_t)unicode << 16) | i; // Most recent code takes the entry
       return true;
     }
   }
@@ -408,10 +458,14 @@ void TFT_eSPI::drawGlyph(uint16_t code)
     const uint8_t* gPtr = (const uint8_t*) gFont.gArray;
 
 #ifdef FONT_FS_AVAILABLE
+    const uint8_t* gCached = nullptr;
     if (fs_font)
     {
-      fontFile.seek(gBitmap[gNum], fs::SeekSet);
-      pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      gCached = getGlyphBitmap(gNum);
+      if (!gCached) {
+        fontFile.seek(gBitmap[gNum], fs::SeekSet);
+        pbuffer =  (uint8_t*)malloc(gWidth[gNum]);
+      }
     }
 #endif
 
@@ -458,65 +512,94 @@ void TFT_eSPI::drawGlyph(uint16_t code)
       }
     }
 
-    for (int32_t y = 0; y < gHeight[gNum]; y++)
-    {
+    // With the background filled every pixel of the glyph box has a known colour, so a
+    // bitmap already in RAM goes out as one address window of colour runs instead of a
+    // line or pixel command per run
+    const uint8_t* gAlpha = nullptr;
 #ifdef FONT_FS_AVAILABLE
-      if (fs_font) {
-        if (spiffs)
-        {
-          fontFile.read(pbuffer, gWidth[gNum]);
-          //Serial.println("SPIFFS");
-        }
-        else
-        {
-          endWrite();    // Release SPI for SD card transaction
-          fontFile.read(pbuffer, gWidth[gNum]);
-          startWrite();  // Re-start SPI for TFT transaction
-          //Serial.println("Not SPIFFS");
-        }
-      }
+    if (fs_font) gAlpha = gCached;
+  #ifdef ESP32
+    else gAlpha = gPtr + gBitmap[gNum];  // flash is memory mapped
+  #endif
+#elif defined (ESP32)
+    gAlpha = gPtr + gBitmap[gNum];
 #endif
+    int32_t wx = cx + _xDatum;
+    int32_t wy = cy + _yDatum;
 
-      for (int32_t x = 0; x < gWidth[gNum]; x++)
+    if (gAlpha && _fillbg && !getColor && bx == 0 && !_vpOoB &&
+        wx >= _vpX && wy >= _vpY && wx + gWidth[gNum] <= _vpW && wy + gHeight[gNum] <= _vpH)
+    {
+      setWindow(wx, wy, wx + gWidth[gNum] - 1, wy + gHeight[gNum] - 1);
+      glyphRuns(gAlpha, gWidth[gNum] * gHeight[gNum], [&](uint8_t alpha, uint32_t len) {
+        pushBlock(alpha == 0xFF ? fg : alpha ? alphaBlend(alpha, fg, bg) : bg, len);
+      });
+    }
+    else
+    {
+      for (int32_t y = 0; y < gHeight[gNum]; y++)
       {
 #ifdef FONT_FS_AVAILABLE
-        if (fs_font) pixel = pbuffer[x];
-        else
+        const uint8_t* row = pbuffer;
+        if (gCached) row = gCached + y * gWidth[gNum];
+        else if (fs_font) {
+          if (spiffs)
+          {
+            fontFile.read(pbuffer, gWidth[gNum]);
+            //Serial.println("SPIFFS");
+          }
+          else
+          {
+            endWrite();    // Release SPI for SD card transaction
+            fontFile.read(pbuffer, gWidth[gNum]);
+            startWrite();  // Re-start SPI for TFT transaction
+            //Serial.println("Not SPIFFS");
+          }
+        }
 #endif
-        pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
 
-        if (pixel)
+        for (int32_t x = 0; x < gWidth[gNum]; x++)
         {
-          if (bl) { drawFastHLine( bxs, y + cy, bl, bg); bl = 0; }
-          if (pixel != 0xFF)
+#ifdef FONT_FS_AVAILABLE
+          if (fs_font) pixel = row[x];
+          else
+#endif
+          pixel = pgm_read_byte(gPtr + gBitmap[gNum] + x + gWidth[gNum] * y);
+
+          if (pixel)
           {
-            if (fl) {
-              if (fl==1) drawPixel(fxs, y + cy, fg);
-              else drawFastHLine( fxs, y + cy, fl, fg);
-              fl = 0;
+            if (bl) { drawFastHLine( bxs, y + cy, bl, bg); bl = 0; }
+            if (pixel != 0xFF)
+            {
+              if (fl) {
+                if (fl==1) drawPixel(fxs, y + cy, fg);
+                else drawFastHLine( fxs, y + cy, fl, fg);
+                fl = 0;
+              }
+              if (getColor) bg = getColor(x + cx, y + cy);
+              drawPixel(x + cx, y + cy, alphaBlend(pixel, fg, bg));
+            }
+            else
+            {
+              if (fl==0) fxs = x + cx;
+              fl++;
             }
-            if (getColor) bg = getColor(x + cx, y + cy);
-            drawPixel(x + cx, y + cy, alphaBlend(pixel, fg, bg));
           }
           else
           {
-            if (fl==0) fxs = x + cx;
-            fl++;
-          }
-        }
-        else
-        {
-          if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
-          if (_fillbg) {
-            if (x >= bx) {
-              if (bl==0) bxs = x + cx;
-              bl++;
+            if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
+            if (_fillbg) {
+              if (x >= bx) {
+                if (bl==0) bxs = x + cx;
+                bl++;
+              }
             }
           }
         }
+        if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
+        if (bl) { drawFastHLine( bxs, y + cy, bl, bg); bl = 0; }
       }
-      if (fl) { drawFastHLine( fxs, y + cy, fl, fg); fl = 0; }
-      if (bl) { drawFastHLine( bxs, y + cy, bl, bg); bl = 0; }
+
     }
 
     // Fill area below glyph
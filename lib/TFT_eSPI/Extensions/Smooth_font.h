@@ -42,12 +42,22 @@ fontMetrics gFont = { nullptr, 0, 0, 0, 0, 0, 0, 0 };
 
   bool     fontLoaded = false; // Flags when a anti-aliased font is loaded
 
+  // Direct-mapped Unicode -> glyph index table, avoids a linear scan of gUnicode per character.
+  // Entries are (unicode << 16) | index, 0xFFFFFFFF when empty. Codes below GLYPH_MAP_SIZE never collide.
+  #define GLYPH_MAP_SIZE 256
+  uint32_t* gMap = NULL;
+
 #ifdef FONT_FS_AVAILABLE
   fs::File fontFile;
   fs::FS   &fontFS  = SPIFFS;
   bool     spiffs   = true;
   bool     fs_font = false;    // For ESP32/8266 use smooth font file or FLASH (PROGMEM) array
 
+  // Alpha bitmaps of the file font kept in RAM, see Glyph_atlas.h
+  GlyphAtlas gAtlas;
+
+  const uint8_t* getGlyphBitmap(uint16_t gNum);
+
 #else
   bool     fontFile = true;
 #endif
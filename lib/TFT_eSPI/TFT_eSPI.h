@@ -165,6 +165,7 @@
   #ifndef LOAD_GLCD
     #define LOAD_GLCD
   #endif
+  #include "Extensions/Glyph_atlas.h"  // Glyph cache of the smooth font extension
 #endif
 
 // Only load the fonts defined in User_Setup.h (to save space)
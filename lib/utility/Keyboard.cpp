@@ -13,36 +13,157 @@
 #include <driver/gpio.h>
 
 #include "Arduino.h"
+#include <cstring>
+
+#include <soc/gpio_reg.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 
 #define digitalWrite(pin, level) gpio_set_level((gpio_num_t)pin, level)
 #define digitalRead(pin) gpio_get_level((gpio_num_t)pin)
 
+// The scan task and the readers share the map through a spinlock, a 64 bit
+// store is two 32 bit stores on the ESP32-S3
+static portMUX_TYPE _scan_mux = portMUX_INITIALIZER_UNLOCKED;
+static uint64_t _scan_bits = 0;
+static QueueHandle_t _edge_queue = NULL;
+static TaskHandle_t _scan_task = NULL;
+static uint32_t _scan_period = KB_SCAN_MS;
+static KeyScanStats _scan_stats;
 
-void Keyboard_Class::_set_output(const std::vector<int> &pinList,
-                                 uint8_t output)
+void Keyboard_Class::_set_output(uint8_t output)
 {
-    output = output & 0B00000111;
-
-    digitalWrite(pinList[0], (output & 0B00000001));
-    digitalWrite(pinList[1], (output & 0B00000010));
-    digitalWrite(pinList[2], (output & 0B00000100));
+    // every matrix pin is below 32, one register write per level sets the address lines
+    uint32_t set = 0, clr = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        if (output & (1 << i)) set |= 1UL << output_list[i];
+        else clr |= 1UL << output_list[i];
+    }
+    REG_WRITE(GPIO_OUT_W1TS_REG, set);
+    REG_WRITE(GPIO_OUT_W1TC_REG, clr);
 }
 
-uint8_t Keyboard_Class::_get_input(const std::vector<int> &pinList)
+uint8_t Keyboard_Class::_get_input()
 {
+    uint32_t level = REG_READ(GPIO_IN_REG);
     uint8_t buffer = 0x00;
-    uint8_t pin_value = 0x00;
 
     for (int i = 0; i < 7; i++)
     {
-        pin_value = (digitalRead(pinList[i]) == 1) ? 0x00 : 0x01;
-        pin_value = pin_value << i;
-        buffer = buffer | pin_value;
+        if (!(level & (1UL << input_list[i]))) buffer |= 1 << i;
     }
 
     return buffer;
 }
 
+uint64_t Keyboard_Class::_scan_matrix()
+{
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        _set_output(i);
+        delayMicroseconds(1); // let the decoder and the pull-ups settle
+        bits |= (uint64_t)_get_input() << (i * 8);
+    }
+    return bits;
+}
+
+Point2D_t Keyboard_Class::bitToPoint(uint8_t bit)
+{
+    Point2D_t coor;
+    int i = bit / 8;
+    int j = bit % 8;
+    coor.x = (i > 3) ? X_map_chart[j].x_1 : X_map_chart[j].x_2;
+    /* Keep the same as picture */
+    coor.y = 3 - ((i > 3) ? (i - 4) : i);
+    return coor;
+}
+
+/**
+ * The matrix has no diodes: three keys on the corners of a rectangle make the
+ * fourth read as pressed. When two rows share two inputs the rectangle can't be
+ * told apart, so its keys that were not held on the previous scan are ignored
+ * until it opens again.
+ */
+static uint64_t _reject_ghosts(uint64_t raw, uint64_t prev, bool &ghost)
+{
+    uint64_t out = raw;
+    ghost = false;
+    for (int a = 0; a < 8; a++)
+    {
+        uint8_t rowA = (raw >> (a * 8)) & 0x7F;
+        if (!rowA) continue;
+        for (int b = a + 1; b < 8; b++)
+        {
+            uint8_t shared = rowA & (raw >> (b * 8));
+            if (shared & (shared - 1)) // two or more inputs in common
+            {
+                uint64_t rows = (0x7FULL << (a * 8)) | (0x7FULL << (b * 8));
+                out &= ~rows | prev;
+                ghost = true;
+            }
+        }
+    }
+    return out;
+}
+
+void Keyboard_Class::_scan_loop(void *arg)
+{
+    Keyboard_Class *kb = (Keyboard_Class *)arg;
+    TickType_t wake = xTaskGetTickCount();
+    uint64_t prev = 0;
+    uint32_t second = millis();
+    uint32_t scans = 0;
+
+    for (;;)
+    {
+        uint32_t t0 = micros();
+        bool ghost;
+        uint64_t now = _reject_ghosts(kb->_scan_matrix(), prev, ghost);
+
+        if (now != prev)
+        {
+            portENTER_CRITICAL(&_scan_mux);
+            _scan_bits = now;
+            portEXIT_CRITICAL(&_scan_mux);
+
+            uint32_t ms = millis();
+            for (uint64_t changed = now ^ prev; changed; changed &= changed - 1)
+            {
+                KeyEdge edge;
+                edge.bit = __builtin_ctzll(changed);
+                edge.down = (now >> edge.bit) & 1;
+                edge.ms = ms;
+                if (xQueueSend(_edge_queue, &edge, 0) != pdTRUE)
+                {
+                    // nobody is reading, keep the newest edges
+                    KeyEdge oldest;
+                    xQueueReceive(_edge_queue, &oldest, 0);
+                    xQueueSend(_edge_queue, &edge, 0);
+                    _scan_stats.edgesDropped++;
+                }
+            }
+            prev = now;
+        }
+
+        uint32_t us = micros() - t0;
+        _scan_stats.lastUs = us;
+        if (us > _scan_stats.maxUs) _scan_stats.maxUs = us;
+        if (ghost) _scan_stats.ghosts++;
+        _scan_stats.scans++;
+        scans++;
+        if (millis() - second >= 1000)
+        {
+            _scan_stats.rateHz = scans;
+            scans = 0;
+            second = millis();
+        }
+
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(_scan_period));
+    }
+}
+
 void Keyboard_Class::begin()
 {
     for (auto i : output_list)
@@ -60,7 +181,65 @@ void Keyboard_Class::begin()
         gpio_set_pull_mode((gpio_num_t)i, GPIO_PULLUP_ONLY);
     }
 
-    _set_output(output_list, 0);
+    _set_output(0);
+
+    memset(_char_bit, KB_NO_KEY, sizeof(_char_bit));
+    for (int bit = 0; bit < 64; bit++)
+    {
+        if (bit % 8 == 7) continue;
+        KeyValue_t v = getKeyValue(bitToPoint(bit));
+        _char_bit[0][(uint8_t)v.value_first] = bit;
+        _char_bit[1][(uint8_t)v.value_second] = bit;
+    }
+    _bits_valid = false;
+}
+
+bool Keyboard_Class::startScan(uint32_t periodMs)
+{
+    if (_scan_task) return true;
+    _scan_period = periodMs ? periodMs : KB_SCAN_MS;
+    memset(&_scan_stats, 0, sizeof(_scan_stats));
+    _edge_queue = xQueueCreate(KB_EDGE_DEPTH, sizeof(KeyEdge));
+    if (_edge_queue == NULL) return false;
+    // above the loop task so a busy UI doesn't stall the scan, it sleeps between scans
+    if (xTaskCreatePinnedToCore(_scan_loop, "kbScan", 2048, this, 2, &_scan_task, 1) != pdPASS)
+    {
+        vQueueDelete(_edge_queue);
+        _edge_queue = NULL;
+        _scan_task = NULL;
+        return false;
+    }
+    return true;
+}
+
+bool Keyboard_Class::scanning()
+{
+    return _scan_task != NULL;
+}
+
+uint64_t Keyboard_Class::bits()
+{
+    if (!_scan_task) return _bits;
+    portENTER_CRITICAL(&_scan_mux);
+    uint64_t b = _scan_bits;
+    portEXIT_CRITICAL(&_scan_mux);
+    return b;
+}
+
+uint8_t Keyboard_Class::keyBit(char c, bool second)
+{
+    return _char_bit[second ? 1 : 0][(uint8_t)c];
+}
+
+bool Keyboard_Class::readEdge(KeyEdge &edge, uint32_t timeoutMs)
+{
+    if (_edge_queue == NULL) return false;
+    return xQueueReceive(_edge_queue, &edge, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+const KeyScanStats &Keyboard_Class::scanStats()
+{
+    return _scan_stats;
 }
 
 uint8_t Keyboard_Class::getKey(Point2D_t keyCoor)
@@ -83,39 +262,22 @@ uint8_t Keyboard_Class::getKey(Point2D_t keyCoor)
     return ret;
 }
 
-void Keyboard_Class::updateKeyList()
+bool Keyboard_Class::updateKeyList()
 {
-    _key_list_buffer.clear();
-    Point2D_t coor;
-    uint8_t input_value = 0;
+    uint64_t bits = _scan_task ? Keyboard_Class::bits() : _scan_matrix();
+    if (_bits_valid && bits == _bits) return false; // the list is still right
+    _set_bits(bits);
+    return true;
+}
 
-    for (int i = 0; i < 8; i++)
+void Keyboard_Class::_set_bits(uint64_t bits)
+{
+    _bits = bits;
+    _bits_valid = true;
+    _key_list_buffer.clear();
+    for (uint64_t left = bits; left; left &= left - 1)
     {
-        _set_output(output_list, i);
-        input_value = _get_input(input_list);
-        /* If key pressed */
-
-        if (input_value)
-        {
-            /* Get X */
-            for (int j = 0; j < 7; j++)
-            {
-                if (input_value & (0x01 << j))
-                {
-                    coor.x = (i > 3) ? X_map_chart[j].x_1 : X_map_chart[j].x_2;
-
-                    /* Get Y */
-                    coor.y = (i > 3) ? (i - 4) : i;
-                    // printf("%d,%d\t", coor.x, coor.y);
-
-                    /* Keep the same as picture */
-                    coor.y = -coor.y;
-                    coor.y = coor.y + 3;
-
-                    _key_list_buffer.push_back(coor);
-                }
-            }
-        }
+        _key_list_buffer.push_back(bitToPoint(__builtin_ctzll(left)));
     }
 }
 
@@ -139,18 +301,11 @@ bool Keyboard_Class::isChange()
 
 bool Keyboard_Class::isKeyPressed(char c)
 {
-    if (_key_list_buffer.size())
-    {
-        for (const auto &i : _key_list_buffer)
-        {
-            if (getKey(i) == c)
-                return true;
-        }
-    }
-    return false;
+    bool second = _keys_state_buffer.ctrl || _keys_state_buffer.shift || _is_caps_locked;
+    uint8_t bit = _char_bit[second ? 1 : 0][(uint8_t)c];
+    return bit != KB_NO_KEY && ((_bits >> bit) & 1);
 }
 
-#include <cstring>
 
 void Keyboard_Class::updateKeysState()
 {
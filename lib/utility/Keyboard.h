@@ -28,8 +28,32 @@ struct Point2D_t
     int y;
 };
 
-const std::vector<int> output_list = {8, 9, 11};
-const std::vector<int> input_list = {13, 15, 3, 4, 5, 6, 7};
+const int output_list[3] = {8, 9, 11};            // 74HC138 address lines, 8 scan rows
+const int input_list[7] = {13, 15, 3, 4, 5, 6, 7};
+
+/* Background scan: a task scans the matrix every KB_SCAN_MS into a 64 bit map,
+ * bit (row * 8 + input) for scan row 0-7 and input 0-6, and queues the edges.
+ * update() and the key checks then only read that map. */
+#define KB_SCAN_MS 5
+#define KB_EDGE_DEPTH 32
+#define KB_NO_KEY 0xFF
+
+struct KeyEdge
+{
+    uint8_t bit;
+    bool down;
+    uint32_t ms;
+};
+
+struct KeyScanStats
+{
+    uint32_t scans;
+    uint32_t ghosts;       // scans where a new key closed a rectangle and was ignored
+    uint32_t edgesDropped; // edge queue was full
+    uint32_t lastUs;       // time spent in the last scan
+    uint32_t maxUs;
+    uint32_t rateHz;       // scans in the last second
+};
 
 const Chart_t X_map_chart[7] = {{1, 0, 1}, {2, 2, 3}, {4, 4, 5}, {8, 6, 7}, {16, 8, 9}, {32, 10, 11}, {64, 12, 13}};
 
@@ -144,18 +168,41 @@ private:
     bool _is_caps_locked;
     uint8_t _last_key_size;
 
-    void _set_output(const std::vector<int> &pinList, uint8_t output);
-    uint8_t _get_input(const std::vector<int> &pinList);
+    uint64_t _bits;             // map the key list was built from
+    bool _bits_valid;
+    uint8_t _char_bit[2][256];  // key of each char, first and second value
+
+    void _set_output(uint8_t output);
+    uint8_t _get_input();
+    uint64_t _scan_matrix();
+    void _set_bits(uint64_t bits);
+    static void _scan_loop(void *arg);
 
 public:
-    Keyboard_Class() : _is_caps_locked(false)
+    Keyboard_Class() : _is_caps_locked(false), _last_key_size(0), _bits(0), _bits_valid(false)
     {
     }
 
     void begin();
+
+    // Starts the scan task, update() scans in the caller until then
+    bool startScan(uint32_t periodMs = KB_SCAN_MS);
+    bool scanning();
+
+    // Current map, safe to call from any task
+    uint64_t bits();
+    // Key of a char (KB_NO_KEY if none), second picks the shifted layer
+    uint8_t keyBit(char c, bool second = false);
+    bool isBitDown(uint8_t bit) { return bit < 64 && (bits() >> bit) & 1; }
+    static Point2D_t bitToPoint(uint8_t bit);
+
+    // Next press or release, false once the queue is empty after timeoutMs
+    bool readEdge(KeyEdge &edge, uint32_t timeoutMs = 0);
+    const KeyScanStats &scanStats();
     uint8_t getKey(Point2D_t keyCoor);
 
-    void updateKeyList();
+    // Rebuilds the key list, false when the keys didn't change since the last call
+    bool updateKeyList();
 
     inline std::vector<Point2D_t> &keyList()
     {
@@ -175,8 +222,8 @@ public:
 
     void update()
     {
-        updateKeyList();
-        updateKeysState();
+        if (updateKeyList())
+            updateKeysState();
     }
     inline KeysState &keysState()
     {
@@ -190,6 +237,7 @@ public:
     inline void setCapsLocked(bool isLocked)
     {
         _is_caps_locked = isLocked;
+        _bits_valid = false; // the word follows caps lock
     }
 };
 #endif
@@ -0,0 +1,159 @@
+// Generated by tools/rle_assets.py from media/xbm/bruce_logo.xbm, do not edit
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "rle.h"
+
+// bruce_logo.xbm, 237x133: 3990 bytes as bitmap, 2344 as RLE
+static const uint8_t bruce_logo_rle[] PROGMEM = {
+  0xF5, 0x02, 0x32, 0xF8, 0x06, 0x41, 0x06, 0x00, 0xC1, 0x06, 0x0E, 0x00, 0x65, 0x0A, 0x00, 0xBD,
+  0x06, 0x7A, 0xF8, 0x7E, 0xFF, 0x1F, 0xBD, 0x06, 0x7E, 0xD8, 0xBF, 0xBF, 0x3F, 0xB5, 0x06, 0x16,
+  0x08, 0x49, 0x2E, 0x00, 0x01, 0xAD, 0x06, 0x4A, 0xF8, 0xD7, 0x03, 0x54, 0x0A, 0x01, 0x8D, 0x06,
+  0xBA, 0x01, 0x70, 0x7F, 0x5F, 0xE6, 0x36, 0x00, 0x81, 0x06, 0xCE, 0x01, 0xE8, 0xFB, 0xDD, 0x9D,
+  0x54, 0x07, 0x02, 0xE5, 0x05, 0xDA, 0x01, 0xF0, 0xBD, 0x4A, 0x4D, 0xAD, 0xD5, 0x00, 0xDD, 0x05,
+  0xEE, 0x01, 0xA8, 0xD6, 0xB5, 0xBB, 0xD3, 0x6A, 0x17, 0x00, 0xC5, 0x05, 0xFE, 0x01, 0xB8, 0xF5,
+  0x6A, 0x59, 0x59, 0xB6, 0xA9, 0x05, 0xB9, 0x05, 0x86, 0x02, 0x28, 0x0A, 0xB5, 0xAA, 0x76, 0x69,
+  0xD5, 0x1A, 0x00, 0xAD, 0x05, 0x96, 0x02, 0x10, 0xCA, 0xAA, 0x56, 0x23, 0xCF, 0x75, 0xCD, 0x03,
+  0xF1, 0x02, 0x0E, 0x02, 0xA5, 0x02, 0x9E, 0x02, 0x00, 0x31, 0x53, 0xBB, 0xFD, 0x7C, 0xDF, 0xBB,
+  0x0A, 0xE5, 0x02, 0x1A, 0x02, 0x99, 0x02, 0xA6, 0x02, 0x00, 0xD0, 0x3B, 0x99, 0xBA, 0x57, 0xDB,
+  0xAA, 0x7F, 0x00, 0xE5, 0x02, 0x22, 0x1E, 0x85, 0x02, 0xB6, 0x02, 0x50, 0xB4, 0x5A, 0xAB, 0x5D,
+  0xF7, 0xEB, 0xFE, 0x6B, 0x02, 0xFD, 0x02, 0x12, 0x04, 0xF1, 0x01, 0xC2, 0x02, 0x88, 0x55, 0xCB,
+  0xEA, 0xB5, 0xAE, 0xEB, 0xFA, 0xFB, 0x3E, 0xD9, 0x02, 0x32, 0x94, 0x01, 0xE9, 0x01, 0xCA, 0x02,
+  0x00, 0x54, 0x6B, 0xBB, 0xFD, 0xFB, 0xBE, 0xDF, 0xAD, 0x63, 0x00, 0xDD, 0x02, 0x3A, 0xAE, 0x13,
+  0xD5, 0x01, 0xD2, 0x02, 0x00, 0xB8, 0xED, 0xFB, 0xFF, 0xBC, 0xEF, 0xFF, 0xFA, 0xF4, 0x07, 0xDD,
+  0x02, 0x3A, 0xFE, 0x0D, 0xC9, 0x01, 0xA2, 0x01, 0x10, 0x31, 0x35, 0x5B, 0x75, 0x51, 0x6E, 0xEE,
+  0x73, 0x4F, 0x01, 0xDD, 0x02, 0x42, 0xEE, 0x0F, 0xB5, 0x01, 0xEE, 0x02, 0x80, 0x20, 0xD7, 0xFF,
+  0xF7, 0x7D, 0xFF, 0xDD, 0xDB, 0xB7, 0xEC, 0x00, 0xD9, 0x02, 0x42, 0x9E, 0x3C, 0xAD, 0x01, 0x86,
+  0x02, 0x08, 0xB8, 0xF5, 0x96, 0x76, 0xDE, 0x5B, 0xFD, 0x00, 0x69, 0x06, 0x00, 0x99, 0x03, 0x0A,
+  0x00, 0xA1, 0x01, 0xFE, 0x02, 0x00, 0xD0, 0x5F, 0xF5, 0xFB, 0xFF, 0xBD, 0xB6, 0xBF, 0xFF, 0xFA,
+  0x1E, 0xD5, 0x02, 0x4E, 0x7E, 0xFD, 0x00, 0x91, 0x01, 0xC2, 0x02, 0x90, 0xB8, 0xAE, 0xFF, 0xBC,
+  0xB2, 0xDA, 0xEF, 0xFD, 0x77, 0x41, 0x06, 0x00, 0xED, 0x02, 0x3E, 0xEE, 0x0F, 0x89, 0x01, 0x8E,
+  0x03, 0x80, 0x9A, 0xDB, 0xF5, 0xB3, 0xEA, 0xED, 0xBF, 0xDF, 0xFD, 0xFB, 0xF7, 0x00, 0xD1, 0x02,
+  0x5E, 0xFE, 0xEF, 0x0F, 0x75, 0x96, 0x03, 0x00, 0xB4, 0xF3, 0x7B, 0xFD, 0xFF, 0x7C, 0xF3, 0xD3,
+  0x3A, 0xFF, 0xFE, 0x0F, 0xD5, 0x02, 0x5E, 0x7E, 0xFE, 0x1F, 0x6D, 0xAA, 0x01, 0x20, 0x68, 0x7E,
+  0xBA, 0xF7, 0x01, 0x4D, 0xAA, 0x01, 0xD2, 0x6A, 0xDF, 0xBF, 0xBF, 0x00, 0xE1, 0x02, 0x5A, 0x6E,
+  0xF9, 0x03, 0x5D, 0xA6, 0x03, 0x00, 0xB4, 0xCF, 0xBF, 0x3B, 0x37, 0xBB, 0xEB, 0x5D, 0x6D, 0x7F,
+  0xBF, 0xBF, 0x00, 0xD1, 0x02, 0x6A, 0xF6, 0xDB, 0x7A, 0x00, 0x55, 0xAE, 0x03, 0x00, 0xEE, 0xEE,
+  0xBE, 0x7F, 0xDF, 0xEF, 0xF9, 0x77, 0xD5, 0xFD, 0xED, 0x7F, 0x00, 0xD1, 0x02, 0x22, 0x7E, 0x41,
+  0x0A, 0x00, 0x4D, 0xB2, 0x03, 0xA0, 0xB2, 0xEE, 0xEE, 0xDA, 0x73, 0x7D, 0xFF, 0xD9, 0xFF, 0xF7,
+  0xFF, 0xDB, 0x03, 0xED, 0x02, 0x56, 0xEE, 0xFD, 0x03, 0x41, 0xAA, 0x02, 0x00, 0xBD, 0xFF, 0xAF,
+  0xDC, 0xFF, 0xDF, 0xE7, 0xDF, 0x01, 0x49, 0x4A, 0xDE, 0xB6, 0x00, 0xED, 0x02, 0x06, 0x00, 0x49,
+  0x82, 0x04, 0xF8, 0xFF, 0xC0, 0xD4, 0xAB, 0xEA, 0xFF, 0x6D, 0x7B, 0xFF, 0xFB, 0xAA, 0xFD, 0xFD,
+  0xFF, 0x2D, 0xF1, 0x02, 0xCA, 0x02, 0xDE, 0xFF, 0xE6, 0xFF, 0x80, 0x75, 0x55, 0x95, 0xFD, 0xED,
+  0x01, 0x55, 0x12, 0x02, 0x51, 0x4E, 0xBE, 0x36, 0x01, 0xED, 0x02, 0xBE, 0x01, 0xFE, 0xF7, 0x8F,
+  0x7F, 0x10, 0x0B, 0x59, 0xB6, 0x02, 0xFC, 0xFF, 0xBE, 0x37, 0xFD, 0x73, 0xBF, 0xFF, 0xF7, 0x0F,
+  0xAD, 0x03, 0xBA, 0x03, 0x7E, 0x7F, 0xCA, 0xED, 0x77, 0x77, 0xFB, 0x7E, 0xF7, 0xAB, 0x56, 0xF6,
+  0xFF, 0x1E, 0x4D, 0x0A, 0x00, 0xF1, 0x02, 0xCA, 0x04, 0x66, 0xFB, 0x5F, 0x0F, 0x58, 0xAD, 0xBB,
+  0xFB, 0xFF, 0xFD, 0x5F, 0x55, 0xEA, 0xFF, 0xEF, 0xFF, 0x7E, 0xDB, 0x00, 0xF1, 0x02, 0x06, 0x00,
+  0x59, 0xEA, 0x03, 0x06, 0x62, 0xDD, 0x7B, 0xFF, 0xEF, 0xBE, 0xDB, 0xC3, 0xF6, 0xFF, 0xE6, 0xDF,
+  0xFD, 0xBF, 0x01, 0x91, 0x03, 0xEE, 0x01, 0xF6, 0x5D, 0x01, 0xCE, 0xDA, 0xFE, 0xDE, 0x03, 0x69,
+  0xD6, 0x01, 0xF6, 0x6B, 0xFF, 0xFB, 0xFF, 0x59, 0x07, 0xF9, 0x02, 0x9E, 0x01, 0x7A, 0xFF, 0x1F,
+  0x68, 0x3F, 0x55, 0x2E, 0xBE, 0x03, 0x51, 0xD6, 0x01, 0xF4, 0xBF, 0xFF, 0xAF, 0xFF, 0xFB, 0x06,
+  0xED, 0x02, 0xC6, 0x04, 0xFE, 0xDF, 0x79, 0x70, 0x93, 0xF3, 0xF5, 0xF9, 0xFF, 0x7B, 0xEF, 0xBF,
+  0xEF, 0xBF, 0xEF, 0xFF, 0xFD, 0xEB, 0x00, 0x81, 0x03, 0x06, 0x00, 0x45, 0xA2, 0x02, 0x60, 0xDB,
+  0xF5, 0xEF, 0xFE, 0xFB, 0xEF, 0xB7, 0x3F, 0x4D, 0x1A, 0x1E, 0x45, 0x2A, 0xEE, 0x01, 0xF5, 0x02,
+  0xC2, 0x01, 0xFE, 0xFB, 0x47, 0x66, 0xF9, 0x5B, 0x4D, 0x0A, 0x00, 0x71, 0xC2, 0x01, 0xF6, 0xFB,
+  0xFB, 0x77, 0xB7, 0x36, 0xF1, 0x02, 0xFE, 0x01, 0xBE, 0xDF, 0x85, 0x7B, 0xFB, 0xF5, 0xBF, 0x37,
+  0x45, 0xAA, 0x01, 0xBE, 0xB9, 0xFF, 0xDE, 0xBE, 0x01, 0x41, 0x1E, 0x34, 0x99, 0x03, 0xA6, 0x01,
+  0xFE, 0xA0, 0xB1, 0x97, 0xF7, 0x00, 0x61, 0x06, 0x00, 0x59, 0xBE, 0x01, 0xEA, 0xDF, 0xFF, 0xEF,
+  0xDF, 0x3F, 0xAD, 0x03, 0x8A, 0x04, 0xC6, 0xBA, 0x3F, 0xEB, 0xFD, 0xFF, 0x7D, 0xB7, 0xFF, 0xFD,
+  0xEF, 0xF7, 0xF7, 0xFD, 0xBE, 0xFF, 0x01, 0xF9, 0x02, 0xE6, 0x01, 0xB6, 0x7F, 0xE0, 0xE8, 0xF8,
+  0xFB, 0xB7, 0x00, 0x5D, 0x4E, 0xDA, 0x7F, 0x02, 0x79, 0x3E, 0xDE, 0x16, 0xB1, 0x03, 0x9A, 0x03,
+  0x78, 0xFF, 0xB8, 0xBF, 0xFD, 0xDF, 0x77, 0xBF, 0x5F, 0xF7, 0xF3, 0xEF, 0x1F, 0x69, 0x06, 0x00,
+  0xF9, 0x02, 0xAE, 0x01, 0xFA, 0x1D, 0x34, 0x0D, 0xDD, 0x03, 0x55, 0x06, 0x00, 0x41, 0xFA, 0x01,
+  0xFC, 0xBF, 0xDB, 0xDF, 0x7F, 0xBF, 0xDF, 0x1E, 0x9D, 0x03, 0x9E, 0x01, 0xC6, 0xB6, 0x61, 0xBF,
+  0x3E, 0x7D, 0x86, 0x02, 0xF6, 0xFF, 0xFE, 0xFE, 0xFB, 0xFD, 0xF7, 0x76, 0x00, 0xA5, 0x03, 0xBA,
+  0x01, 0x48, 0x15, 0xFD, 0xFE, 0xFF, 0x1E, 0x49, 0x92, 0x02, 0xEA, 0xFF, 0xCF, 0xFF, 0xEF, 0xFF,
+  0xFE, 0xF7, 0x03, 0xA1, 0x03, 0x86, 0x03, 0xD0, 0x8E, 0x9E, 0xDF, 0xF9, 0x7B, 0xD6, 0xED, 0xE1,
+  0xBF, 0xAF, 0xBF, 0x00, 0x59, 0x3A, 0xDE, 0x1F, 0x81, 0x03, 0xAA, 0x02, 0x76, 0xAC, 0x45, 0xFF,
+  0xF7, 0xFF, 0xBE, 0x7F, 0xFD, 0x00, 0x4D, 0xC2, 0x01, 0xFE, 0xBF, 0xDF, 0x7B, 0xFF, 0x7F, 0x81,
+  0x01, 0x06, 0x00, 0x99, 0x02, 0xD6, 0x03, 0x10, 0xC7, 0xDD, 0xDB, 0xFF, 0x27, 0xDF, 0xF7, 0xFC,
+  0xFB, 0xFF, 0xF3, 0xFF, 0xFB, 0x0F, 0x41, 0x06, 0x00, 0x51, 0x54, 0xE9, 0x01, 0x56, 0xC6, 0x1F,
+  0x0B, 0x5D, 0xBE, 0x01, 0xDE, 0x35, 0x4D, 0xFE, 0x9F, 0x3F, 0x59, 0x96, 0x02, 0xFE, 0x7F, 0xFD,
+  0xFE, 0x3F, 0x00, 0xEE, 0x7F, 0x03, 0xE9, 0x01, 0xDA, 0x05, 0x98, 0xB2, 0xFD, 0xFF, 0xBE, 0xE7,
+  0xA9, 0x7D, 0xFC, 0x3F, 0xFB, 0xFF, 0xDD, 0xFF, 0xFD, 0x7F, 0xBF, 0x7F, 0x01, 0xFE, 0x7F, 0xFF,
+  0x07, 0xCD, 0x01, 0x92, 0x03, 0x86, 0x56, 0xFE, 0xD9, 0xFE, 0x9F, 0x65, 0xFF, 0xF1, 0xFF, 0xE3,
+  0xEB, 0x07, 0x61, 0xFE, 0x01, 0xFE, 0xBF, 0x07, 0xE8, 0xFB, 0xFC, 0xA9, 0x3C, 0xCD, 0x01, 0xE2,
+  0x02, 0xD2, 0x66, 0xAD, 0xF7, 0x3B, 0xB3, 0xDA, 0x7F, 0xEB, 0xFF, 0x7B, 0x49, 0x06, 0x00, 0x75,
+  0xC2, 0x01, 0x00, 0xDF, 0x7B, 0xFD, 0xFA, 0x7F, 0xD9, 0x01, 0x36, 0x94, 0x0C, 0x61, 0x6E, 0x7A,
+  0x55, 0xF5, 0x02, 0x51, 0x62, 0xFE, 0xFE, 0x7F, 0x51, 0x9A, 0x01, 0xBE, 0xF8, 0xFF, 0xFB, 0x1B,
+  0x99, 0x02, 0xA2, 0x02, 0x30, 0xCD, 0xFF, 0x7E, 0x6F, 0xD3, 0x35, 0x5F, 0x7F, 0x41, 0x56, 0x7E,
+  0xBF, 0x09, 0x95, 0x01, 0x46, 0x56, 0xDF, 0x00, 0xA9, 0x02, 0xF6, 0x03, 0xD8, 0x74, 0xFD, 0xEF,
+  0x37, 0xAD, 0xDA, 0xB3, 0xFF, 0xEF, 0xFF, 0xFD, 0x7F, 0xC2, 0xFF, 0x0B, 0x51, 0x36, 0xF6, 0x0F,
+  0xB9, 0x02, 0xFE, 0x01, 0x68, 0xAC, 0xB7, 0xFF, 0x9B, 0xDD, 0xC9, 0x1F, 0x61, 0x9E, 0x02, 0xDA,
+  0xFF, 0x80, 0xF8, 0xBF, 0xFE, 0x6F, 0xFC, 0x2F, 0xB9, 0x02, 0x86, 0x02, 0xC8, 0xF5, 0xFF, 0xFD,
+  0xCE, 0xCC, 0xEC, 0xF4, 0x00, 0x89, 0x01, 0xDE, 0x01, 0x0A, 0x00, 0xFF, 0x91, 0xAF, 0xFA, 0x3F,
+  0xCD, 0x02, 0xBA, 0x02, 0xFC, 0xDE, 0xFB, 0xFF, 0x33, 0x33, 0x3B, 0xD3, 0xFF, 0x1E, 0x55, 0x40,
+  0x96, 0x01, 0x3F, 0x92, 0xBF, 0xFF, 0x0F, 0xD1, 0x02, 0xFA, 0x01, 0x60, 0xE8, 0xFE, 0xEE, 0xD9,
+  0x6B, 0xAD, 0x15, 0x8D, 0x01, 0x54, 0x3A, 0x05, 0x08, 0x4D, 0x06, 0x00, 0xD5, 0x02, 0xEE, 0x01,
+  0x7C, 0xBD, 0xEF, 0x3D, 0xB5, 0x52, 0x5D, 0x03, 0x91, 0x01, 0x96, 0x01, 0x02, 0x20, 0x80, 0x00,
+  0x0A, 0x41, 0x06, 0x00, 0xDD, 0x02, 0xEE, 0x01, 0xA0, 0xA5, 0xFF, 0xBF, 0xD5, 0xDE, 0xCC, 0x01,
+  0x45, 0x06, 0x00, 0x45, 0x0A, 0x02, 0x54, 0x4A, 0x01, 0x32, 0x01, 0x99, 0x03, 0xEE, 0x01, 0x7C,
+  0xFD, 0xFB, 0x5E, 0x57, 0x72, 0x45, 0x00, 0x45, 0x06, 0x00, 0x41, 0x50, 0x06, 0x01, 0x40, 0x16,
+  0x09, 0x95, 0x03, 0x9E, 0x04, 0x68, 0x6F, 0xDF, 0xDF, 0xD5, 0x5B, 0x83, 0xFF, 0xBE, 0xFF, 0xBF,
+  0x2F, 0x00, 0x24, 0x88, 0x00, 0x04, 0x99, 0x03, 0xD6, 0x01, 0xD0, 0xFD, 0xFC, 0xE7, 0x65, 0x15,
+  0x00, 0x85, 0x01, 0x0A, 0x02, 0x50, 0x72, 0x5B, 0x02, 0xC0, 0x01, 0x95, 0x03, 0xCA, 0x01, 0x6C,
+  0x36, 0xFF, 0xFE, 0xBF, 0x03, 0x00, 0x61, 0x2E, 0xFA, 0x07, 0x48, 0x7E, 0x83, 0x0F, 0x00, 0x08,
+  0x99, 0x03, 0x36, 0xA8, 0x0F, 0x55, 0x36, 0x4A, 0x00, 0x55, 0x46, 0x3E, 0xF8, 0x01, 0x40, 0x8E,
+  0x01, 0xD9, 0x7B, 0x81, 0xC1, 0x00, 0x91, 0x03, 0xB2, 0x01, 0xF8, 0xEB, 0xEF, 0xFF, 0xAD, 0x00,
+  0x49, 0xAA, 0x02, 0xFE, 0x07, 0xF4, 0x00, 0xC0, 0xFF, 0xFE, 0x05, 0x6A, 0x00, 0x95, 0x03, 0x2A,
+  0xA4, 0x00, 0x51, 0x36, 0x6A, 0x00, 0x4D, 0x62, 0xDE, 0x0F, 0xC0, 0x50, 0x76, 0xFF, 0x1F, 0x64,
+  0x06, 0x95, 0x03, 0xA2, 0x01, 0xF8, 0xFF, 0xEB, 0x95, 0x02, 0x7D, 0x42, 0x80, 0xE0, 0x50, 0x41,
+  0x4A, 0x94, 0xCE, 0x01, 0x81, 0x03, 0x9E, 0x01, 0xEC, 0xBF, 0x23, 0xCB, 0x00, 0x59, 0x66, 0xFE,
+  0x01, 0x80, 0x01, 0x4C, 0x45, 0x4E, 0xC2, 0xCC, 0x03, 0xFD, 0x02, 0x96, 0x01, 0xFC, 0xFD, 0xBD,
+  0xAA, 0x00, 0x79, 0x4E, 0x0A, 0x00, 0x06, 0x4C, 0x82, 0x01, 0xCF, 0xFF, 0xB7, 0x74, 0x91, 0x03,
+  0x86, 0x01, 0xFC, 0xFD, 0xDB, 0x01, 0x00, 0x7D, 0x56, 0x56, 0x00, 0x18, 0x4C, 0x86, 0x01, 0x17,
+  0xFE, 0xAF, 0xBB, 0x00, 0x95, 0x03, 0x7A, 0xFE, 0xEF, 0x12, 0x10, 0x5D, 0x7A, 0xFE, 0x1D, 0x10,
+  0x20, 0x4C, 0x8A, 0x01, 0x03, 0xFD, 0xFB, 0x28, 0x01, 0x95, 0x03, 0x66, 0xFC, 0x7F, 0x0F, 0x00,
+  0x89, 0x01, 0x12, 0x0A, 0x98, 0x01, 0x8A, 0x01, 0x87, 0xFE, 0xAF, 0xE5, 0x01, 0x9D, 0x03, 0x3A,
+  0xFC, 0x1F, 0xA5, 0x01, 0x1E, 0x52, 0x94, 0x01, 0xA2, 0x01, 0x8F, 0xFE, 0xDE, 0xB5, 0x7D, 0x8D,
+  0x03, 0x3A, 0xFE, 0x1F, 0xA1, 0x01, 0x46, 0x42, 0x00, 0x01, 0x64, 0x92, 0x01, 0x27, 0xBE, 0xE3,
+  0xB5, 0x05, 0xA5, 0x03, 0x1E, 0x38, 0xAD, 0x01, 0x46, 0x9A, 0x42, 0x01, 0x70, 0x96, 0x01, 0x3F,
+  0xFC, 0x06, 0x55, 0x0E, 0xA9, 0x03, 0x0A, 0x00, 0xBD, 0x01, 0x22, 0xCE, 0x70, 0xCA, 0x01, 0x81,
+  0xE7, 0xF8, 0x45, 0x54, 0xE3, 0x01, 0x9D, 0x03, 0x0A, 0x00, 0x65, 0xA6, 0x01, 0xFE, 0x7F, 0x66,
+  0x0E, 0x00, 0x01, 0x58, 0x7E, 0x8F, 0xE7, 0x3F, 0x20, 0xD5, 0x03, 0x06, 0x00, 0x45, 0x06, 0x00,
+  0x4D, 0xC6, 0x02, 0xBE, 0x3D, 0x00, 0x02, 0x80, 0x04, 0x6C, 0x3C, 0xDF, 0xC0, 0x00, 0xD9, 0x03,
+  0x22, 0x38, 0x7D, 0xE6, 0x02, 0x32, 0x80, 0x08, 0x40, 0x30, 0x80, 0x47, 0xBE, 0xCF, 0x80, 0x32,
+  0x00, 0xBD, 0x03, 0x1A, 0x1E, 0x69, 0x2A, 0x96, 0x02, 0x70, 0xD6, 0x01, 0x4F, 0xF0, 0x1B, 0xFF,
+  0x67, 0xB0, 0x0F, 0xC9, 0x03, 0x22, 0x38, 0x55, 0xF2, 0x02, 0xBC, 0x1D, 0x00, 0x68, 0x85, 0x47,
+  0xF0, 0x39, 0xFE, 0xD3, 0xC8, 0x03, 0xD9, 0x03, 0xF6, 0x03, 0x1A, 0xFF, 0xBF, 0xB7, 0xEF, 0xCA,
+  0x76, 0x6B, 0x8E, 0xE1, 0xC7, 0xF3, 0x1F, 0x23, 0xB7, 0x0E, 0xC1, 0x03, 0xCA, 0x03, 0x64, 0xFE,
+  0x6D, 0x65, 0x56, 0x7D, 0x99, 0x59, 0x6B, 0x78, 0xCC, 0xE7, 0x1F, 0x87, 0x01, 0xF1, 0x03, 0xCA,
+  0x03, 0x30, 0xB0, 0x3C, 0xDF, 0xCE, 0xB2, 0x53, 0x77, 0x0B, 0x7E, 0xE0, 0xFF, 0xAF, 0xC1, 0x00,
+  0xE5, 0x03, 0xE6, 0x03, 0x3E, 0xC7, 0x1F, 0x93, 0xD5, 0x35, 0xD3, 0xF6, 0x1F, 0xFF, 0x97, 0xFF,
+  0x3F, 0x07, 0xDE, 0x00, 0xF1, 0x03, 0xC2, 0x03, 0x0E, 0xFB, 0x55, 0x57, 0x4B, 0xDB, 0x7A, 0xEB,
+  0xEF, 0xAF, 0xFF, 0xB7, 0xC1, 0x5F, 0xD1, 0x03, 0xDA, 0x03, 0xEE, 0xD1, 0x98, 0x5D, 0x5A, 0xF6,
+  0x9B, 0xBE, 0xED, 0x8F, 0x5F, 0xFF, 0x8F, 0x47, 0x19, 0x8D, 0x04, 0xB2, 0x03, 0x30, 0xBA, 0x3B,
+  0xBC, 0x66, 0xFE, 0xC9, 0x5F, 0xF8, 0xF3, 0xFF, 0x6C, 0xCC, 0x07, 0xD5, 0x03, 0xBE, 0x02, 0xFE,
+  0x8D, 0x86, 0xE6, 0xBD, 0x96, 0xFF, 0xFB, 0xFF, 0x1B, 0x4D, 0x66, 0x92, 0xE9, 0xF7, 0x00, 0xC9,
+  0x03, 0xBE, 0x02, 0xFE, 0x66, 0x76, 0x64, 0xF6, 0xD9, 0xBF, 0xEF, 0xFB, 0x0F, 0x45, 0x56, 0xCA,
+  0xA2, 0x0E, 0xFD, 0x03, 0xCA, 0x01, 0xC6, 0xBA, 0x3F, 0x9A, 0xFE, 0x5B, 0x01, 0x55, 0x06, 0x00,
+  0x45, 0x62, 0x74, 0x52, 0x7F, 0xD1, 0x03, 0xC2, 0x02, 0x7E, 0xF1, 0xCB, 0xF4, 0xF7, 0x3F, 0xEF,
+  0xFF, 0xF7, 0x7F, 0x41, 0x56, 0xF0, 0xC7, 0x0D, 0xF9, 0x03, 0xAA, 0x02, 0xE2, 0x3F, 0x71, 0x6F,
+  0xAD, 0xF7, 0xFF, 0x37, 0xFF, 0x01, 0x45, 0x66, 0xE4, 0x91, 0x5F, 0x00, 0xDD, 0x03, 0x8A, 0x02,
+  0xC6, 0xFE, 0x39, 0xF6, 0xBE, 0xFD, 0xBB, 0xBF, 0x00, 0x65, 0x46, 0x30, 0xE7, 0x00, 0x8D, 0x04,
+  0x8A, 0x01, 0xF8, 0xFF, 0x7C, 0x70, 0x01, 0x71, 0x0A, 0x00, 0x59, 0x6A, 0x8A, 0x38, 0xF9, 0x00,
+  0xE5, 0x03, 0x16, 0x04, 0x41, 0x3E, 0xFA, 0x2A, 0x49, 0x0A, 0x00, 0x89, 0x01, 0x46, 0xE4, 0x88,
+  0x00, 0x91, 0x04, 0x0A, 0x00, 0x45, 0x1A, 0x10, 0x49, 0x12, 0x06, 0x49, 0x06, 0x00, 0x51, 0x6E,
+  0xE0, 0x67, 0xF6, 0x03, 0xDD, 0x03, 0x1A, 0x0E, 0x4D, 0x62, 0x92, 0xEF, 0x7F, 0xA9, 0x01, 0x62,
+  0xF0, 0x2F, 0x73, 0xF1, 0x03, 0x0E, 0x00, 0x55, 0x6E, 0x90, 0x5F, 0xFF, 0x02, 0x99, 0x01, 0x62,
+  0x00, 0x9F, 0x7E, 0xED, 0x03, 0x0E, 0x00, 0x5D, 0x26, 0x58, 0x00, 0xD1, 0x01, 0x4E, 0x22, 0x79,
+  0x02, 0x89, 0x04, 0x0A, 0x00, 0x65, 0x6A, 0xB6, 0xBF, 0xFF, 0x01, 0x89, 0x01, 0x56, 0x98, 0xF3,
+  0x08, 0x81, 0x04, 0x0A, 0x00, 0x89, 0x01, 0x06, 0x00, 0xC9, 0x01, 0x6A, 0xB8, 0xF3, 0xFE, 0x01,
+  0xED, 0x03, 0x0A, 0x00, 0x89, 0x01, 0x0E, 0x02, 0xBD, 0x01, 0x5A, 0xA2, 0xCF, 0x10, 0xFD, 0x03,
+  0x0E, 0x00, 0xD1, 0x02, 0x4A, 0x80, 0x9F, 0x01, 0x91, 0x04, 0x0A, 0x00, 0x99, 0x01, 0x16, 0x0C,
+  0xA1, 0x01, 0x5E, 0x08, 0xFE, 0x29, 0x81, 0x04, 0x06, 0x00, 0xA5, 0x01, 0x12, 0x04, 0x91, 0x01,
+  0x62, 0xCC, 0xBC, 0x5F, 0x85, 0x04, 0x0A, 0x00, 0xAD, 0x01, 0x1A, 0x1E, 0x81, 0x01, 0x5E, 0x80,
+  0x7F, 0x0F, 0x89, 0x04, 0x0A, 0x00, 0xB5, 0x01, 0x1A, 0x0A, 0x7D, 0x5A, 0xE0, 0x3F, 0x17, 0x89,
+  0x04, 0x0A, 0x00, 0xB9, 0x01, 0x22, 0x5E, 0x71, 0x56, 0x84, 0x3E, 0x0A, 0x89, 0x04, 0x0A, 0x00,
+  0xC9, 0x01, 0xD6, 0x01, 0xEE, 0xF7, 0xFB, 0xFF, 0xB6, 0xFB, 0x07, 0x91, 0x04, 0x0A, 0x00, 0xD1,
+  0x01, 0xAA, 0x01, 0xFE, 0xF4, 0xFD, 0xDF, 0xB9, 0x00, 0xB1, 0x04, 0x06, 0x00, 0xD5, 0x01, 0xCE,
+  0x01, 0xCC, 0xEB, 0xC9, 0xD3, 0xFF, 0x6B, 0x03, 0xED, 0x05, 0xC2, 0x01, 0xFC, 0xFD, 0xDF, 0xF1,
+  0xFF, 0x7A, 0xF9, 0x05, 0x6E, 0xF8, 0x7F, 0xFF, 0x03, 0xCD, 0x06, 0x1E, 0x2C, 0x65, 0x2E, 0xF0,
+  0x02, 0x8D, 0x06, 0x86, 0x01, 0xBC, 0xF7, 0xD7, 0x3F, 0x00, 0xB9, 0x06, 0x86, 0x01, 0x7E, 0xF3,
+  0x87, 0xFF, 0x00, 0xB5, 0x06, 0x5E, 0xBC, 0xFF, 0x27, 0xDD, 0x06, 0x2E, 0xF8, 0x03, 0x95, 0x07,
+  0x0E, 0x00, 0xB9, 0x07, 0x1A, 0x1C, 0x85, 0x29,
+};
+static const RleImage bruce_logo = { 237, 133, sizeof(bruce_logo_rle), bruce_logo_rle };
+
+#endif
@@ -0,0 +1,78 @@
+#include "battery.h"
+#include "globals.h"
+#include <freertos/timers.h>
+
+#if defined(CARDPUTER) || defined(STICK_C_PLUS2)
+  #include <driver/adc.h>
+  #include <esp_adc_cal.h>
+  #include <soc/adc_channel.h>
+
+  #if defined(CARDPUTER)
+    #define BAT_ADC_CH ADC1_GPIO10_CHANNEL
+  #else
+    #define BAT_ADC_CH ADC1_GPIO38_CHANNEL
+  #endif
+  static esp_adc_cal_characteristics_t adcChars;
+#endif
+
+static TimerHandle_t batteryTimer = NULL;
+static int32_t filtered = 0;              // batteryFilter() state
+static volatile uint32_t published = 0;   // mV << 8 | percent, one aligned word is read atomically
+
+/***************************************************************************************
+** Function name: readMillivolts
+** Description:   averages BATTERY_OVERSAMPLE readings of the battery voltage
+***************************************************************************************/
+static uint32_t readMillivolts() {
+#if defined(STICK_C_PLUS)
+  float v = 0;
+  for (int i = 0; i < BATTERY_OVERSAMPLE; i++) v += axp192.GetBatVoltage();
+  return v * 1000 / BATTERY_OVERSAMPLE;
+#elif defined(CARDPUTER) || defined(STICK_C_PLUS2)
+  uint32_t raw = 0;
+  for (int i = 0; i < BATTERY_OVERSAMPLE; i++) raw += adc1_get_raw((adc1_channel_t)BAT_ADC_CH);
+  return esp_adc_cal_raw_to_voltage(raw / BATTERY_OVERSAMPLE, &adcChars) * 2;  // halved by a divider
+#else
+  return 0;
+#endif
+}
+
+static uint8_t toPercent(uint32_t mv) {
+#if defined(STICK_C_PLUS)
+  int percent = ((int)mv - 3000) * 100 / 1200;
+#else
+  int percent = ((int)mv - 3300) * 100 / (4150 - 3350);
+#endif
+  return (percent < 0) ? 0 : (percent >= 100) ? 100 : percent;
+}
+
+static void batterySample(TimerHandle_t timer) {
+  filtered = batteryFilter(filtered, readMillivolts());
+  uint32_t mv = filtered >> 4;
+  published = (mv << 8) | toPercent(mv);
+}
+
+/***************************************************************************************
+** Function name: batteryBegin
+** Description:   configures and characterizes the ADC once, takes the first sample and
+**                starts the sampling timer
+***************************************************************************************/
+void batteryBegin() {
+  if (batteryTimer) return;
+#if defined(CARDPUTER) || defined(STICK_C_PLUS2)
+  adc1_config_width(ADC_WIDTH_BIT_12);
+  adc1_config_channel_atten((adc1_channel_t)BAT_ADC_CH, ADC_ATTEN_DB_11);
+  esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 3600, &adcChars);
+#endif
+  batterySample(NULL);
+  batteryTimer = xTimerCreate("battery", pdMS_TO_TICKS(BATTERY_SAMPLE_MS), pdTRUE, NULL, batterySample);
+  if (batteryTimer) xTimerStart(batteryTimer, 0);
+}
+
+uint16_t batteryMillivolts() {
+  return published >> 8;
+}
+
+uint8_t batteryPercent() {
+  return published & 0xFF;
+}
@@ -0,0 +1,29 @@
+#ifndef BATTERY_H
+#define BATTERY_H
+
+// Battery service: the ADC is characterized once in batteryBegin(), then a
+// FreeRTOS timer takes BATTERY_OVERSAMPLE readings every BATTERY_SAMPLE_MS,
+// filters them with an EMA and publishes voltage and percentage in one 32 bit
+// word. The UI only reads that word (getBattery() in display.h).
+
+#include <Arduino.h>
+
+#define BATTERY_SAMPLE_MS   5000
+#define BATTERY_OVERSAMPLE  16
+#define BATTERY_EMA_SHIFT   2     // each sample moves the filter 1/4 of the way
+
+void batteryBegin();
+
+// Last filtered values, 0 before the first sample
+uint16_t batteryMillivolts();
+uint8_t batteryPercent();
+
+// One EMA step on millivolts kept in 1/16 mV, a zero state takes the sample as is.
+// Pure function so it can be checked off the device.
+static inline int32_t batteryFilter(int32_t state, uint32_t mv) {
+  int32_t x = (int32_t)mv << 4;
+  if (state == 0) return x;
+  return state + ((x - state) >> BATTERY_EMA_SHIFT);
+}
+
+#endif
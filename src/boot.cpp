@@ -0,0 +1,65 @@
+#include "boot.h"
+#include "globals.h"
+#include "display.h"
+#include "input.h"
+#include "settings_store.h"
+#include <freertos/event_groups.h>
+
+static BootStage stages[BOOT_MAX_STAGES];
+static uint8_t stageCount = 0;
+static portMUX_TYPE stageMux = portMUX_INITIALIZER_UNLOCKED;
+static EventGroupHandle_t bootEvents = NULL;
+
+void bootMark(const char *name) {
+  uint32_t now = micros();
+  portENTER_CRITICAL(&stageMux);
+  if (stageCount < BOOT_MAX_STAGES) stages[stageCount++] = { name, now };
+  portEXIT_CRITICAL(&stageMux);
+  log_d("boot: %s at %lu ms", name, now / 1000);
+}
+
+/***************************************************************************************
+** Function name: bootTask
+** Description:   loads what the UI needs from flash while setup() starts the display
+***************************************************************************************/
+static void bootTask(void *arg) {
+  settingsBegin();
+  bootMark("settings");
+  xEventGroupSetBits(bootEvents, BOOT_SETTINGS_READY);
+
+  if(!LittleFS.begin(true)) { LittleFS.format(), LittleFS.begin();}
+  bootMark("littlefs");
+  xEventGroupSetBits(bootEvents, BOOT_FS_READY);
+
+  vTaskDelete(NULL);
+}
+
+void bootBegin() {
+  bootEvents = xEventGroupCreate();
+  xTaskCreatePinnedToCore(bootTask, "boot", 4096, NULL, 2, NULL, 0);
+}
+
+void bootWait(uint32_t bits) {
+  xEventGroupWaitBits(bootEvents, bits, pdFALSE, pdTRUE, portMAX_DELAY);
+}
+
+/***************************************************************************************
+** Function name: bootShowLog
+** Description:   diagnostics screen with the time each boot stage ended
+***************************************************************************************/
+void bootShowLog() {
+  drawMainBorder();
+  tft.setTextSize(FP);
+  tft.setTextColor(FGCOLOR, BGCOLOR);
+  tft.setCursor(12, 30);
+  tft.println("Boot stages (ms)");
+  uint32_t prev = 0;
+  for (uint8_t i = 0; i < stageCount; i++) {
+    tft.setCursor(12, tft.getCursorY() + 2);
+    tft.printf("%-12s %5lu  +%lu\n", stages[i].name, stages[i].us / 1000, (stages[i].us - prev) / 1000);
+    prev = stages[i].us;
+  }
+  InputEvent ev;
+  inputFlush();
+  while (!inputWait(ev, 1000) || ev.type != EV_PRESS) {}
+}
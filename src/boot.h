@@ -0,0 +1,31 @@
+#ifndef BOOT_H
+#define BOOT_H
+
+// Staged boot: setup() starts the display while a startup task loads the settings
+// and mounts LittleFS, each side waits only for what it needs. Every stage is
+// timestamped with bootMark(), the list is shown by bootShowLog() (Config menu).
+
+#include <Arduino.h>
+
+#define BOOT_MAX_STAGES 16
+#define BOOT_SPLASH_MS  2000    // how long the splash stays unless a key skips it
+
+#define BOOT_SETTINGS_READY (1 << 0)
+#define BOOT_FS_READY       (1 << 1)
+
+struct BootStage {
+  const char *name;
+  uint32_t us;        // micros() when the stage ended
+};
+
+void bootMark(const char *name);
+
+// Starts the startup task
+void bootBegin();
+
+// Waits for BOOT_*_READY bits set by the startup task
+void bootWait(uint32_t bits);
+
+void bootShowLog();
+
+#endif
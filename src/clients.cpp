@@ -14,12 +14,19 @@
 #include <esp_system.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/ringbuf.h>
+#include <freertos/queue.h>
 #include <lwip/sockets.h>
+#include <errno.h>
 #include "clients.h"
 #include "globals.h"
 #include "display.h"
 #include "mykeyboard.h"
 #include "wifi_common.h"
+#include "terminal.h"
+#include "scrollback.h"
+#include "telnet.h"
+#include "sd_functions.h"
 
 // SSH server configuration (initialize as mpty strings)
 String ssh_host     = "";
@@ -30,7 +37,6 @@ char* ssh_port_char;
 
 // M5Cardputer setup
 //M5Canvas canvas(&DISP);
- String commandBuffer              = "> ";
 int cursorY                       = 0;
 const int lineHeight              = 32; //32
 unsigned long lastKeyPressMillis  = 0;
@@ -42,6 +48,23 @@ const unsigned long debounceDelay = 200;  // Adjust debounce delay as needed
 ssh_session my_ssh_session;
 ssh_channel channel_ssh;
 
+// Network side of a session: only sshNetTask touches the channel once the shell is
+// open, the UI task exchanges data with it through sshRx and sshTx.
+#define SSH_RX_RING  8192
+#define SSH_TX_DEPTH 16
+#define SSH_TX_CHUNK 63
+
+struct SshTxChunk {
+    uint8_t len;
+    char data[SSH_TX_CHUNK];
+};
+
+SshNetStats sshNetStats;
+static RingbufHandle_t sshRx = NULL;
+static QueueHandle_t sshTx = NULL;
+static volatile bool sshNetRunning = false;
+static TaskHandle_t sshNetHandle = NULL;
+
 
 char* stringTochar(String s)
 {
@@ -54,7 +77,296 @@ char* stringTochar(String s)
     return arr;
 }
 
-bool filterAnsiSequences = true;  // Set to false to disable ANSI sequence filtering
+#define TERM_CELL_W (6 * FP)
+#define TERM_CELL_H (8 * FP)
+
+// ANSI colors 0-7 and their bright versions 8-15
+static const uint16_t termPalette[16] = {
+    TFT_BLACK,    TFT_RED,   TFT_DARKGREEN, TFT_OLIVE,  TFT_NAVY,   TFT_PURPLE,  TFT_DARKCYAN, TFT_LIGHTGREY,
+    TFT_DARKGREY, TFT_RED,   TFT_GREEN,     TFT_YELLOW, TFT_BLUE,   TFT_MAGENTA, TFT_CYAN,     TFT_WHITE
+};
+
+static void termColors(const TermCell &cell, uint16_t &fg, uint16_t &bg) {
+    uint8_t f = cell.fg;
+    if ((cell.attr & TERM_ATTR_BOLD) && f < 8) f += 8;
+    fg = f == TERM_DEFAULT_FG ? TFT_WHITE : termPalette[f];
+    bg = cell.bg == TERM_DEFAULT_BG ? BGCOLOR : termPalette[cell.bg];
+    if (cell.attr & TERM_ATTR_INVERSE) { uint16_t t = fg; fg = bg; bg = t; }
+}
+
+/***************************************************************************************
+** Function name: sshNetTask
+** Description:   moves channel data into sshRx and sshTx chunks into the channel,
+**                sleeps when there is nothing to do so no watchdog starves
+***************************************************************************************/
+static void sshNetTask(void *pvParameters) {
+    char buffer[1024];
+    uint8_t busyLoops = 0;
+    while (sshNetRunning) {
+        bool busy = false;
+
+        SshTxChunk chunk;
+        while (xQueueReceive(sshTx, &chunk, 0) == pdTRUE) {
+            if (ssh_channel_write(channel_ssh, chunk.data, chunk.len) > 0) sshNetStats.txBytes += chunk.len;
+            busy = true;
+        }
+
+        // Read only what the ring can take, the rest waits in the socket (TCP backpressure)
+        size_t room = xRingbufferGetCurFreeSize(sshRx);
+        if (room > sizeof(buffer)) room = sizeof(buffer);
+        if (room > 0) {
+            int nbytes = ssh_channel_read_nonblocking(channel_ssh, buffer, room, 0);
+            if (nbytes > 0) {
+                xRingbufferSend(sshRx, buffer, nbytes, 0);
+                sshNetStats.rxBytes += nbytes;
+                busy = true;
+            }
+            if (nbytes < 0 || ssh_channel_is_closed(channel_ssh)) {
+                log_d("SSH channel closed");
+                break;
+            }
+        } else {
+            sshNetStats.rxStalls++;
+        }
+
+        sshNetStats.txDepth = uxQueueMessagesWaiting(sshTx);
+        sshNetStats.rxDepth = SSH_RX_RING - xRingbufferGetCurFreeSize(sshRx);
+        if (!busy) vTaskDelay(pdMS_TO_TICKS(5));
+        else if (++busyLoops == 16) {
+            busyLoops = 0;
+            vTaskDelay(1); // lets the idle task feed the watchdog during long outputs
+        }
+    }
+    sshNetRunning = false;
+    sshNetHandle = NULL;
+    vTaskDelete(NULL);
+}
+
+/***************************************************************************************
+** Function name: sshSend
+** Description:   queues bytes for the network task, splits them in chunks
+***************************************************************************************/
+static void sshSend(const char *data, size_t len) {
+    while (len > 0) {
+        SshTxChunk chunk;
+        chunk.len = len > SSH_TX_CHUNK ? SSH_TX_CHUNK : len;
+        memcpy(chunk.data, data, chunk.len);
+        if (xQueueSend(sshTx, &chunk, pdMS_TO_TICKS(100)) != pdTRUE) {
+            sshNetStats.txDropped += chunk.len;
+            return;
+        }
+        data += chunk.len;
+        len -= chunk.len;
+    }
+}
+
+// Scrollback of the open session, lines leave the terminal into it
+#define SCROLLBACK_PSRAM (256 * 1024)
+#define SCROLLBACK_HEAP  (16 * 1024)
+
+struct TermView {
+    uint32_t offset;    // lines above the live screen, 0 shows the live screen
+    uint32_t pushedAt;  // scrollback->pushed() when offset was set
+    int32_t match;      // scrollback line of the last search hit, -1 for none
+    ScrollbackSearch search;
+    bool redraw;
+};
+
+static Scrollback *scrollback = NULL;
+static uint8_t *scrollbackMem = NULL;
+
+static void scrollbackPush(const TermCell *row, uint8_t cols, void *ctx) {
+    ((Scrollback *)ctx)->push(row, cols);
+}
+
+static void scrollbackBegin(Terminal &term, TermView &view) {
+    uint32_t size = SCROLLBACK_HEAP;
+    if (psramFound()) {
+        scrollbackMem = (uint8_t *)ps_malloc(SCROLLBACK_PSRAM);
+        if (scrollbackMem) size = SCROLLBACK_PSRAM;
+    }
+    if (!scrollbackMem) scrollbackMem = (uint8_t *)malloc(size);
+    scrollback = new Scrollback(scrollbackMem, scrollbackMem ? size : 0);
+    term.onScrollOut(scrollbackPush, scrollback);
+    memset(&view, 0, sizeof(view));
+    view.match = -1;
+}
+
+static void scrollbackEnd(Terminal &term) {
+    term.onScrollOut(NULL, NULL);
+    delete scrollback;
+    free(scrollbackMem);
+    scrollback = NULL;
+    scrollbackMem = NULL;
+}
+
+/***************************************************************************************
+** Function name: scrollbackSave
+** Description:   writes the scrollback and the live screen to /term_N.log on the SD
+***************************************************************************************/
+static void scrollbackSave(Terminal &term) {
+    if(!sdcardMounted && !setupSdCard()) {
+        displayError("No SD card");
+        delay(1000);
+        return;
+    }
+    String filename = "/term_0.log";
+    for (int c = 1; SD.exists(filename); c++) filename = "/term_" + String(c) + ".log";
+    File file = SD.open(filename, FILE_WRITE);
+    if (!file) {
+        displayError("Can't create file");
+        delay(1000);
+        return;
+    }
+
+    char text[SCROLLBACK_LINE_MAX + 1];
+    uint32_t pos = scrollback->oldest();
+    for (uint32_t i = 0; i < scrollback->count(); i++) {
+        pos = scrollback->next(pos, text, sizeof(text));
+        file.println(text);
+    }
+    for (uint8_t y = 0; y < term.height(); y++) {
+        const TermCell *row = term.row(y);
+        uint8_t n = term.width();
+        while (n > 0 && row[n - 1].ch == ' ') n--;
+        for (uint8_t x = 0; x < n; x++) text[x] = row[x].ch;
+        text[n] = '\0';
+        file.println(text);
+    }
+    file.close();
+    displaySuccess(filename);
+    delay(1000);
+}
+
+/***************************************************************************************
+** Function name: termViewScroll
+** Description:   moves the view by lines (positive goes back in time), 0 lines back
+**                to the live screen
+***************************************************************************************/
+static void termViewScroll(Terminal &term, TermView &view, int32_t lines) {
+    int32_t offset = (int32_t)view.offset + lines;
+    if (offset < 0 || lines == 0) offset = 0;
+    if (offset > (int32_t)scrollback->count()) offset = scrollback->count();
+    if ((uint32_t)offset == view.offset) return;
+    view.offset = offset;
+    view.pushedAt = scrollback->pushed();
+    if (view.offset == 0) {
+        view.match = -1;
+        tft.fillScreen(BGCOLOR);
+        term.invalidate();
+    } else {
+        view.redraw = true;
+    }
+}
+
+static void termViewSearch(TermView &view, const String &needle) {
+    scrollback->searchStart(view.search, needle.c_str());
+}
+
+/***************************************************************************************
+** Function name: termViewUpdate
+** Description:   runs a slice of the pending search, keeps the view on the same text
+**                while new lines arrive, and draws it when something changed
+***************************************************************************************/
+static void termViewUpdate(Terminal &term, TermView &view) {
+    if (view.search.active) {
+        int32_t hit = scrollback->searchStep(view.search, 256);
+        if (hit >= 0) {
+            view.match = hit;
+            view.offset = hit + 1;  // hit on the first row
+            view.pushedAt = scrollback->pushed();
+            view.redraw = true;
+            view.search.active = false;  // next search continues from here
+            view.search.back = hit + 1;
+            view.search.pushedAt = view.pushedAt;
+        } else if (hit == -2) {
+            displayRedStripe("Not found");
+            delay(700);
+            view.redraw = view.offset > 0;
+            if (view.offset == 0) {
+                tft.fillScreen(BGCOLOR);
+                term.invalidate();
+            }
+        }
+    }
+
+    if (view.offset == 0) return;
+
+    uint32_t moved = scrollback->pushed() - view.pushedAt;
+    if (moved) {
+        view.offset += moved;
+        if (view.match >= 0) view.match += moved;
+        if (view.offset > scrollback->count()) view.offset = scrollback->count();
+        view.pushedAt = scrollback->pushed();
+        view.redraw = true;
+    }
+    if (!view.redraw) return;
+    view.redraw = false;
+
+    char text[SCROLLBACK_LINE_MAX + 1];
+    tft.setTextSize(FP);
+    for (uint8_t y = 0; y < term.height(); y++) {
+        int32_t live = (int32_t)y - (int32_t)view.offset;
+        uint16_t color = TFT_LIGHTGREY;
+        text[0] = '\0';
+        if (live >= 0) {
+            const TermCell *row = term.row(live);
+            for (uint8_t x = 0; x < term.width(); x++) text[x] = row[x].ch;
+            text[term.width()] = '\0';
+            color = TFT_WHITE;
+        } else {
+            uint32_t back = -live - 1;
+            scrollback->line(back, text, sizeof(text));
+            if ((int32_t)back == view.match) color = TFT_YELLOW;
+        }
+        // pad so the background of the whole row is painted
+        size_t len = strlen(text);
+        while (len < term.width()) text[len++] = ' ';
+        text[term.width()] = '\0';
+        tft.setTextColor(color, BGCOLOR);
+        tft.setCursor(0, y * TERM_CELL_H);
+        tft.print(text);
+    }
+    String pos = "-" + String(view.offset);
+    tft.setTextColor(BGCOLOR, FGCOLOR);
+    tft.setCursor(tft.width() - pos.length() * TERM_CELL_W, 0);
+    tft.print(pos);
+}
+
+/***************************************************************************************
+** Function name: drawTerminal
+** Description:   redraws the rows changed since the last call, one print per color run
+***************************************************************************************/
+static void drawTerminal(Terminal &term) {
+    uint32_t dirty = term.takeDirty();
+    if (!dirty) return;
+
+    char run[256];
+    tft.setTextSize(FP);
+    for (uint8_t y = 0; y < term.height(); y++) {
+        if (!(dirty & (1UL << y))) continue;
+        const TermCell *row = term.row(y);
+        uint8_t x = 0;
+        while (x < term.width()) {
+            uint16_t fg, bg, nfg, nbg;
+            termColors(row[x], fg, bg);
+            uint8_t start = x, n = 0;
+            uint8_t under = row[x].attr & TERM_ATTR_UNDER;
+            do {
+                run[n++] = row[x].ch;
+                x++;
+                if (x < term.width()) termColors(row[x], nfg, nbg);
+            } while (x < term.width() && nfg == fg && nbg == bg && (row[x].attr & TERM_ATTR_UNDER) == under);
+            run[n] = '\0';
+            tft.setTextColor(fg, bg);
+            tft.setCursor(start * TERM_CELL_W, y * TERM_CELL_H);
+            tft.print(run);
+            if (under) tft.drawFastHLine(start * TERM_CELL_W, y * TERM_CELL_H + TERM_CELL_H - 1, n * TERM_CELL_W, fg);
+        }
+        if (term.cursorVisible() && y == term.cursorY())
+            tft.fillRect(term.cursorX() * TERM_CELL_W, y * TERM_CELL_H + TERM_CELL_H - 2 * FP, TERM_CELL_W, 2 * FP, FGCOLOR);
+    }
+}
 
 void ssh_setup(String host) {
     if(!wifiConnected) wifiConnectMenu(false);
@@ -81,7 +393,7 @@ void ssh_setup(String host) {
         Serial.println("Failed to create SSH Task");
     }
 
-    while(!returnToMenu) { }
+    while(!returnToMenu) { vTaskDelay(pdMS_TO_TICKS(100)); }
 
     vTaskDelete(NULL);
 
@@ -96,10 +408,6 @@ void ssh_loop(void *pvParameters) {
     log_d("BEFORE SSH");
     my_ssh_session = ssh_new();
     log_d("AFTER SSH");
-    // Disable watchdog
-    disableCore0WDT();
-    disableCore1WDT();
-    disableLoopWDT();
 
     
     if (my_ssh_session == NULL) {
@@ -187,11 +495,22 @@ void ssh_loop(void *pvParameters) {
 
     log_d("SSH setup completed.");
     tft.fillScreen(BGCOLOR);
-    tft.setTextColor(TFT_WHITE, BGCOLOR);
-    tft.setTextSize(FP);
-    char buffer[1024];
-    int nbytes;
-    while(1) {
+    Terminal *term = new Terminal(tft.width() / TERM_CELL_W, tft.height() / TERM_CELL_H);
+    TermView view;
+    scrollbackBegin(*term, view);
+
+    memset(&sshNetStats, 0, sizeof(sshNetStats));
+    sshRx = xRingbufferCreate(SSH_RX_RING, RINGBUF_TYPE_BYTEBUF);
+    sshTx = xQueueCreate(SSH_TX_DEPTH, sizeof(SshTxChunk));
+    sshNetRunning = sshRx != NULL && sshTx != NULL;
+    if (sshNetRunning) xTaskCreatePinnedToCore(sshNetTask, "SSH net", 16384, NULL, 2, &sshNetHandle, 0);
+    if (sshNetHandle == NULL) {
+        sshNetRunning = false;
+        log_d("SSH net task creation failed");
+    }
+
+    unsigned long lastStats = millis();
+    while(sshNetRunning) {
     #ifdef CARDPUTER
         Keyboard.update();
         if (Keyboard.isChange() && Keyboard.isPressed()) {
@@ -200,42 +519,31 @@ void ssh_loop(void *pvParameters) {
                 lastKeyPressMillis               = currentMillis;
                 Keyboard_Class::KeysState status = Keyboard.keysState();
 
-                for (auto i : status.word) {
-                    commandBuffer += i;
-                    tft.print(i);
-                    cursorY = tft.getCursorY();
-                }
-
-                if (status.del && commandBuffer.length() > 2) {
-                    commandBuffer.remove(commandBuffer.length() - 1);
-                    tft.setCursor(
-                        tft.getCursorX() - 6,
-                        tft.getCursorY());
-                    tft.setTextColor(TFT_GREEN, BGCOLOR);
-                    tft.print(" ");
-                    tft.setCursor(
-                        tft.getCursorX() - 6,
-                        tft.getCursorY());
-                    cursorY = tft.getCursorY();
+                // Fn + ; . pages the scrollback, Fn + f searches, Fn + n finds the next hit, Fn + s saves it
+                char fnKey = (status.fn && status.word.size()) ? status.word[0] : 0;
+                if (fnKey == ';') termViewScroll(*term, view, term->height());
+                else if (fnKey == '.') termViewScroll(*term, view, -(int32_t)term->height());
+                else if (fnKey == 'n') view.search.active = view.search.needle[0] != '\0';
+                else if (fnKey == 'f' || fnKey == 's') {
+                    if (fnKey == 'f') termViewSearch(view, keyboard("", 31, "Search:"));
+                    else scrollbackSave(*term);
+                    tft.fillScreen(BGCOLOR);
+                    term->invalidate();
+                    view.redraw = true;
                 }
-
-                if (status.enter) {
-                    tft.setTextColor(TFT_GREEN);
-                    commandBuffer.trim();
-                    if(commandBuffer.substring(2) == "cls") {
-                        tft.fillScreen(BGCOLOR);
-                        tft.setCursor(0,0);
-                        tft.print("> ");
-                        commandBuffer = "> ";
-                    } else {
-                        String message = commandBuffer.substring(2) + "\r";  // Get the command part, exclude the "> "
-                        ssh_channel_write(channel_ssh, message.c_str(), message.length());  // Send the command
+                else if (fnKey == 0) {
+                    if (view.offset) termViewScroll(*term, view, 0);  // typing goes back to the live screen
+
+                    // Keys go straight to the pty, the server echoes them back
+                    String keys = "";
+                    for (auto i : status.word) {
+                        if (status.ctrl && isalpha(i)) keys += char(toupper(i) & 0x1F);
+                        else keys += i;
                     }
-                    cursorY = tft.getCursorY();  // Update cursor position
-                    if(cursorY > tft.height()) { 
-                        tft.setCursor(0,tft.height()-10);
-                        tft.fillRect(0,HEIGHT-11,WIDTH,11, BGCOLOR);
-                    }                    
+                    if (status.tab)   keys += '\t';
+                    if (status.del)   keys += char(0x7F);
+                    if (status.enter) keys += '\r';
+                    if (keys.length()) sshSend(keys.c_str(), keys.length());
                 }
             }
         }
@@ -247,60 +555,60 @@ void ssh_loop(void *pvParameters) {
             message = keyboard("cls",76,"SSH Command: ");
             while(checkSelPress()) { yield(); } // timerless debounce
             if(message=="cls") {
-                tft.fillScreen(BGCOLOR);
-                tft.setCursor(0,0);
-                tft.print("> ");
+                term->write("\x1b[2J\x1b[H");
+            } else if(message=="save") {
+                scrollbackSave(*term);
+            } else if(message.startsWith("/")) {
+                termViewSearch(view, message.substring(1));
             } else {
                 message += "\r";
-                ssh_channel_write(channel_ssh, message.c_str(), message.length());  // Send the command
+                sshSend(message.c_str(), message.length());  // Send the command
                 log_d("%s",message);
             }
-
-            commandBuffer = "> " + message;
-            tft.setCursor(0, 0);
-            tft.setTextSize(FP);
-
+            // keyboard() used the whole screen
+            tft.fillScreen(BGCOLOR);
+            term->invalidate();
+            view.redraw = true;
+        }
+        // Next pages the scrollback back, past the oldest line it returns to the live screen
+        if(checkNextPress()) {
+            while(checkNextPress()) { yield(); }
+            if (view.offset >= scrollback->count()) termViewScroll(*term, view, 0);
+            else termViewScroll(*term, view, term->height());
         }
                     
     #endif
 
-        // Read data from SSH server and display it, handling ANSI sequences
-        nbytes = ssh_channel_read_nonblocking(channel_ssh, buffer, sizeof(buffer), 0);
-
-        if (nbytes > 0) {
-            String msg = "";
-            tft.setTextColor(TFT_WHITE);
-            for (int i = 0; i < nbytes; ++i) {
-                msg += char(buffer[i]);
-                if (buffer[i] == '\r') continue;  // Ignore carriage return
-                tft.write(buffer[i]);
-                if(tft.getCursorY()>HEIGHT) {
-                    tft.fillScreen(BGCOLOR);
-                    tft.setCursor(0,0);
-                    tft.setTextColor(TFT_GREEN);
-                    tft.print(commandBuffer);  // Move to the next line on display    
-                    tft.setTextColor(TFT_WHITE);
-                }
-                cursorY = tft.getCursorY();
-            }
-            log_d("%s", msg);
-
-            cursorY = tft.getCursorY();  // Update cursor position
-            if(cursorY > tft.height()) { 
-                tft.setCursor(0,tft.height()-10);
-                tft.fillRect(0,HEIGHT-11,WIDTH,11, BGCOLOR);
-            }
-            commandBuffer = "> ";  // Reset command buffer
-            tft.setTextColor(TFT_GREEN);
+        // Consume what the network task received, bounded per frame so input stays responsive
+        size_t budget = 4096;
+        while (budget > 0) {
+            size_t len = 0;
+            uint8_t *data = (uint8_t *)xRingbufferReceiveUpTo(sshRx, &len, 0, budget);
+            if (data == NULL) break;
+            term->write(data, len);
+            vRingbufferReturnItem(sshRx, data);
+            budget -= len;
         }
-
-        // Handle channel closure and other conditions
-        if (nbytes < 0 || ssh_channel_is_closed(channel_ssh)) {
-            log_d("Encerrando");
-            break;
+        if (view.offset == 0) drawTerminal(*term);
+        termViewUpdate(*term, view);
+
+        if (millis() - lastStats > 1000) {
+            lastStats = millis();
+            log_d("SSH rx %lu B tx %lu B, rx ring %lu B, tx queue %lu, stalls %lu",
+                  (unsigned long)sshNetStats.rxBytes, (unsigned long)sshNetStats.txBytes, (unsigned long)sshNetStats.rxDepth,
+                  (unsigned long)sshNetStats.txDepth, (unsigned long)sshNetStats.rxStalls);
         }
+        vTaskDelay(pdMS_TO_TICKS(20)); // ~50 fps, the network task keeps filling sshRx meanwhile
     }
     //Clean Up
+    sshNetRunning = false;
+    while (sshNetHandle != NULL) delay(5); // waits the network task to finish
+    if (sshTx) vQueueDelete(sshTx);
+    if (sshRx) vRingbufferDelete(sshRx);
+    sshTx = NULL;
+    sshRx = NULL;
+    scrollbackEnd(*term);
+    delete term;
     ssh_channel_close(channel_ssh);
     ssh_channel_free(channel_ssh);
     ssh_disconnect(my_ssh_session);
@@ -323,7 +631,6 @@ int telnet_server_port;
 
 static int sock;
 
-
 void telnet_loop() {
     struct sockaddr_in dest_addr;
     dest_addr.sin_addr.s_addr = inet_addr(telnet_server_ip);
@@ -359,40 +666,107 @@ void telnet_loop() {
     tft.setCursor(0, 0);
 
     String commandInput;
+    Terminal term(tft.width() / TERM_CELL_W, tft.height() / TERM_CELL_H);
+    TermView view;
+    scrollbackBegin(term, view);
+    TelnetParser telnet;
+    memset(&telnet, 0, sizeof(telnet));
+    telnet.cols = term.width();
+    telnet.rows = term.height();
+    uint32_t sentAt = 0;        // micros() of the last keystroke still waiting for an answer
+    uint32_t rttUs = 0;         // smoothed round trip, keystroke to first byte back
+    unsigned long lastStats = millis();
 
     while (1) {
-        tft.print("> ");
-        //waitForInput(commandInput);
-        commandInput=keyboard("",76,"COMMAND");
-        const char *command = commandInput.c_str();
-        send(sock, command, strlen(command), 0);
-
-        // You can also receive data from the server
-        char buffer[128];
-        int len = recv(sock, buffer, sizeof(buffer) - 1, 0);
-        if (len > 0) {
-            buffer[len] = '\0';
-                        // Check for Telnet negotiation commands (IAC)
-                        /*
-            if (buffer[0] == 0xFF) {
-                // Skip Telnet negotiation command
-                continue;
-            }
-            */
-            tft.setTextColor(TFT_WHITE, BGCOLOR);
-            Serial.printf("Received from server %s\n", buffer);
-            //tft.printf("Received from server %s\n", buffer);
-            for (int i = 0; i < len; i++) {
-             Serial.printf("%02X ", buffer[i]);
-            }
-            tft.printf("%s\n", buffer);
+    #ifdef CARDPUTER
+        Keyboard.update();
+        if (Keyboard.isChange() && Keyboard.isPressed()) {
+            unsigned long currentMillis = millis();
+            if (currentMillis - lastKeyPressMillis >= debounceDelay) {
+                lastKeyPressMillis               = currentMillis;
+                Keyboard_Class::KeysState status = Keyboard.keysState();
 
-            tft.setTextColor(FGCOLOR, BGCOLOR);
+                // same Fn keys as the SSH client
+                char fnKey = (status.fn && status.word.size()) ? status.word[0] : 0;
+                if (fnKey == ';') termViewScroll(term, view, term.height());
+                else if (fnKey == '.') termViewScroll(term, view, -(int32_t)term.height());
+                else if (fnKey == 'n') view.search.active = view.search.needle[0] != '\0';
+                else if (fnKey == 'f' || fnKey == 's') {
+                    if (fnKey == 'f') termViewSearch(view, keyboard("", 31, "Search:"));
+                    else scrollbackSave(term);
+                    tft.fillScreen(BGCOLOR);
+                    term.invalidate();
+                    view.redraw = true;
+                }
+                else if (fnKey == 0) {
+                    if (view.offset) termViewScroll(term, view, 0);
 
+                    String keys = "";
+                    for (auto i : status.word) {
+                        if (status.ctrl && isalpha(i)) keys += char(toupper(i) & 0x1F);
+                        else keys += i;
+                    }
+                    if (status.tab)   keys += '\t';
+                    if (status.del)   keys += char(0x7F);
+                    if (status.enter) keys += "\r\n";
+                    if (keys.length()) {
+                        send(sock, keys.c_str(), keys.length(), 0);
+                        if (!sentAt) sentAt = micros();
+                    }
+                }
+            }
+        }
+    #else
+        if (checkEscPress()) break;
+        if (checkSelPress()) {
+            while(checkSelPress()) { yield(); } // timerless debounce
+            //waitForInput(commandInput);
+            commandInput=keyboard("",76,"COMMAND");
+            if (commandInput == "save") {
+                scrollbackSave(term);
+            } else if (commandInput.startsWith("/")) {
+                termViewSearch(view, commandInput.substring(1));
+            } else {
+                commandInput += "\r\n";
+                send(sock, commandInput.c_str(), commandInput.length(), 0);
+                if (!sentAt) sentAt = micros();
+            }
+            tft.fillScreen(BGCOLOR);
+            term.invalidate();
+            view.redraw = true;
+        }
+        // Next pages the scrollback back, past the oldest line it returns to the live screen
+        if (checkNextPress()) {
+            while(checkNextPress()) { yield(); }
+            if (view.offset >= scrollback->count()) termViewScroll(term, view, 0);
+            else termViewScroll(term, view, term.height());
         }
+    #endif
 
-        vTaskDelay(1000 / portTICK_PERIOD_MS);
+        // Wait for data at most one frame, then drain everything the socket holds
+        int got = telnetPoll(sock, telnet, term, 20000);
+        if (got > 0 && sentAt) {
+            uint32_t rtt = micros() - sentAt;
+            rttUs = rttUs ? (rttUs * 7 + rtt) / 8 : rtt;
+            sentAt = 0;
+        }
+        bool closed = got < 0;
+        if (view.offset == 0) drawTerminal(term);
+        termViewUpdate(term, view);
+        if (closed) break;
+
+        if (millis() - lastStats > 1000) {
+            lastStats = millis();
+            log_d("TELNET rx %lu B, rtt %lu us", (unsigned long)telnet.rxBytes, (unsigned long)rttUs);
+        }
     }
+
+    close(sock);
+    scrollbackEnd(term);
+    displayRedStripe("TELNET session closed.");
+    tft.setTextColor(FGCOLOR, BGCOLOR);
+    delay(2000);
+    returnToMenu = true;
 }
 
 void telnet_setup() {
@@ -1,5 +1,16 @@
 #include <WiFi.h>
 
+// Counters of the SSH network task, refreshed while a session is open
+struct SshNetStats {
+    uint32_t rxBytes;    // received from the channel
+    uint32_t txBytes;    // written to the channel
+    uint32_t rxDepth;    // bytes waiting in the RX ring for the UI
+    uint32_t txDepth;    // chunks waiting in the TX queue
+    uint32_t rxStalls;   // network loops skipped because the RX ring was full
+    uint32_t txDropped;  // bytes lost because the TX queue stayed full
+};
+extern SshNetStats sshNetStats;
+
 void telnet_setup();
 
 void ssh_setup(String host = "");
@@ -2,13 +2,9 @@
 #include "mykeyboard.h"
 #include "wg.h" //for isConnectedWireguard to print wireguard lock
 #include "settings.h" //for timeStr
-
-#if defined(CARDPUTER) || defined(STICK_C_PLUS2)  //Battery Calculation
-  #include <driver/adc.h>
-  #include <esp_adc_cal.h>
-  #include <soc/soc_caps.h>
-  #include <soc/adc_channel.h>
-#endif
+#include "status_bar.h"
+#include "battery.h"
+#include "assets.h"
 
 /***************************************************************************************
 ** Function name: resetTftDisplay
@@ -38,7 +34,17 @@ void setTftDisplay(int x, int y, uint16_t fc, int size, uint16_t bg) {
 ** Description:   Start Display functions and display bootscreen
 ***************************************************************************************/
 void initDisplay(int i) {
-  tft.drawXBitmap(1,1,bits, bits_width, bits_height,TFT_BLACK,FGCOLOR+i);
+  uint32_t t = micros();
+  drawRle(1,1,bruce_logo,TFT_BLACK,FGCOLOR+i);
+  log_d("logo drawn in %lu us", micros() - t);
+}
+
+/***************************************************************************************
+** Function name: drawRle
+** Description:   draws a 1 bit RLE image of assets.h, see rle.h
+***************************************************************************************/
+void drawRle(int x, int y, const RleImage &img, uint16_t color, uint16_t bgcolor) {
+  rleDraw(tft, x, y, img, color, bgcolor);
 }
 
 /***************************************************************************************
@@ -67,17 +73,39 @@ void displayWarning(String txt) { displayRedStripe(txt, TFT_BLACK,TFT_YELLOW); }
 void displayInfo(String txt)    { displayRedStripe(txt, TFT_WHITE, TFT_BLUE); }
 void displaySuccess(String txt) { displayRedStripe(txt, TFT_WHITE, TFT_DARKGREEN); }
 
+// Where the menu functions read the labels from, so the options vector and the
+// MenuItem tables share the drawing and the loop
+struct MenuLabels {
+  const char *(*label)(const void *items, int i);
+  const void *items;
+  int count;
+};
+
+static const char *vectorLabel(const void *items, int i) {
+  return (*(const std::vector<std::pair<std::string, std::function<void()>>> *)items)[i].first.c_str();
+}
+
+static const char *tableLabel(const void *items, int i) {
+  return ((const MenuItem *const *)items)[i]->label;
+}
+
+static void drawMenuOptions(int index, const MenuLabels &menu, uint16_t fgcolor, uint16_t bgcolor);
+static void drawMenuSubmenu(int index, const MenuLabels &menu, String system);
+
 /*********************************************************************
-**  Function: loopOptions                             
-**  Where you choose among the options in menu
+**  Function: menuLoop
+**  Where you choose among the options in menu, returns the chosen
+**  index or -1 when the menu was left
 **********************************************************************/
-void loopOptions(const std::vector<std::pair<std::string, std::function<void()>>>& options, bool bright, bool submenu, String subText){
+static int menuLoop(const MenuLabels &menu, bool bright, bool submenu, String subText){
   bool redraw = true;
   int index = 0;
+  InputEvent ev;
+  inputFlush();
   while(1){
     if (redraw) { 
-      if(submenu) drawSubmenu(index, options, subText);
-      else drawOptions(index, options, FGCOLOR, BGCOLOR);
+      if(submenu) drawMenuSubmenu(index, menu, subText);
+      else drawMenuOptions(index, menu, FGCOLOR, BGCOLOR);
       if(bright){
         #if !defined(STICK_C_PLUS)
         int bl = MINBRIGHT + round(((255 - MINBRIGHT) * (4 - index) * 0.25)); // 4 is the number of options
@@ -87,36 +115,64 @@ void loopOptions(const std::vector<std::pair<std::string, std::function<void()>>
         #endif
       }
       redraw=false;
-      delay(200); 
     }
 
-    if(checkPrevPress()) {
+    if(!inputWait(ev, 1000)) continue;
+    if(ev.type == EV_RELEASE || ev.type == EV_LONG) continue;
+
+    if(ev.key == IN_PREV) {
     #ifdef CARDPUTER  
-      if(index==0) index = options.size() - 1;
+      if(index==0) index = menu.count - 1;
       else if(index>0) index--;
       redraw = true;
     #else
-      break;
+      if(ev.type == EV_PRESS) break;
     #endif
     }
     /* DW Btn to next item */
-    if(checkNextPress()) { 
+    if(ev.key == IN_NEXT) { 
       index++;
-      if((index+1)>options.size()) index = 0;
+      if((index+1)>menu.count) index = 0;
       redraw = true;
     }
 
     /* Select and run function */
-    if(checkSelPress()) { 
-      options[index].second();
-      break;
-    }
+    if(ev.key == IN_SEL && ev.type == EV_PRESS) return index;
 
     #ifdef CARDPUTER
-    if(checkEscPress()) break;
+    if(ev.key == IN_ESC) {
+      returnToMenu = true;
+      break;
+    }
     #endif
   }
-  delay(200);
+  return -1;
+}
+
+/*********************************************************************
+**  Function: loopOptions                             
+**  Runs a menu built at run time in options
+**********************************************************************/
+void loopOptions(const std::vector<std::pair<std::string, std::function<void()>>>& options, bool bright, bool submenu, String subText){
+  MenuLabels menu = { vectorLabel, &options, (int)options.size() };
+  int index = menuLoop(menu, bright, submenu, subText);
+  if(index >= 0) options[index].second();
+}
+
+/*********************************************************************
+**  Function: loopOptions                             
+**  Runs a MenuItem table, only the visible items are listed
+**********************************************************************/
+void loopOptions(const MenuItem *items, size_t count, bool bright, bool submenu, String subText){
+  const MenuItem *shown[MENU_MAX_ITEMS];
+  int n = 0;
+  for(size_t i=0; i<count && n<MENU_MAX_ITEMS; i++) {
+    if(items[i].visible == NULL || items[i].visible()) shown[n++] = &items[i];
+  }
+  if(n == 0) return;
+  MenuLabels menu = { tableLabel, shown, n };
+  int index = menuLoop(menu, bright, submenu, subText);
+  if(index >= 0) shown[index]->action(shown[index]->arg);
 }
 
 /***************************************************************************************
@@ -151,9 +207,9 @@ void progressHandler(int progress, size_t total) {
 ** Function name: drawOptions
 ** Description:   Função para desenhar e mostrar as opçoes de contexto
 ***************************************************************************************/
-void drawOptions(int index,const std::vector<std::pair<std::string, std::function<void()>>>& options, uint16_t fgcolor, uint16_t bgcolor) {
-    int menuSize = options.size();
-    if(options.size()>MAX_MENU_SIZE) menuSize = MAX_MENU_SIZE;
+static void drawMenuOptions(int index, const MenuLabels &menu, uint16_t fgcolor, uint16_t bgcolor) {
+    int menuSize = menu.count;
+    if(menu.count>MAX_MENU_SIZE) menuSize = MAX_MENU_SIZE;
 
     tft.fillRoundRect(WIDTH*0.15,HEIGHT/2-menuSize*(FM*8+4)/2 -5,WIDTH*0.7,(FM*8+4)*menuSize+10,5,bgcolor);
     
@@ -164,14 +220,14 @@ void drawOptions(int index,const std::vector<std::pair<std::string, std::functio
     int i=0;
     int init = 0;
     int cont = 1;
-    menuSize = options.size();
+    menuSize = menu.count;
     if(index>=MAX_MENU_SIZE) init=index-MAX_MENU_SIZE+1;
     for(i=0;i<menuSize;i++) {
       if(i>=init) {
         String text="";
         if(i==index) text+=">";
         else text +=" ";
-        text += String(options[i].first.c_str());
+        text += menu.label(menu.items, i);
         tft.setCursor(WIDTH*0.15+5,tft.getCursorY()+4);
         tft.println(text.substring(0,13));
         cont++;
@@ -179,16 +235,21 @@ void drawOptions(int index,const std::vector<std::pair<std::string, std::functio
       if(cont>MAX_MENU_SIZE) goto Exit;
     }
     Exit:
-    if(options.size()>MAX_MENU_SIZE) menuSize = MAX_MENU_SIZE;
+    if(menu.count>MAX_MENU_SIZE) menuSize = MAX_MENU_SIZE;
     tft.drawRoundRect(WIDTH*0.15,HEIGHT/2-menuSize*(FM*8+4)/2 -5,WIDTH*0.7,(FM*8+4)*menuSize+10,5,fgcolor);
 }
 
+void drawOptions(int index,const std::vector<std::pair<std::string, std::function<void()>>>& options, uint16_t fgcolor, uint16_t bgcolor) {
+  MenuLabels menu = { vectorLabel, &options, (int)options.size() };
+  drawMenuOptions(index, menu, fgcolor, bgcolor);
+}
+
 /***************************************************************************************
 ** Function name: drawOptions
 ** Description:   Função para desenhar e mostrar as opçoes de contexto
 ***************************************************************************************/
-void drawSubmenu(int index,const std::vector<std::pair<std::string, std::function<void()>>>& options, String system) {
-    int menuSize = options.size();
+static void drawMenuSubmenu(int index, const MenuLabels &menu, String system) {
+    int menuSize = menu.count;
     drawMainBorder();
     tft.setTextColor(FGCOLOR,BGCOLOR);
     tft.fillRect(6,26,WIDTH-12,20,BGCOLOR);
@@ -201,46 +262,46 @@ void drawSubmenu(int index,const std::vector<std::pair<std::string, std::functio
     if (index-1>=0) {
       tft.setTextSize(FM);
       tft.setTextColor(FGCOLOR-0x2000);
-      tft.drawCentreString(options[index-1].first.c_str(),WIDTH/2, 42,SMOOTH_FONT);
+      tft.drawCentreString(menu.label(menu.items, index-1),WIDTH/2, 42,SMOOTH_FONT);
     } else {
       tft.setTextSize(FM);
       tft.setTextColor(FGCOLOR-0x2000);
-      tft.drawCentreString(options[menuSize-1].first.c_str(),WIDTH/2, 42,SMOOTH_FONT);
+      tft.drawCentreString(menu.label(menu.items, menuSize-1),WIDTH/2, 42,SMOOTH_FONT);
     }
       tft.setTextSize(FG);
       tft.setTextColor(FGCOLOR);
-      tft.drawCentreString(options[index].first.c_str(),WIDTH/2, 67,SMOOTH_FONT);
+      tft.drawCentreString(menu.label(menu.items, index),WIDTH/2, 67,SMOOTH_FONT);
 
     if (index+1<menuSize) {
       tft.setTextSize(FM);
       tft.setTextColor(FGCOLOR-0x2000);
-      tft.drawCentreString(options[index+1].first.c_str(),WIDTH/2, 102,SMOOTH_FONT);
+      tft.drawCentreString(menu.label(menu.items, index+1),WIDTH/2, 102,SMOOTH_FONT);
     } else {
       tft.setTextSize(FM);
       tft.setTextColor(FGCOLOR-0x2000);
-      tft.drawCentreString(options[0].first.c_str(),WIDTH/2, 102,SMOOTH_FONT);
+      tft.drawCentreString(menu.label(menu.items, 0),WIDTH/2, 102,SMOOTH_FONT);
     }
 
-    tft.drawFastHLine(WIDTH/2 - options[index].first.size()*FG*LW/2, 67+FG*LH,options[index].first.size()*FG*LW,FGCOLOR);
+    tft.drawFastHLine(WIDTH/2 - strlen(menu.label(menu.items, index))*FG*LW/2, 67+FG*LH,strlen(menu.label(menu.items, index))*FG*LW,FGCOLOR);
     tft.fillRect(tft.width()-5,index*tft.height()/menuSize,5,tft.height()/menuSize,FGCOLOR);
 
 }
 
+void drawSubmenu(int index,const std::vector<std::pair<std::string, std::function<void()>>>& options, String system) {
+  MenuLabels menu = { vectorLabel, &options, (int)options.size() };
+  drawMenuSubmenu(index, menu, system);
+}
+
 void drawMainBorder() {
     tft.fillScreen(BGCOLOR);
-    setTftDisplay(12, 12, FGCOLOR, 1, BGCOLOR);
-
-    // if(wifiConnected) {tft.print(timeStr);} else {tft.print("BRUCE 1.0b");}
-
-    int i=0;
-    if(wifiConnected) { drawWifiSmall(WIDTH - 90, 7); i++;}               //Draw Wifi Symbol beside battery
-    if(BLEConnected) { drawBLESmall(WIDTH - (90 + 20*i), 7); i++; }       //Draw BLE beside Wifi
-    if(isConnectedWireguard) { drawWireguardStatus(WIDTH - (90 + 21*i), 7); i++; }//Draw Wg bedide BLE, if the others exist, if not, beside battery
-    
-
     tft.drawRoundRect(5, 5, WIDTH - 10, HEIGHT - 10, 5, FGCOLOR);
     tft.drawLine(5, 25, WIDTH - 6, 25, FGCOLOR);
-    drawBatteryStatus();
+
+    // the bar keeps its values, nothing is sampled here
+    statusBarInvalidate();
+    statusBarUpdate();
+    statusBarDraw();
+    setTftDisplay(12, 12, FGCOLOR, 1, BGCOLOR);
 }
 
 /***************************************************************************************
@@ -298,50 +359,21 @@ void drawMainMenu(int index) {
 ** Description:   Delivers the battery value from 1-100
 ***************************************************************************************/
 int getBattery() {
-  int percent=0;
-  #if defined(STICK_C_PLUS)
-  float b = axp192.GetBatVoltage();
-  percent = ((b - 3.0) / 1.2) * 100;
-  
-  #else
-  
-    #if defined(CARDPUTER)
-      uint8_t _batAdcCh = ADC1_GPIO10_CHANNEL;
-      uint8_t _batAdcUnit = 1;
-    #elif defined(STICK_C_PLUS2)
-      uint8_t _batAdcCh = ADC1_GPIO38_CHANNEL;
-      uint8_t _batAdcUnit = 1;
-    #endif
-  
-    adc1_config_width(ADC_WIDTH_BIT_12);
-    adc1_config_channel_atten((adc1_channel_t)_batAdcCh, ADC_ATTEN_DB_11);
-    static esp_adc_cal_characteristics_t* adc_chars = nullptr;
-    static constexpr int BASE_VOLATAGE = 3600;
-    adc_chars = (esp_adc_cal_characteristics_t*)calloc(1, sizeof(esp_adc_cal_characteristics_t));
-    esp_adc_cal_characterize((adc_unit_t)_batAdcUnit, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, BASE_VOLATAGE, adc_chars);
-    int raw;
-    raw = adc1_get_raw((adc1_channel_t)_batAdcCh);
-    uint32_t volt = esp_adc_cal_raw_to_voltage(raw, adc_chars);
-
-    float mv = volt * 2;
-    percent = (mv - 3300) * 100 / (float)(4150 - 3350);
-
-  #endif
-  return  (percent < 0) ? 0
-        : (percent >= 100) ? 100
-        :  percent;
+  return batteryPercent();  // sampled in the background by battery.cpp
 }
 
 /***************************************************************************************
 ** Function name: drawBatteryStatus()
 ** Description:   Delivers the battery value from 1-100
 ***************************************************************************************/
-void drawBatteryStatus() {
+void drawBatteryStatus(int bat) {
     tft.drawRoundRect(WIDTH - 42, 7, 34, 17, 2, FGCOLOR);
-    int bat = getBattery();
     tft.setTextSize(FP);
     tft.setTextColor(FGCOLOR, BGCOLOR);
+    tft.setTextPadding(LW * FP * 4);  // "100%", clears the digits of a longer value
     tft.drawRightString(String(bat) + "%", WIDTH - 45, 12, 1);
+    tft.setTextPadding(0);
+    tft.fillRoundRect(WIDTH - 40, 9, 30, 13, 2, BGCOLOR);
     tft.fillRoundRect(WIDTH - 40, 9, 30 * bat / 100, 13, 2, FGCOLOR);
     tft.drawLine(WIDTH - 30, 9, WIDTH - 30, 9 + 13, BGCOLOR);
     tft.drawLine(WIDTH - 20, 9, WIDTH - 20, 9 + 13, BGCOLOR);
@@ -2,6 +2,7 @@
 #include "globals.h"
 #include "mykeyboard.h"
 #include "wifi_common.h"
+#include "status_bar.h"
 #include "sd_functions.h"
 #include "wifi_atks.h"
 
@@ -62,6 +63,7 @@ void startEvilPortal(String tssid, uint8_t channel, bool deauth) {
     }
     
     wifiConnected=true;
+    statusBarRefresh(STATUS_LINKS);
     drawMainBorder();
     displayRedStripe("Starting..",TFT_WHITE,FGCOLOR);
 
@@ -256,7 +258,7 @@ String clear_GET() {
   String password = "<p></p>";
   capturedCredentialsHtml = "<p></p>";
   if (LittleFS.begin()) if (LittleFS.exists("/Bruce_creds.csv")) LittleFS.remove("/Bruce_creds.csv");
-  if (SD.begin()) if (SD.exists("/Bruce_creds.csv")) SD.remove("/Bruce_creds.csv");
+  if (setupSdCard()) if (SD.exists("/Bruce_creds.csv")) SD.remove("/Bruce_creds.csv");
   totalCapturedCredentials = 0;
   return getHtmlContents("<div><p>The credentials list has been reset.</div></p><center><a style=\"color:blue\" href=/creds>Back to capturedCredentialsHtml</a></center><center><a style=\"color:blue\" href=/>Back to Index</a></center>");
 }
@@ -1,4 +1,5 @@
 #include "globals.h"
+#include "settings_store.h"
 
 
 /*********************************************************************
@@ -20,46 +21,18 @@ while(1) {
 }
 
 /*********************************************************************
-**  Function: readFGColorFromEEPROM
-**  reads the foreground color from EEPROM
+**  Function: readFGCOLOR
+**  sets the foreground color from the settings
 **  if the value is not set, it will use the default value
 **********************************************************************/
-void readFGCOLORFromEEPROM() {
-    int colorEEPROM;
-
-    EEPROM.begin(EEPROMSIZE);
-    EEPROM.get(5, colorEEPROM);
-
-    switch(colorEEPROM){
-        case 0:
-            FGCOLOR = TFT_PURPLE+0x3000;
-            break;
-        case 1:
-            FGCOLOR = TFT_WHITE;
-            break;
-        case 2:
-            FGCOLOR = TFT_RED;
-            break;
-        case 3:
-            FGCOLOR = TFT_DARKGREEN;
-            break;
-        case 4:
-            FGCOLOR = TFT_BLUE;
-            break;
-        case 5:
-            FGCOLOR = TFT_YELLOW;
-            break;
-        case 7:
-            FGCOLOR = TFT_ORANGE;
-            break;
-        default:
-            FGCOLOR = TFT_PURPLE+0x3000;
-            EEPROM.put(5, 0);
-            EEPROM.commit();
-            break;
-
-    }
-    EEPROM.end(); // Free EEPROM memory
+void readFGCOLOR() {
+    static const uint16_t colors[8] = {
+        TFT_PURPLE+0x3000, TFT_WHITE, TFT_RED, TFT_DARKGREEN,
+        TFT_BLUE, TFT_YELLOW, TFT_MAGENTA, TFT_ORANGE
+    };
+    uint8_t color = bruceConfig.color;
+    if(color > 7) color = 0;
+    FGCOLOR = colors[color];
 }
 
 
@@ -49,6 +49,23 @@ extern bool wifiConnected;  // informa se o wifi está ativo ou não
 extern bool BLEConnected;  // informa se o BLE está ativo ou não
 
 extern std::vector<std::pair<std::string, std::function<void()>>> options;
+#define OPTIONS_RESERVE 32  // capacity kept by options, so rebuilding a menu doesn't grow it again
+
+// Menus that never change are tables of MenuItem in flash, run by
+// loopOptions(table, count, ...): no heap, no std::function. Board guards are #if
+// around the rows, visible() is asked each time the menu opens (NULL: always shown).
+// options stays for menus built at run time, like scan results and file lists.
+struct MenuItem {
+  const char *label;
+  void (*action)(int arg);
+  int arg;
+  bool (*visible)();
+};
+
+// Adapts a handler without arguments to MenuItem::action
+template <void (*F)()> void menuCall(int) { F(); }
+
+#define MENU_COUNT(table) (sizeof(table) / sizeof((table)[0]))
 
 extern  String ssid;
 
@@ -73,7 +90,7 @@ extern int RfTx;
 extern int RfRx;
 
 
-void readFGCOLORFromEEPROM();
+void readFGCOLOR();
 
 void backToMenu();
 
@@ -0,0 +1,93 @@
+#include "input.h"
+#include "globals.h"
+#include <freertos/timers.h>
+
+static TimerHandle_t inputTimer = NULL;
+
+#if defined(CARDPUTER)
+static uint64_t prevMask, nextMask, selMask, escMask;
+
+static uint64_t keyMask(char c) {
+  uint8_t bit = Keyboard.keyBit(c);
+  return bit == KB_NO_KEY ? 0 : 1ULL << bit;
+}
+
+/***************************************************************************************
+** Function name: inputTimerTick
+** Description:   runs every INPUT_TICK_MS, the matrix is scanned by the keyboard task
+**                so a tick only tests the menu keys in its map
+***************************************************************************************/
+static void inputTimerTick(TimerHandle_t timer) {
+  uint32_t now = millis();
+  uint64_t map = Keyboard.bits();
+  inputSample(IN_PREV, map & prevMask, now);
+  inputSample(IN_NEXT, map & nextMask, now);
+  inputSample(IN_SEL, (map & selMask) || digitalRead(0) == LOW, now);
+  inputSample(IN_ESC, map & escMask, now);
+
+  static uint16_t statTick = 0;
+  if (++statTick >= 1000) {
+    statTick = 0;
+    const KeyScanStats &st = Keyboard.scanStats();
+    log_d("kbScan: %u Hz, %u us (max %u), %u ghosts, %u edges dropped",
+          st.rateHz, st.lastUs, st.maxUs, st.ghosts, st.edgesDropped);
+  }
+}
+
+#else
+/***************************************************************************************
+** Function name: inputTimerTick
+** Description:   runs every INPUT_TICK_MS while a button is active
+***************************************************************************************/
+static void inputTimerTick(TimerHandle_t timer) {
+  uint32_t now = millis();
+  bool active = false;
+  active |= inputSample(IN_SEL, digitalRead(SEL_BTN) == LOW, now);
+  active |= inputSample(IN_NEXT, digitalRead(DW_BTN) == LOW, now);
+#if defined(STICK_C_PLUS2)
+  active |= inputSample(IN_PREV, digitalRead(UP_BTN) == LOW, now);
+#elif defined(STICK_C_PLUS)
+  // The AXP192 latches its button in a register, no interrupt reaches the ESP32:
+  // the timer keeps running and reads it every 5 ticks
+  static uint8_t axpTick = 0;
+  if (++axpTick >= 5) {
+    axpTick = 0;
+    if (axp192.GetBtnPress()) inputPulse(IN_PREV, now);
+  }
+  active = true;
+#endif
+  if (!active) xTimerStop(timer, 0);
+}
+
+static void IRAM_ATTR inputISR() {
+  BaseType_t woken = pdFALSE;
+  xTimerStartFromISR(inputTimer, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+#endif
+
+/***************************************************************************************
+** Function name: inputBegin
+** Description:   creates the event queue and hooks the button interrupts
+***************************************************************************************/
+void inputBegin() {
+  inputQueueBegin();
+  inputTimer = xTimerCreate("input", pdMS_TO_TICKS(INPUT_TICK_MS), pdTRUE, NULL, inputTimerTick);
+#if defined(CARDPUTER)
+  // the matrix has no interrupt, the tick runs all the time and costs four mask tests
+  Keyboard.startScan();
+  prevMask = keyMask(',') | keyMask(';');
+  nextMask = keyMask('/') | keyMask('.');
+  selMask = keyMask(KEY_ENTER);
+  escMask = keyMask('`');
+  xTimerStart(inputTimer, 0);
+#else
+  attachInterrupt(digitalPinToInterrupt(SEL_BTN), inputISR, CHANGE);
+  attachInterrupt(digitalPinToInterrupt(DW_BTN), inputISR, CHANGE);
+  #if defined(STICK_C_PLUS2)
+  attachInterrupt(digitalPinToInterrupt(UP_BTN), inputISR, CHANGE);
+  #elif defined(STICK_C_PLUS)
+  xTimerStart(inputTimer, 0);
+  #endif
+#endif
+}
@@ -0,0 +1,72 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+// Button events for the menus.
+// On the Sticks the buttons raise a GPIO interrupt that starts a 10 ms FreeRTOS timer,
+// the timer debounces them and turns them into events, then stops once every button
+// is released. The Cardputer matrix has no interrupt, the timer runs all the time and
+// reads the map kept by the keyboard scan task (Keyboard.startScan()).
+// Loops block in inputWait() instead of spinning on the check*Press() functions.
+
+#include <Arduino.h>
+
+#define INPUT_TICK_MS     10
+#define INPUT_DEBOUNCE    2     // stable samples before a change is accepted
+#define INPUT_LONG_MS     500
+#define INPUT_REPEAT_MS   150
+#define INPUT_CLICK_MS    300   // a press not taken by check*Press() within this time is forgotten
+#define INPUT_STALE_MS    1000  // inputWait() drops older events, made while nobody was waiting
+
+enum InputKey : uint8_t {
+  IN_PREV,   // Stick: power/upper button, also Esc
+  IN_NEXT,
+  IN_SEL,
+  IN_ESC,    // Cardputer only, the Sticks report IN_PREV
+  IN_KEYS
+};
+
+enum InputEventType : uint8_t {
+  EV_PRESS,
+  EV_RELEASE,
+  EV_LONG,    // held for INPUT_LONG_MS
+  EV_REPEAT,  // every INPUT_REPEAT_MS after EV_LONG
+};
+
+struct InputEvent {
+  uint8_t  key;
+  uint8_t  type;
+  uint16_t heldMs;   // time since the press, for EV_RELEASE, EV_LONG and EV_REPEAT
+  uint32_t timeMs;   // millis() when the event was made
+};
+
+struct InputStats {
+  uint32_t events;
+  uint32_t dropped;  // queue was full
+  uint32_t injected;
+};
+
+void inputBegin();
+
+// Waits up to timeoutMs for the next event, false on timeout
+bool inputWait(InputEvent &ev, uint32_t timeoutMs);
+
+// Forgets the queued events and pending presses
+void inputFlush();
+
+// Debounced level of a key
+bool inputHeld(uint8_t key);
+
+// True once for a press made in the last INPUT_CLICK_MS, used by check*Press()
+bool inputTakeClick(uint8_t key);
+
+// Pushes an event as if it came from the hardware, for automated tests and remote control
+void inputInject(uint8_t key, uint8_t type);
+
+// Used by the hardware side in input.cpp, the rest lives in input_events.cpp
+void inputQueueBegin();                                 // empties the queue and the key states
+bool inputSample(uint8_t key, bool raw, uint32_t now);  // one raw reading per tick, true while active
+void inputPulse(uint8_t key, uint32_t now);             // press and release of a latched button
+
+extern InputStats inputStats;
+
+#endif
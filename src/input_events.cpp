@@ -0,0 +1,117 @@
+#include "input.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+// Debounce and event queue of input.h. The hardware side (interrupts, the tick timer,
+// reading the pins) is in input.cpp, this part only needs FreeRTOS queues so the host
+// tests in test/test_input run it unchanged.
+
+#define INPUT_QUEUE_DEPTH 16
+
+struct KeyState {
+  bool     down;        // debounced level
+  uint8_t  count;       // samples the raw level differed from down
+  bool     longSent;
+  uint32_t downAt;
+  uint32_t nextRepeat;
+  uint32_t clickAt;     // millis() of a press not taken yet, 0 if none
+};
+
+InputStats inputStats;
+static KeyState keys[IN_KEYS];
+static QueueHandle_t inputQueue = NULL;
+
+static void inputEmit(uint8_t key, uint8_t type, uint32_t now) {
+  InputEvent ev = { key, type, (uint16_t)(type == EV_PRESS ? 0 : now - keys[key].downAt), now };
+  if (type == EV_PRESS) keys[key].clickAt = now ? now : 1;
+  inputStats.events++;
+  if (inputQueue == NULL || xQueueSend(inputQueue, &ev, 0) != pdTRUE) inputStats.dropped++;
+}
+
+void inputQueueBegin() {
+  memset(keys, 0, sizeof(keys));
+  memset(&inputStats, 0, sizeof(inputStats));
+  if (inputQueue == NULL) inputQueue = xQueueCreate(INPUT_QUEUE_DEPTH, sizeof(InputEvent));
+  else xQueueReset(inputQueue);
+}
+
+/***************************************************************************************
+** Function name: inputSample
+** Description:   debounces one raw sample of a key and makes its events
+***************************************************************************************/
+bool inputSample(uint8_t key, bool raw, uint32_t now) {
+  KeyState &k = keys[key];
+  if (raw != k.down) {
+    if (++k.count >= INPUT_DEBOUNCE) {
+      k.down = raw;
+      k.count = 0;
+      if (raw) {
+        k.downAt = now;
+        k.longSent = false;
+        inputEmit(key, EV_PRESS, now);
+      } else {
+        inputEmit(key, EV_RELEASE, now);
+      }
+    }
+  } else {
+    k.count = 0;
+  }
+
+  if (k.down && !k.longSent && now - k.downAt >= INPUT_LONG_MS) {
+    k.longSent = true;
+    k.nextRepeat = now + INPUT_REPEAT_MS;
+    inputEmit(key, EV_LONG, now);
+  } else if (k.down && k.longSent && (int32_t)(now - k.nextRepeat) >= 0) {
+    k.nextRepeat += INPUT_REPEAT_MS;
+    inputEmit(key, EV_REPEAT, now);
+  }
+  return k.down || k.count;  // still active
+}
+
+void inputPulse(uint8_t key, uint32_t now) {
+  keys[key].downAt = now;
+  inputEmit(key, EV_PRESS, now);
+  inputEmit(key, EV_RELEASE, now);
+}
+
+bool inputWait(InputEvent &ev, uint32_t timeoutMs) {
+  if (inputQueue == NULL) {
+    delay(timeoutMs);
+    return false;
+  }
+  uint32_t start = millis();
+  while (true) {
+    uint32_t waited = millis() - start;
+    TickType_t wait = pdMS_TO_TICKS(waited < timeoutMs ? timeoutMs - waited : 0);
+    if (xQueueReceive(inputQueue, &ev, wait) == pdTRUE) {
+      if (millis() - ev.timeMs > INPUT_STALE_MS) continue;
+      if (ev.type == EV_PRESS) keys[ev.key].clickAt = 0;  // taken here, check*Press() won't see it
+      return true;
+    }
+    if (millis() - start >= timeoutMs) return false;
+  }
+}
+
+void inputFlush() {
+  if (inputQueue) xQueueReset(inputQueue);
+  for (uint8_t i = 0; i < IN_KEYS; i++) keys[i].clickAt = 0;
+}
+
+bool inputHeld(uint8_t key) {
+  return key < IN_KEYS && keys[key].down;
+}
+
+bool inputTakeClick(uint8_t key) {
+  if (key >= IN_KEYS) return false;
+  uint32_t at = keys[key].clickAt;
+  keys[key].clickAt = 0;
+  return at && millis() - at < INPUT_CLICK_MS;
+}
+
+void inputInject(uint8_t key, uint8_t type) {
+  if (key >= IN_KEYS) return;
+  uint32_t now = millis();
+  if (type == EV_PRESS) keys[key].downAt = now;
+  inputStats.injected++;
+  inputEmit(key, type, now);
+}
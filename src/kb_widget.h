@@ -0,0 +1,187 @@
+#ifndef KB_WIDGET_H
+#define KB_WIDGET_H
+
+// Layout of the on-screen keyboard of keyboard(). The screen is drawn once, after that
+// a move only repaints the key that lost the focus and the one that got it, typing only
+// paints the characters that changed, and CAP repaints the letters.
+// The painters are templated on the display (tft on the device) so test/test_keyboard
+// runs them against a host framebuffer. Sizes and colours (WIDTH, LW, FP, FM, BGCOLOR,
+// FGCOLOR, TFT_*) come from the build flags and TFT_eSPI like in the rest of src.
+
+#include <stdint.h>
+#include <stddef.h>
+
+static const char kbKeys[4][12][2] = { //4 lines, with 12 characteres, low and high caps
+  { 
+    { '1', '!' },//1
+    { '2', '@' },//2
+    { '3', '#' },//3
+    { '4', '$' },//4
+    { '5', '%' },//5
+    { '6', '^' },//6
+    { '7', '&' },//7
+    { '8', '*' },//8
+    { '9', '(' },//9
+    { '0', ')' },//10
+    { '-', '_' },//11
+    { '=', '+' } //12 
+   }, 
+  { 
+    { 'q', 'Q' },//1
+    { 'w', 'W' },//2
+    { 'e', 'E' },//3
+    { 'r', 'R' },//4
+    { 't', 'T' },//5
+    { 'y', 'Y' },//6
+    { 'u', 'U' },//7
+    { 'i', 'I' },//8
+    { 'o', 'O' },//9
+    { 'p', 'P' },//10
+    { '[', '{' },//11
+    { ']', '}' } //12
+  },
+  { 
+    { 'a', 'A' },//1
+    { 's', 'S' },//2
+    { 'd', 'D' },//3
+    { 'f', 'F' },//4
+    { 'g', 'G' },//5
+    { 'h', 'H' },//6
+    { 'j', 'J' },//7
+    { 'k', 'K' },//8
+    { 'l', 'L' },//9
+    { ';', ':' },//10
+    { '"', '\'' },//11
+    { '|', '\\' } //12
+  },
+  { 
+    { '\\', '|' },//1
+    { 'z', 'Z' },//2
+    { 'x', 'X' },//3
+    { 'c', 'C' },//4
+    { 'v', 'V' },//5
+    { 'b', 'B' },//6
+    { 'n', 'N' },//7
+    { 'm', 'M' },//8
+    { ',', '<' },//9
+    { '.', '>' },//10
+    { '?', '/' },//11
+    { '/', '/' } //12 
+  }
+};
+
+#ifndef STICK_C
+#define KB_KEY_X    11   // first key
+#define KB_KEY_Y    54
+#define KB_KEY_DX   18   // key pitch
+#define KB_KEY_DY   19
+#define KB_KEY_W    21   // focus box, a bit wider than the pitch
+#define KB_KEY_H    19
+#define KB_TEXT_X   5
+#define KB_TEXT_Y   34
+#define KB_TEXT_BIG 19   // characters that fit at FM, more go to FP
+#define KB_TEXT_ROW 38   // characters per line at FP
+
+struct KbButton {
+  int16_t x, w;
+  int16_t textX;
+  const char *label;
+};
+
+static const KbButton kbButtons[4] = {
+  { 7,   46, 18,  "OK"    },
+  { 55,  50, 64,  "CAP"   },
+  { 107, 50, 115, "DEL"   },
+  { 159, 74, 168, "SPACE" },
+};
+
+/***************************************************************************************
+** Function name: kbDrawKey
+** Description:   paints one key of the grid, or one button when y is -1
+***************************************************************************************/
+template <class Gfx>
+static void kbDrawKey(Gfx &gfx, int x, int y, bool focused, bool caps) {
+  gfx.setTextSize(FM);
+  if(y<0) {
+    const KbButton &b = kbButtons[x>3 ? 3 : x];
+    uint16_t bg = focused ? TFT_WHITE : (b.label[0]=='C' && caps) ? TFT_DARKGREY : BGCOLOR;
+    gfx.fillRect(b.x,2,b.w,20,bg);
+    gfx.drawRect(b.x,2,b.w,20,TFT_WHITE);
+    gfx.setTextColor(focused ? BGCOLOR : TFT_WHITE, bg);
+    gfx.drawString(b.label, b.textX, 4);
+    return;
+  }
+  uint16_t bg = focused ? TFT_WHITE : BGCOLOR;
+  gfx.fillRect(x*KB_KEY_DX+KB_KEY_X, y*KB_KEY_DY+KB_KEY_Y, KB_KEY_W, KB_KEY_H, bg);
+  gfx.setTextColor(focused ? BGCOLOR : TFT_WHITE, bg);
+  gfx.drawChar(kbKeys[y][x][caps ? 1 : 0], x*KB_KEY_DX+KB_KEY_X+5, y*KB_KEY_DY+KB_KEY_Y+2);
+}
+
+/* Position and size of character n of a text of len characters */
+static void kbTextCell(size_t n, size_t len, int &cx, int &cy, int &size) {
+  if(len>KB_TEXT_BIG) {
+    size = FP;
+    cx = KB_TEXT_X + (n%KB_TEXT_ROW)*LW*FP;
+    cy = KB_TEXT_Y + (n/KB_TEXT_ROW)*8*FP;
+  } else {
+    size = FM;
+    cx = KB_TEXT_X + n*LW*FM;
+    cy = KB_TEXT_Y;
+  }
+}
+
+/***************************************************************************************
+** Function name: kbDrawText
+** Description:   paints the characters of the text from n on, clearing the box first
+**                when starting from 0
+***************************************************************************************/
+template <class Gfx>
+static void kbDrawText(Gfx &gfx, const char *text, size_t len, size_t n) {
+  if(n==0) {
+    gfx.fillRect(4,33,WIDTH-5,18,BGCOLOR);
+    gfx.drawRect(3,32,WIDTH-3,20,FGCOLOR); // mystring Rectangle
+  }
+  int cx, cy, size;
+  gfx.setTextColor(TFT_WHITE, BGCOLOR);
+  for(; n<len; n++) {
+    kbTextCell(n, len, cx, cy, size);
+    gfx.setTextSize(size);
+    gfx.drawChar(text[n], cx, cy);
+  }
+}
+
+/***************************************************************************************
+** Function name: kbUpdateText
+** Description:   paints what changed since the text had oldLen characters, only
+**                repaints it all when it moves between the big and the small font
+***************************************************************************************/
+template <class Gfx>
+static void kbUpdateText(Gfx &gfx, const char *text, size_t len, size_t oldLen) {
+  if((len>KB_TEXT_BIG) != (oldLen>KB_TEXT_BIG)) { kbDrawText(gfx, text, len, 0); return; }
+  int cx, cy, size;
+  for(size_t n=len; n<oldLen; n++) {
+    kbTextCell(n, oldLen, cx, cy, size);
+    gfx.fillRect(cx, cy, LW*size, 8*size, BGCOLOR);
+  }
+  if(len>oldLen) kbDrawText(gfx, text, len, oldLen);
+}
+
+/***************************************************************************************
+** Function name: kbDrawAll
+** Description:   paints the whole keyboard, focus on key x,y (y -1 is the buttons)
+***************************************************************************************/
+template <class Gfx>
+static void kbDrawAll(Gfx &gfx, const char *msg, const char *text, size_t len, int x, int y, bool caps) {
+  gfx.fillScreen(BGCOLOR);
+  for(int i=0;i<4;i++) kbDrawKey(gfx, i, -1, y==-1 && (x==i || (i==3 && x>3)), caps);  // SPACE takes x>3
+  gfx.setTextSize(FP);
+  gfx.setTextColor(TFT_WHITE, 0x5AAB);
+  gfx.drawString(msg, 3, 24);
+  kbDrawText(gfx, text, len, 0);
+  // the focus box is wider than the pitch, it goes last so the next key does not cut it
+  for(int i=0;i<4;i++) for(int j=0;j<12;j++) kbDrawKey(gfx, j, i, false, caps);
+  if(y>=0) kbDrawKey(gfx, x, y, true, caps);
+}
+#endif
+
+#endif
@@ -42,8 +42,13 @@ TFT_eSprite draw = TFT_eSprite(&tft);
 
 #include "mykeyboard.h"
 #include "display.h"
+#include "status_bar.h"
+#include "battery.h"
+#include "settings_store.h"
+#include "boot.h"
 #include "webInterface.h"
 #include "sd_functions.h"
+#include "storage_bench.h"
 #include "wifi_common.h"
 #include "settings.h"
 #include "dpwo.h"
@@ -109,8 +114,15 @@ void setup() {
   pinMode(0, INPUT);
   pinMode(10, INPUT);     // Pin that reads the
   #endif
+  inputBegin();           // Button events for the menus (input.h)
+  options.reserve(OPTIONS_RESERVE);
+  bootMark("gpio");
+  bootBegin();            // settings and LittleFS load on the startup task (boot.h)
+  batteryBegin();
 
-  tft.init();
+  tft.init();             // runs while the startup task reads the flash
+  bootMark("display");
+  bootWait(BOOT_SETTINGS_READY);  // before the getters below read bruceConfig
   rotation = gsetRotation();
   tft.setRotation(rotation);
   resetTftDisplay();
@@ -124,46 +136,117 @@ void setup() {
   gsetIrRxPin();
   gsetRfTxPin();
   gsetRfRxPin();
-  readFGCOLORFromEEPROM();
-  //Start Bootscreen timer
-  int i = millis();
-  bool change=false;
+  readFGCOLOR();
+
+  // Splash is drawn once, any key skips the rest of it
+  initDisplay();
   tft.setTextColor(FGCOLOR, TFT_BLACK);
-  tft.setTextSize(FM);
-  tft.println("Bruce");
   tft.setTextSize(FP);
-  tft.println(String(BRUCE_VERSION));
-  tft.setTextSize(FM);
-
-  if(!LittleFS.begin(true)) { LittleFS.format(), LittleFS.begin();}
-
-  while(millis()<i+7000) { // boot image lasts for 5 secs
-    if((millis()-i>2000) && (millis()-i)<2200) tft.fillScreen(TFT_BLACK);
-    if((millis()-i>2200) && (millis()-i)<2700) tft.drawRect(160,50,2,2,FGCOLOR);
-    if((millis()-i>2700) && (millis()-i)<2900) tft.fillScreen(TFT_BLACK);
-    if((millis()-i>2900) && (millis()-i)<3400 && !change)  { tft.drawXBitmap(130,45,bruce_small_bits, bruce_small_width, bruce_small_height,TFT_BLACK,FGCOLOR); }
-    if((millis()-i>3400) && (millis()-i)<3600) tft.fillScreen(TFT_BLACK);
-    if((millis()-i>3600)) tft.drawXBitmap(1,1,bits, bits_width, bits_height,TFT_BLACK,FGCOLOR);
-
-  #if defined (CARDPUTER)   // If any key is pressed, it'll jump the boot screen
-    Keyboard.update();
-    if(Keyboard.isPressed())
-  #else
-    if(digitalRead(SEL_BTN)==LOW)  // If M5 key is pressed, it'll jump the boot screen
-  #endif
-     {
-        tft.fillScreen(TFT_BLACK);
-        delay(10);
-        goto Program;
-      }
-  }
+  tft.setCursor(WIDTH - LW*String(BRUCE_VERSION).length() - 4, HEIGHT - 12);
+  tft.print(String(BRUCE_VERSION));
+  bootMark("splash");
 
-  // If M5 or Enter button is pressed, continue from here
-  Program:
-  delay(200);
+  InputEvent ev;
+  uint32_t splashEnd = millis() + BOOT_SPLASH_MS;
+  while ((int32_t)(splashEnd - millis()) > 0) {
+    if (inputWait(ev, splashEnd - millis()) && ev.type == EV_PRESS) break;
+  }
+  inputFlush();
+  tft.fillScreen(TFT_BLACK);
 
+  bootWait(BOOT_FS_READY);
+  bootMark("ready");
 }
 
+/**********************************************************************
+**  Main menu submenus, tables in flash (see MenuItem in globals.h)
+**********************************************************************/
+static bool wifiOff() { return !wifiConnected; }
+static bool wifiOn()  { return wifiConnected; }
+static void menuWifiConnect(int ap) { wifiConnectMenu(ap); }
+static void menuSsh(int)            { ssh_setup(); }
+static void menuEvilPortal(int)     { startEvilPortal(); }
+static void menuFiles(int lfs)      { if(lfs) loopSD(LittleFS); else loopSD(SD); }
+static void menuRestart(int)        { settingsFlush(); ESP.restart(); }
+template <int (*F)(bool)> void menuSet(int) { F(true); }
+
+static const MenuItem wifiMenu[] = {
+  {"Connect Wifi", menuWifiConnect,              0, wifiOff},  //wifi_common.h
+  {"WiFi AP",      menuWifiConnect,              1, wifiOff},  //wifi_common.h
+  {"Disconnect",   menuCall<wifiDisconnect>,     0, wifiOn},   //wifi_common.h
+  {"Wifi Atks",    menuCall<wifi_atk_menu>,      0, NULL},
+#ifndef STICK_C_PLUS
+  {"TelNET",       menuCall<telnet_setup>,       0, NULL},
+  {"SSH",          menuSsh,                      0, NULL},
+#endif
+  {"Raw Sniffer",  menuCall<sniffer_setup>,      0, NULL},
+  {"DPWO",         menuCall<dpwo_setup>,         0, NULL},
+  {"Evil Portal",  menuEvilPortal,               0, NULL},
+  {"Scan Hosts",   menuCall<local_scan_setup>,   0, NULL},
+#ifndef STICK_C_PLUS
+  {"Wireguard",    menuCall<wg_setup>,           0, NULL},
+#endif
+  {"Main Menu",    menuCall<backToMenu>,         0, NULL},
+};
+
+static const MenuItem bleMenu[] = {
+  {"AppleJuice",   aj_adv, 0, NULL},
+  {"SwiftPair",    aj_adv, 1, NULL},
+  {"Samsung Spam", aj_adv, 2, NULL},
+  {"SourApple",    aj_adv, 3, NULL},
+  {"Android Spam", aj_adv, 4, NULL},
+  {"BT Maelstrom", aj_adv, 5, NULL},
+  {"Main Menu",    menuCall<backToMenu>, 0, NULL},
+};
+
+static const MenuItem rfMenu[] = {
+  {"Spectrum",     menuCall<rf_spectrum>,           0, NULL}, //@IncursioHack
+  {"Record RAW",   menuCall<rf_record>,             0, NULL},
+  {"Decoder",      menuCall<rf_decode>,             0, NULL},
+  {"Jammer Itmt",  menuCall<rf_jammerIntermittent>, 0, NULL}, //@IncursioHack
+  {"Jammer Full",  menuCall<rf_jammerFull>,         0, NULL}, //@IncursioHack
+  {"Main Menu",    menuCall<backToMenu>,            0, NULL},
+};
+
+static const MenuItem rfidMenu[] = {
+  {"Copy/Write",   menuCall<rfid_setup>,  0, NULL}, //@IncursioHack
+  {"Main Menu",    menuCall<backToMenu>,  0, NULL},
+};
+
+static const MenuItem othersMenu[] = {
+  {"TV-B-Gone",    menuCall<StartTvBGone>,       0, NULL},
+  {"Custom IR",    menuCall<otherIRcodes>,       0, NULL},
+  {"SD Card",      menuFiles,                    0, NULL},
+  {"SD Benchmark", menuCall<storageBenchmark>,   0, NULL}, //storage_bench.h
+  {"LittleFS",     menuFiles,                    1, NULL},
+  {"WebUI",        menuCall<loopOptionsWebUi>,   0, NULL},
+  {"Megalodon",    menuCall<shark_setup>,        0, NULL},
+  {"Update",       menuCall<checkForUpdate>,     0, NULL},
+#ifdef CARDPUTER
+  {"BadUSB",       menuCall<usb_setup>,          0, NULL},
+  {"LED Control",  menuCall<ledrgb_setup>,       0, NULL}, //IncursioHack
+  {"LED FLash",    menuCall<ledrgb_flash>,       0, NULL}, // IncursioHack
+#endif
+  {"Openhaystack", menuCall<openhaystack_setup>, 0, NULL},
+  {"Main Menu",    menuCall<backToMenu>,         0, NULL},
+};
+
+static const MenuItem configMenu[] = {
+  {"Brightness",   menuCall<setBrightnessMenu>,  0, NULL}, //settings.h
+  {"Clock",        menuCall<setClock>,           0, NULL}, //settings.h
+  {"Orientation",  menuSet<gsetRotation>,        0, NULL}, //settings.h
+  {"UI Color",     menuCall<setUIColor>,         0, NULL},
+  {"Ir TX Pin",    menuSet<gsetIrTxPin>,         0, NULL}, //settings.h
+  {"Ir RX Pin",    menuSet<gsetIrRxPin>,         0, NULL}, //settings.h
+#ifndef CARDPUTER
+  {"RF TX Pin",    menuSet<gsetRfTxPin>,         0, NULL}, //settings.h
+  {"RF RX Pin",    menuSet<gsetRfRxPin>,         0, NULL}, //settings.h
+#endif
+  {"Boot Log",     menuCall<bootShowLog>,        0, NULL}, //boot.h
+  {"Restart",      menuRestart,                  0, NULL},
+  {"Main Menu",    menuCall<backToMenu>,         0, NULL},
+};
+
 /**********************************************************************
 **  Function: loop
 **  Main loop
@@ -172,6 +255,7 @@ void loop() {
   bool redraw = true;
   int index = 0;
   int opt = 6; // there are 3 options> 1 list SD files, 2 OTA and 3 Config
+  InputEvent ev;
   tft.fillRect(0,0,WIDTH,HEIGHT,BGCOLOR);
   while(1){
     if(returnToMenu) {
@@ -183,135 +267,49 @@ void loop() {
     if (redraw) {
       drawMainMenu(index);
       redraw = false;
-      delay(200);
     }
 
-    if(checkPrevPress()) {
+    // Wakes on a button event, or every second to refresh the clock
+    bool gotInput = inputWait(ev, 1000);
+    if(gotInput && ev.type != EV_PRESS && ev.type != EV_REPEAT) gotInput = false;
+
+    if(gotInput && ev.key == IN_PREV) {
       if(index==0) index = opt - 1;
       else if(index>0) index--;
       redraw = true;
     }
     /* DW Btn to next item */
-    if(checkNextPress()) {
+    if(gotInput && ev.key == IN_NEXT) {
       index++;
       if((index+1)>opt) index = 0;
       redraw = true;
     }
 
     /* Select and run function */
-    if(checkSelPress()) {
+    if(gotInput && ev.key == IN_SEL && ev.type == EV_PRESS) {
       switch(index) {
         case 0:   // WiFi
-          if(!wifiConnected) {
-            options = {
-              {"Connect Wifi", [=]()  { wifiConnectMenu(); }},    //wifi_common.h
-              {"WiFi AP", [=]()       { wifiConnectMenu(true); }},//wifi_common.h
-            };
-          } else {
-            options = {
-              {"Disconnect", [=]()  { wifiDisconnect(); }},    //wifi_common.h
-            };
-          }
-          options.push_back({"Wifi Atks", [=]()     { wifi_atk_menu(); }});
-        #ifndef STICK_C_PLUS
-          options.push_back({"TelNET", [=]()        { telnet_setup(); }});
-          options.push_back({"SSH", [=]()           { ssh_setup(); }});
-        #endif
-          options.push_back({"Raw Sniffer", [=]()   { sniffer_setup(); }});
-          options.push_back({"DPWO", [=]()          { dpwo_setup(); }});
-          options.push_back({"Evil Portal", [=]()   { startEvilPortal(); }});
-          options.push_back({"Scan Hosts", [=]()    { local_scan_setup(); }});
-        #ifndef STICK_C_PLUS
-          options.push_back({"Wireguard", [=]()     { wg_setup(); }});
-        #endif
-          options.push_back({"Main Menu", [=]()     { backToMenu(); }});
-          delay(200);
-          loopOptions(options,false,true,"WiFi");
+          loopOptions(wifiMenu, MENU_COUNT(wifiMenu), false, true, "WiFi");
           break;
         case 1: // BLE
-          options = {
-            {"AppleJuice", [=]()   { aj_adv(0); }},
-            {"SwiftPair", [=]()    { aj_adv(1); }},
-            {"Samsung Spam", [=]() { aj_adv(2);}},
-            {"SourApple", [=]()    { aj_adv(3); }},
-            {"Android Spam", [=]() { aj_adv(4); }},
-            {"BT Maelstrom", [=]() { aj_adv(5); }},
-            {"Main Menu", [=]()    { backToMenu(); }},
-          };
-          delay(200);
-          loopOptions(options,false,true,"Bluetooth");
+          loopOptions(bleMenu, MENU_COUNT(bleMenu), false, true, "Bluetooth");
           break;
         case 2: // RF
-          options = {
-            //{"Scan/copy", [=]()   { displayRedStripe("Scan/Copy"); }},
-            //{"Replay", [=]()      { displayRedStripe("Replay"); }},
-            {"Spectrum", [=]()            { rf_spectrum(); }}, //@IncursioHack
-            {"Jammer Itmt", [=]() { rf_jammerIntermittent(); }}, //@IncursioHack
-            {"Jammer Full", [=]()         { rf_jammerFull(); }}, //@IncursioHack
-            {"Main Menu", [=]()   { backToMenu(); }},
-          };
-          delay(200);
-          loopOptions(options,false,true,"Radio Frequency");
+          loopOptions(rfMenu, MENU_COUNT(rfMenu), false, true, "Radio Frequency");
           break;
         case 3: // RFID
-          options = {
-            {"Copy/Write", [=]()   { rfid_setup(); }}, //@IncursioHack
-            //{"Replay", [=]()      { displayRedStripe("Replay"); }},
-            {"Main Menu", [=]()    { backToMenu(); }},
-          };
-          delay(200);
-          loopOptions(options,false,true,"RFID");
+          loopOptions(rfidMenu, MENU_COUNT(rfidMenu), false, true, "RFID");
           break;
         case 4: //Other
-          options = {
-            {"TV-B-Gone", [=]()     { StartTvBGone(); }},
-            {"Custom IR", [=]()     { otherIRcodes(); }},
-            {"SD Card", [=]()       { loopSD(SD); }},
-            {"LittleFS", [=]()      { loopSD(LittleFS); }},
-            {"WebUI", [=]()         { loopOptionsWebUi(); }},
-            {"Megalodon", [=]()     { shark_setup(); }},
-            {"Update", [=]()        { checkForUpdate(); }}
-          };
-          #ifdef CARDPUTER
-          options.push_back({"BadUSB", [=]()        { usb_setup(); }});
-          options.push_back({"LED Control", [=]()   { ledrgb_setup(); }}); //IncursioHack
-          options.push_back({"LED FLash", [=]()     { ledrgb_flash(); }}); // IncursioHack                   
-
-          #endif
-          options.push_back({"Openhaystack", [=]()  { openhaystack_setup(); }});
-          options.push_back({"Main Menu", [=]()     { backToMenu(); }});
-          delay(200);
-          loopOptions(options,false,true,"Others");
+          loopOptions(othersMenu, MENU_COUNT(othersMenu), false, true, "Others");
           break;
         case 5: //Config
-          options = {
-            {"Brightness",    [=]() { setBrightnessMenu(); }},              //settings.h
-            {"Clock",         [=]() { setClock();  }},                      //settings.h
-            {"Orientation",   [=]() { gsetRotation(true); }},               //settings.h
-            {"UI Color", [=]() { setUIColor();}},
-            {"Ir TX Pin",     [=]() { gsetIrTxPin(true);}},                 //settings.h
-            {"Ir RX Pin",     [=]() { gsetIrRxPin(true);}},                 //settings.h
-            #ifndef CARDPUTER
-            {"RF TX Pin",     [=]() { gsetRfTxPin(true);}},                 //settings.h
-            {"RF RX Pin",     [=]() { gsetRfRxPin(true);}},                 //settings.h
-            #endif
-            {"Restart",       [=]() { ESP.restart(); }},
-            {"Main Menu",     [=]() { backToMenu(); }},
-          };
-          delay(200);
-          loopOptions(options,false,true,"Config");
+          loopOptions(configMenu, MENU_COUNT(configMenu), false, true, "Config");
           break;
       }
       redraw=true;
     }
-    if(clock_set) {
-      updateTimeStr(rtc.getTimeStruct());
-      setTftDisplay(12, 12, FGCOLOR, 1, BGCOLOR);
-      tft.print(timeStr);
-    }
-   else{
-      setTftDisplay(12, 12, FGCOLOR, 1, BGCOLOR);
-      tft.print("BRUCE " + String(BRUCE_VERSION));
-    }
+    statusBarUpdate();  // repaints the clock on the minute, the rest when it changes
+    statusBarDraw();
   }
 }
\ No newline at end of file
@@ -14,14 +14,54 @@
 // Functions for setting up the Arduino
 /////////////////////////////////////////////////////////////////////////////////////
 
+/////////////////////////////////////////////////////////////////////////////////////
+// Wire transport
+/////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Writes count bytes to a register in one transaction.
+ * The interface is described in the datasheet section 8.1.2.
+ */
+void MFRC522_WireTransport::writeRegister(	byte address, byte reg, const byte *values, byte count) {
+	_wire.beginTransmission(address);
+	_wire.write(reg);
+	_wire.write(values, count);
+	_wire.endTransmission();
+	stats.transactions++;
+	stats.bytes += count + 1;
+} // End writeRegister()
+
+/**
+ * Reads count bytes from a register.
+ * The address phase ends with a repeated START instead of a STOP, so the bus is kept
+ * between the two phases and the read counts as a single transaction.
+ */
+byte MFRC522_WireTransport::readRegister(	byte address, byte reg, byte *values, byte count) {
+	_wire.beginTransmission(address);
+	_wire.write(reg);
+	_wire.endTransmission(false);
+	_wire.requestFrom(address, count);
+	byte index = 0;
+	while (_wire.available() && index < count) {
+		values[index++] = _wire.read();
+	}
+	stats.transactions++;
+	stats.bytes += index + 1;
+	return index;
+} // End readRegister()
+
+static MFRC522_WireTransport defaultTransport;
+
 /**
  * Constructor.
  * Prepares the output pins.
  */
-MFRC522::MFRC522(	byte chipAddress
+MFRC522::MFRC522(	byte chipAddress,
+					MFRC522_Transport *transport	///< Bus to reach the chip. NULL for Wire.
 					//byte resetPowerDownPin	///< Arduino pin connected to MFRC522's reset and power down input (Pin 6, NRSTPD, active low)
 				) {
 	_chipAddress = chipAddress;
+	_transport = transport ? transport : &defaultTransport;
 	// _resetPowerDownPin = resetPowerDownPin;
 } // End constructor
 
@@ -37,10 +77,7 @@ MFRC522::MFRC522(	byte chipAddress
 void MFRC522::PCD_WriteRegister(	byte reg,		///< The register to write to. One of the PCD_Register enums.
 									byte value		///< The value to write.
 								) {
-	Wire.beginTransmission(_chipAddress);
-	Wire.write(reg);
-	Wire.write(value);
-	Wire.endTransmission();
+	_transport->writeRegister(_chipAddress, reg, &value, 1);
 } // End PCD_WriteRegister()
 
 /**
@@ -51,12 +88,7 @@ void MFRC522::PCD_WriteRegister(	byte reg,		///< The register to write to. One o
 									byte count,		///< The number of bytes to write to the register
 									byte *values	///< The values to write. Byte array.
 								) {
-	Wire.beginTransmission(_chipAddress);
-	Wire.write(reg);
-	for (byte index = 0; index < count; index++) {
-		Wire.write(values[index]);
-	}
-	Wire.endTransmission();
+	_transport->writeRegister(_chipAddress, reg, values, count);
 } // End PCD_WriteRegister()
 
 /**
@@ -65,14 +97,8 @@ void MFRC522::PCD_WriteRegister(	byte reg,		///< The register to write to. One o
  */
 byte MFRC522::PCD_ReadRegister(	byte reg	///< The register to read from. One of the PCD_Register enums.
 								) {
-	byte value;
-	//digitalWrite(_chipSelectPin, LOW);			// Select slave
-	Wire.beginTransmission(_chipAddress);
-	Wire.write(reg);
-	Wire.endTransmission();
-
-	Wire.requestFrom((int)_chipAddress, 1); // adicionado (int) par acompatibilidade
-	value = Wire.read();
+	byte value = 0;
+	_transport->readRegister(_chipAddress, reg, &value, 1);
 	return value;
 } // End PCD_ReadRegister()
 
@@ -88,28 +114,16 @@ void MFRC522::PCD_ReadRegister(	byte reg,		///< The register to read from. One o
 	if (count == 0) {
 		return;
 	}
-	byte address = reg;
-	byte index = 0;							// Index in values array.
-	Wire.beginTransmission(_chipAddress);
-	Wire.write(address);
-	Wire.endTransmission();
-	Wire.requestFrom(_chipAddress, count);
-	while (Wire.available()) {
-		if (index == 0 && rxAlign) {		// Only update bit positions rxAlign..7 in values[0]
-			// Create bit mask for bit positions rxAlign..7
-			byte mask = 0;
-			for (byte i = rxAlign; i <= 7; i++) {
-				mask |= (1 << i);
-			}
-			// Read value and tell that we want to read the same address again.
-			byte value = Wire.read();
-			// Apply mask to both current value of values[0] and the new data in value.
-			values[0] = (values[index] & ~mask) | (value & mask);
-		}
-		else { // Normal case
-			values[index] = Wire.read();
+	byte first = values[0];
+	_transport->readRegister(_chipAddress, reg, values, count);
+	if (rxAlign) {		// Only update bit positions rxAlign..7 in values[0]
+		// Create bit mask for bit positions rxAlign..7
+		byte mask = 0;
+		for (byte i = rxAlign; i <= 7; i++) {
+			mask |= (1 << i);
 		}
-		index++;
+		// Apply mask to both current value of values[0] and the new data.
+		values[0] = (first & ~mask) | (values[0] & mask);
 	}
 } // End PCD_ReadRegister()
 
@@ -137,37 +151,25 @@ void MFRC522::PCD_ClearRegisterBitMask(	byte reg,	///< The register to update. O
 
 
 /**
- * Use the CRC coprocessor in the MFRC522 to calculate a CRC_A.
+ * Calculates a CRC_A (ISO/IEC 14443-3, polynomial x^16 + x^12 + x^5 + 1, preset 6363h).
+ * This used to run on the CRC coprocessor of the MFRC522, which costs a FIFO load, a
+ * command and a polling loop over I2C (a dozen transactions or more) for a few bytes.
+ * The CPU does it in well under a microsecond per byte.
  *
  * @return STATUS_OK on success, STATUS_??? otherwise.
  */
-byte MFRC522::PCD_CalculateCRC(	byte *data,		///< In: Pointer to the data to transfer to the FIFO for CRC calculation.
-								byte length,	///< In: The number of bytes to transfer.
+byte MFRC522::PCD_CalculateCRC(	byte *data,		///< In: Pointer to the data to calculate the CRC_A for.
+								byte length,	///< In: The number of bytes.
 								byte *result	///< Out: Pointer to result buffer. Result is written to result[0..1], low byte first.
 					 ) {
-	PCD_WriteRegister(CommandReg, PCD_Idle);		// Stop any active command.
-	PCD_WriteRegister(DivIrqReg, 0x04);				// Clear the CRCIRq interrupt request bit
-	PCD_SetRegisterBitMask(FIFOLevelReg, 0x80);		// FlushBuffer = 1, FIFO initialization
-	PCD_WriteRegister(FIFODataReg, length, data);	// Write data to the FIFO
-	PCD_WriteRegister(CommandReg, PCD_CalcCRC);		// Start the calculation
-
-	// Wait for the CRC calculation to complete. Each iteration of the while-loop takes 17.73�s.
-	word i = 5000;
-	byte n;
-	while (1) {
-		n = PCD_ReadRegister(DivIrqReg);	// DivIrqReg[7..0] bits are: Set2 reserved reserved MfinActIRq reserved CRCIRq reserved reserved
-		if (n & 0x04) {						// CRCIRq bit set - calculation done
-			break;
-		}
-		if (--i == 0) {						// The emergency break. We will eventually terminate on this one after 89ms. Communication with the MFRC522 might be down.
-			return STATUS_TIMEOUT;
-		}
-	}
-	PCD_WriteRegister(CommandReg, PCD_Idle);		// Stop calculating CRC for new content in the FIFO.
-
-	// Transfer the result from the registers to the result buffer
-	result[0] = PCD_ReadRegister(CRCResultRegL);
-	result[1] = PCD_ReadRegister(CRCResultRegH);
+	uint16_t crc = 0x6363;
+	for (byte i = 0; i < length; i++) {
+		byte b = data[i] ^ (byte)crc;
+		b ^= b << 4;
+		crc = (crc >> 8) ^ ((uint16_t)b << 8) ^ ((uint16_t)b << 3) ^ (b >> 4);
+	}
+	result[0] = crc & 0xFF;
+	result[1] = crc >> 8;
 	return STATUS_OK;
 } // End PCD_CalculateCRC()
 
@@ -389,12 +391,15 @@ byte MFRC522::PCD_CommunicateWithPICC(	byte command,		///< The command to execut
 
 	PCD_WriteRegister(CommandReg, PCD_Idle);			// Stop any active command.
 	PCD_WriteRegister(ComIrqReg, 0x7F);					// Clear all seven interrupt request bits
-	PCD_SetRegisterBitMask(FIFOLevelReg, 0x80);			// FlushBuffer = 1, FIFO initialization
+	PCD_WriteRegister(FIFOLevelReg, 0x80);				// FlushBuffer = 1, FIFO initialization. FIFOLevel[6..0] is read only, no need to read it first.
 	PCD_WriteRegister(FIFODataReg, sendLen, sendData);	// Write sendData to the FIFO
-	PCD_WriteRegister(BitFramingReg, bitFraming);		// Bit adjustments
-	PCD_WriteRegister(CommandReg, command);				// Execute the command
 	if (command == PCD_Transceive) {
-		PCD_SetRegisterBitMask(BitFramingReg, 0x80);	// StartSend=1, transmission of data starts
+		PCD_WriteRegister(CommandReg, command);			// Execute the command
+		PCD_WriteRegister(BitFramingReg, bitFraming | 0x80);	// Bit adjustments and StartSend=1 in one write, transmission of data starts
+	}
+	else {
+		PCD_WriteRegister(BitFramingReg, bitFraming);	// Bit adjustments
+		PCD_WriteRegister(CommandReg, command);			// Execute the command
 	}
 
 	// Wait for the command to complete.
@@ -134,6 +134,36 @@ const byte FM17522_firmware_reference[] PROGMEM = {
 	0x56, 0x9A, 0x98, 0x82, 0x26, 0xEA, 0x2A, 0x62
 };
 
+/**
+ * Bus used to reach the MFRC522 registers.
+ * The default implementation goes through Wire; another one (a simulated PCD on the
+ * host, a second I2C bus) can be handed to the MFRC522 constructor.
+ * Every bus transaction is counted in stats, so the cost of a PICC operation can be
+ * measured by resetting the counters before it and reading them after.
+ */
+class MFRC522_Transport {
+public:
+	typedef struct {
+		uint32_t	transactions;	// I2C transactions (address + data, ended by STOP)
+		uint32_t	bytes;			// Payload bytes moved, register addresses included
+	} Stats;
+
+	Stats stats = {0, 0};
+
+	virtual ~MFRC522_Transport() {}
+	virtual void writeRegister(byte address, byte reg, const byte *values, byte count) = 0;
+	virtual byte readRegister(byte address, byte reg, byte *values, byte count) = 0;	// Returns the number of bytes read
+};
+
+class MFRC522_WireTransport : public MFRC522_Transport {
+public:
+	MFRC522_WireTransport(TwoWire &wire = Wire) : _wire(wire) {}
+	void writeRegister(byte address, byte reg, const byte *values, byte count) override;
+	byte readRegister(byte address, byte reg, byte *values, byte count) override;
+private:
+	TwoWire &_wire;
+};
+
 class MFRC522 {
 public:
 	// MFRC522 registers. Described in chapter 9 of the datasheet.
@@ -321,7 +351,7 @@ public:
 	/////////////////////////////////////////////////////////////////////////////////////
 	// Functions for setting up the Arduino
 	/////////////////////////////////////////////////////////////////////////////////////
-	MFRC522(byte chipAddress);
+	MFRC522(byte chipAddress, MFRC522_Transport *transport = NULL);
 
 	/////////////////////////////////////////////////////////////////////////////////////
 	// Basic interface functions for communicating with the MFRC522
@@ -334,6 +364,8 @@ public:
 	void PCD_SetRegisterBitMask(byte reg, byte mask);
 	void PCD_ClearRegisterBitMask(byte reg, byte mask);
 	byte PCD_CalculateCRC(byte *data, byte length, byte *result);
+	const MFRC522_Transport::Stats &PCD_GetStats() { return _transport->stats; }
+	void PCD_ResetStats() { _transport->stats = {0, 0}; }
 
 	/////////////////////////////////////////////////////////////////////////////////////
 	// Functions for manipulating the MFRC522
@@ -400,6 +432,7 @@ public:
 
 private:
 	byte _chipAddress;
+	MFRC522_Transport *_transport;
 	byte _resetPowerDownPin;	// Arduino pin connected to MFRC522's reset and power down input (Pin 6, NRSTPD, active low)
 	byte MIFARE_TwoStepHelper(byte command, byte blockAddr, long data);
 };
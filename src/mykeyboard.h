@@ -1,5 +1,6 @@
 #include "display.h"
 #include "globals.h"
+#include "input.h"
 
 
 String keyboard(String mytext, int maxSize = 76, String msg = "Type your message:");
@@ -0,0 +1,174 @@
+#include "ota_sink.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+static void otaWrite(OtaSink& s, const uint8_t* data, size_t len) {
+    mbedtls_sha256_update(&s.sha, data, len);
+    if (s.gzip) s.crc = crc32_le(s.crc, data, len);
+    if (s.target->write(data, len) != len) s.error = s.target->errorString();
+    s.written += len;
+}
+
+bool parseSha256(const char* text, uint8_t out[32]) {
+    for (int i = 0; i < 64; i++) {
+        if (!isxdigit((unsigned char)text[i])) return false;
+    }
+    for (int i = 0; i < 32; i++) {
+        char byteHex[3] = { text[2 * i], text[2 * i + 1], 0 };
+        out[i] = strtoul(byteHex, NULL, 16);
+    }
+    return true;
+}
+
+// The stage after the one that just ended, the optional ones come in this order
+static uint8_t gzipNextStage(const GzipHeader& h, uint8_t done) {
+    static const uint8_t flagOf[] = { 0, 0x04, 0, 0x08, 0x10, 0x02 };   // FEXTRA FNAME FCOMMENT FHCRC
+    uint8_t stage = done + 1;
+    while (stage < GZ_BODY && !(h.flags & flagOf[stage])) stage++;
+    return stage;
+}
+
+size_t gzipHeaderFeed(GzipHeader& h, const uint8_t* p, size_t len) {
+    size_t used = 0;
+    while (used < len && h.stage < GZ_BODY) {
+        uint8_t b = p[used++];
+        uint8_t done = GZ_BODY;      // stage that ends with this byte, if any
+        switch (h.stage) {
+        case GZ_FIXED:
+            if ((h.at == 0 && b != 0x1F) || (h.at == 1 && b != 0x8B) || (h.at == 2 && b != 8) || (h.at == 3 && (b & 0xE0))) {
+                h.stage = GZ_BAD;
+                return used;
+            }
+            if (h.at == 3) h.flags = b;
+            if (++h.at == 10) done = GZ_FIXED;
+            break;
+        case GZ_XLEN:
+            h.skip |= b << (8 * h.at);
+            if (++h.at == 2) {
+                h.at = 0;
+                h.stage = GZ_EXTRA;
+                if (h.skip == 0) done = GZ_EXTRA;
+            }
+            break;
+        case GZ_EXTRA:
+            if (--h.skip == 0) done = GZ_EXTRA;
+            break;
+        case GZ_NAME:
+        case GZ_COMMENT:
+            if (b == 0) done = h.stage;
+            break;
+        case GZ_HCRC:
+            if (++h.at == 2) done = GZ_HCRC;
+            break;
+        }
+        if (done != GZ_BODY) {
+            h.stage = gzipNextStage(h, done);
+            h.at = 0;
+        }
+    }
+    return used;
+}
+
+int gzipHeader(const uint8_t* p, size_t len) {
+    GzipHeader h = {};
+    size_t used = gzipHeaderFeed(h, p, len);
+    return h.stage == GZ_BODY ? (int)used : -1;
+}
+
+void otaSinkBegin(OtaSink& sink, OtaTarget* target, size_t total, int command) {
+    memset(&sink, 0, sizeof(sink));
+    sink.target = target;
+    sink.total = total;
+    sink.command = command;
+    mbedtls_sha256_init(&sink.sha);
+    mbedtls_sha256_starts(&sink.sha, 0);   // hardware SHA engine on the ESP32
+}
+
+/***************************************************************************************
+** Function name: otaFeed
+** Description:   the first two bytes tell a gzip image from a raw one and begin the
+**                target, a gzip image is inflated chunk by chunk through a 32 KB window
+**                and its header and trailer may be split over any number of writes
+***************************************************************************************/
+void otaFeed(OtaSink& s, const uint8_t* data, size_t len) {
+    if (s.error) return;
+    if (!s.begun) {
+        while (s.magicLen < 2 && len) { s.magic[s.magicLen++] = *data++; len--; }
+        if (s.magicLen < 2) return;
+        s.begun = true;
+        s.gzip = s.magic[0] == 0x1F && s.magic[1] == 0x8B;
+        if (s.gzip) {
+            s.inf = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor));
+            s.dict = (uint8_t*)malloc(TINFL_LZ_DICT_SIZE);
+            if (!s.inf || !s.dict) {
+                s.error = "Error: Not enough memory.";
+                return;
+            }
+            tinfl_init(s.inf);
+            gzipHeaderFeed(s.header, s.magic, 2);
+        }
+        if (!s.target->begin(s.gzip ? OTA_SIZE_UNKNOWN : s.total, s.command)) {
+            s.error = "Not enough space to begin OTA update";
+            return;
+        }
+        if (!s.gzip) otaWrite(s, s.magic, 2);
+    }
+    if (!s.gzip) {
+        if (len) otaWrite(s, data, len);
+        return;
+    }
+    if (s.header.stage != GZ_BODY) {
+        size_t used = gzipHeaderFeed(s.header, data, len);
+        data += used;
+        len -= used;
+        if (s.header.stage == GZ_BAD) s.error = "Bad gzip header.";
+        if (s.header.stage != GZ_BODY) return;
+    }
+    while (!s.error && !s.done) {
+        size_t in = len;
+        size_t out = TINFL_LZ_DICT_SIZE - s.dictOfs;
+        tinfl_status status = tinfl_decompress(s.inf, data, &in, s.dict, s.dict + s.dictOfs, &out,
+                                               TINFL_FLAG_HAS_MORE_INPUT);
+        data += in;
+        len -= in;
+        if (out) otaWrite(s, s.dict + s.dictOfs, out);
+        s.dictOfs = (s.dictOfs + out) & (TINFL_LZ_DICT_SIZE - 1);
+        if (status == TINFL_STATUS_DONE) s.done = true;
+        else if (status < TINFL_STATUS_DONE) s.error = "Corrupted gzip image.";
+        else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && len == 0) return;
+    }
+    // tinfl leaves the bytes after the deflate stream, the trailer
+    while (s.done && len && s.trailerLen < sizeof(s.trailer)) { s.trailer[s.trailerLen++] = *data++; len--; }
+}
+
+const char* otaSinkFinish(OtaSink& sink, size_t received, const uint8_t* expected) {
+    static char msg[50];
+    uint8_t digest[32];
+    mbedtls_sha256_finish(&sink.sha, digest);
+    mbedtls_sha256_free(&sink.sha);
+    free(sink.inf);
+    free(sink.dict);
+    sink.inf = NULL;
+    sink.dict = NULL;
+
+    const char* error = sink.error;
+    if (!error && sink.gzip && sink.header.stage != GZ_BODY) error = "Bad gzip header.";
+    if (!error && (sink.gzip ? sink.trailerLen < sizeof(sink.trailer) : received != sink.total)) {
+        sprintf(msg, "Written only: %d/%d. Retry?", (int)received, (int)sink.total);
+        error = msg;
+    }
+    if (!error && sink.gzip) {
+        const uint8_t* t = sink.trailer;
+        uint32_t crc = t[0] | t[1] << 8 | t[2] << 16 | (uint32_t)t[3] << 24;
+        uint32_t isize = t[4] | t[5] << 8 | t[6] << 16 | (uint32_t)t[7] << 24;
+        if (crc != sink.crc || isize != (uint32_t)sink.written) error = "Corrupted gzip image.";
+    }
+    if (!error && expected && memcmp(digest, expected, sizeof(digest)) != 0) {
+        error = "SHA-256 mismatch, update discarded.";
+    }
+    if (!error && !sink.target->end()) error = sink.target->errorString();
+    if (error) sink.target->abort();
+    return error;
+}
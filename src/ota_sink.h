@@ -0,0 +1,74 @@
+#ifndef OTA_SINK_H
+#define OTA_SINK_H
+
+// Where the downloaded bytes of an OTA or SD install go: straight to the partition or
+// through inflate for a gzip image, the written bytes are hashed. Kept apart from the
+// download in upnew.cpp, and writing through OtaTarget (Update on the device), so it
+// also builds and is tested on a host.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <mbedtls/sha256.h>
+#include <rom/miniz.h>
+#include <rom/crc.h>
+
+#define OTA_SIZE_UNKNOWN 0xFFFFFFFF   // UPDATE_SIZE_UNKNOWN, a gzip image is sized by its end
+
+class OtaTarget {
+public:
+    virtual ~OtaTarget() {}
+    virtual bool begin(size_t size, int command) = 0;
+    virtual size_t write(const uint8_t* data, size_t len) = 0;
+    virtual bool end() = 0;             // checks and commits what was written
+    virtual void abort() = 0;
+    virtual const char* errorString() = 0;
+};
+
+enum { GZ_FIXED, GZ_XLEN, GZ_EXTRA, GZ_NAME, GZ_COMMENT, GZ_HCRC, GZ_BODY, GZ_BAD };
+
+// Where a gzip header (RFC 1952) read a few bytes at a time has got to
+struct GzipHeader {
+    uint8_t stage;          // GZ_*
+    uint8_t flags;
+    uint8_t at;             // bytes of the current stage seen
+    uint16_t skip;          // FEXTRA length
+};
+
+// A resumed download keeps feeding the same sink
+struct OtaSink {
+    OtaTarget* target;
+    size_t total;           // bytes to download
+    int command;            // U_FLASH or U_SPIFFS
+    bool begun;
+    bool gzip;
+    bool done;              // gzip: end of the deflate stream reached
+    const char* error;
+    size_t written;         // bytes given to the target
+    mbedtls_sha256_context sha;
+    uint8_t magic[2];       // first bytes, they may come one write apart
+    uint8_t magicLen;
+    GzipHeader header;
+    tinfl_decompressor* inf;
+    uint8_t* dict;          // inflate output, also the window of past bytes
+    size_t dictOfs;
+    uint32_t crc;           // gzip: CRC-32 of the inflated image
+    uint8_t trailer[8];     // gzip: CRC-32 and ISIZE after the deflate stream
+    uint8_t trailerLen;
+};
+
+// Digest at the start of a sha256sum line: 64 hex digits
+bool parseSha256(const char* text, uint8_t out[32]);
+
+// Reads on through a gzip header, returns how many of the bytes belong to it. h.stage
+// is GZ_BODY once the header is over and GZ_BAD when it is not one of a deflate stream.
+size_t gzipHeaderFeed(GzipHeader& h, const uint8_t* p, size_t len);
+// Size of the gzip header at the start of data, -1 if it is not one or is cut short
+int gzipHeader(const uint8_t* p, size_t len);
+
+void otaSinkBegin(OtaSink& sink, OtaTarget* target, size_t total, int command);
+void otaFeed(OtaSink& sink, const uint8_t* data, size_t len);
+// Commits the image if it is complete and matches expected (when given), otherwise
+// discards it. Returns NULL or why it was discarded.
+const char* otaSinkFinish(OtaSink& sink, size_t received, const uint8_t* expected);
+
+#endif // OTA_SINK_H
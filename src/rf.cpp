@@ -6,6 +6,7 @@
 #include "display.h"
 #include "PCA9554.h"
 #include "sd_functions.h"
+#include "rf_decoder.h"
 #include <driver/rmt.h>
 
 // Cria um objeto PCA9554 com o endereço I2C do PCA9554PW
@@ -42,6 +43,103 @@ void initRMT() {
 
 bool sendRF = false;
 
+/***************************************************************************************
+** Spectrum view
+** The RMT ring buffer is drained by its own task, that folds every pulse width into
+** a bin accumulator. The UI side swaps the accumulator once per frame and renders it
+** into a sprite: a scrolling waterfall (one row per frame) and a decaying histogram.
+** A slow display never blocks the drain task, so no RMT batch is lost.
+***************************************************************************************/
+#define SPECTRUM_BINS     DISPLAY_WIDTH // one bin per column
+#define SPECTRUM_BIN_US   10            // pulse width covered by each bin (us)
+#define SPECTRUM_TOP      20            // Y where the sprite is pushed
+#define SPECTRUM_HEIGHT   (HEIGHT - SPECTRUM_TOP)
+#define WATERFALL_HEIGHT  90
+#define HISTOGRAM_HEIGHT  (SPECTRUM_HEIGHT - WATERFALL_HEIGHT)
+#define SPECTRUM_FRAME_MS 40            // 25 fps cap
+
+static uint16_t spectrumAcc[SPECTRUM_BINS];  // filled by the drain task
+static uint16_t spectrumFrame[SPECTRUM_BINS];// copy owned by the UI
+static uint32_t spectrumItems = 0;           // total RMT items received
+static portMUX_TYPE spectrumMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool rmtDrainRunning = false;
+static TaskHandle_t rmtDrainHandle = NULL;
+
+static inline void spectrumAddPulse(uint32_t duration) {
+    if(duration == 0) return;
+    uint32_t bin = (duration / RMT_1US_TICKS) / SPECTRUM_BIN_US;
+    if(bin >= SPECTRUM_BINS) bin = SPECTRUM_BINS - 1;
+    if(spectrumAcc[bin] < UINT16_MAX) spectrumAcc[bin]++;
+}
+
+/***************************************************************************************
+** Function name: rmtDrainTask
+** Description:   empties the RMT ring buffer as fast as it fills, decimating each
+**                batch into spectrumAcc
+***************************************************************************************/
+static void rmtDrainTask(void *pvParameters) {
+    RingbufHandle_t rb = (RingbufHandle_t)pvParameters;
+    while(rmtDrainRunning) {
+        size_t rx_size = 0;
+        rmt_item32_t* item = (rmt_item32_t*)xRingbufferReceive(rb, &rx_size, pdMS_TO_TICKS(50));
+        if (item == nullptr) continue;
+        size_t n = rx_size / sizeof(rmt_item32_t);
+        portENTER_CRITICAL(&spectrumMux);
+        for (size_t i = 0; i < n; i++) {
+            spectrumAddPulse(item[i].duration0);
+            spectrumAddPulse(item[i].duration1);
+        }
+        spectrumItems += n;
+        portEXIT_CRITICAL(&spectrumMux);
+        vRingbufferReturnItem(rb, (void*)item);
+    }
+    rmtDrainHandle = NULL;
+    vTaskDelete(NULL);
+}
+
+/***************************************************************************************
+** Function name: spectrumHeat
+** Description:   maps a bin count to a black->purple->red->yellow colour
+***************************************************************************************/
+static uint16_t spectrumHeat(uint16_t count) {
+    if(count == 0) return TFT_BLACK;
+    if(count < 2)  return TFT_NAVY;
+    if(count < 4)  return TFT_PURPLE;
+    if(count < 8)  return TFT_MAGENTA;
+    if(count < 16) return TFT_RED;
+    if(count < 32) return TFT_ORANGE;
+    return TFT_YELLOW;
+}
+
+/***************************************************************************************
+** Function name: drawSpectrumFrame
+** Description:   scrolls the waterfall one row, paints the new row in spans of equal
+**                colour, redraws the histogram and pushes the sprite once
+***************************************************************************************/
+static void drawSpectrumFrame(TFT_eSprite &spr, uint32_t *hist) {
+    spr.scroll(0, 1);
+
+    int x0 = 0;
+    uint16_t c0 = spectrumHeat(spectrumFrame[0]);
+    for (int x = 1; x <= SPECTRUM_BINS; x++) {
+        uint16_t c = (x < SPECTRUM_BINS) ? spectrumHeat(spectrumFrame[x]) : c0 + 1;
+        if (c != c0) {
+            spr.drawFastHLine(x0, 0, x - x0, c0);
+            x0 = x;
+            c0 = c;
+        }
+    }
+
+    spr.fillRect(0, WATERFALL_HEIGHT, SPECTRUM_BINS, HISTOGRAM_HEIGHT, TFT_BLACK);
+    for (int x = 0; x < SPECTRUM_BINS; x++) {
+        hist[x] = hist[x] - (hist[x] >> 3) + spectrumFrame[x]; // EMA decay, settles at 8x the rate
+        uint32_t level = hist[x] >> 2;
+        int h = level > (uint32_t)HISTOGRAM_HEIGHT ? HISTOGRAM_HEIGHT : level;
+        if (h > 0) spr.drawFastVLine(x, SPECTRUM_HEIGHT - h, h, FGCOLOR);
+    }
+    spr.pushSprite(0, SPECTRUM_TOP);
+}
+
 void rf_spectrum() { //@IncursioHack - https://github.com/IncursioHack ----thanks @aat440hz - RF433ANY-M5Cardputer
 
     tft.fillScreen(TFT_BLACK);
@@ -51,41 +149,451 @@ void rf_spectrum() { //@IncursioHack - https://github.com/IncursioHack ----thank
     pinMode(RfRx, INPUT);
     initRMT();
 
-        RingbufHandle_t rb = nullptr;
-        rmt_get_ringbuf_handle(RMT_RX_CHANNEL, &rb);
+    TFT_eSprite spr = TFT_eSprite(&tft);
+    spr.setColorDepth(8); // halves the RAM used, Stick C Plus has no PSRAM
+    if(spr.createSprite(DISPLAY_WIDTH, SPECTRUM_HEIGHT) == nullptr) {
+        displayError("Not enough memory");
+        rmt_driver_uninstall(RMT_RX_CHANNEL);
+        delay(2000);
+        return;
+    }
+    spr.fillSprite(TFT_BLACK);
+    spr.setScrollRect(0, 0, DISPLAY_WIDTH, WATERFALL_HEIGHT, TFT_BLACK);
+    uint32_t hist[SPECTRUM_BINS] = {0};   // up to 8x a uint16_t frame count
+
+    RingbufHandle_t rb = nullptr;
+    rmt_get_ringbuf_handle(RMT_RX_CHANNEL, &rb);
+    if (rb) {
+        memset(spectrumAcc, 0, sizeof(spectrumAcc));
+        spectrumItems = 0;
+        rmtDrainRunning = true;
+        xTaskCreatePinnedToCore(rmtDrainTask, "RMT drain", 4096, rb, 2, &rmtDrainHandle, 0);
         rmt_rx_start(RMT_RX_CHANNEL, true);
-        while (rb) {
-            size_t rx_size = 0;
-            rmt_item32_t* item = (rmt_item32_t*)xRingbufferReceive(rb, &rx_size, 500);
-            if (item != nullptr) {
-                if (rx_size != 0) {
-                    // Clear the display area
-                    tft.fillRect(0, 20, DISPLAY_WIDTH, DISPLAY_HEIGHT, TFT_BLACK);
-                    // Draw waveform based on signal strength
-                    for (size_t i = 0; i < rx_size; i++) {
-                        int lineHeight = map(item[i].duration0 + item[i].duration1, 0, SIGNAL_STRENGTH_THRESHOLD, 0, DISPLAY_HEIGHT/2);
-                        int lineX = map(i, 0, rx_size - 1, 0, DISPLAY_WIDTH - 1); // Map i to within the display width
-                        // Ensure drawing coordinates stay within the box bounds
-                        int startY = constrain(20 + DISPLAY_HEIGHT / 2 - lineHeight / 2, 20, 20 + DISPLAY_HEIGHT);
-                        int endY = constrain(20 + DISPLAY_HEIGHT / 2 + lineHeight / 2, 20, 20 + DISPLAY_HEIGHT);
-                        tft.drawLine(lineX, startY, lineX, endY, TFT_PURPLE);
-                    }
-                }
-                vRingbufferReturnItem(rb, (void*)item);
-            }
-                    if (checkEscPress()) {
-                    rmt_rx_stop(RMT_RX_CHANNEL);
-                    returnToMenu=true;
-                    break;
-                }
+    }
+
+    unsigned long lastFrame = 0;
+    while (rb) {
+        if (millis() - lastFrame >= SPECTRUM_FRAME_MS) {
+            lastFrame = millis();
+            portENTER_CRITICAL(&spectrumMux);
+            memcpy(spectrumFrame, spectrumAcc, sizeof(spectrumFrame));
+            memset(spectrumAcc, 0, sizeof(spectrumAcc));
+            portEXIT_CRITICAL(&spectrumMux);
+            drawSpectrumFrame(spr, hist);
         }
-            // Checks para sair do while
+
+        if (checkEscPress()) {
+            returnToMenu=true;
+            break;
+        }
+        vTaskDelay(1);
+    }
 
     rmt_rx_stop(RMT_RX_CHANNEL);
+    rmtDrainRunning = false;
+    while (rmtDrainHandle != NULL) delay(5); // waits the drain task to finish
+    log_d("RF spectrum: %u RMT items", spectrumItems);
+    rmt_driver_uninstall(RMT_RX_CHANNEL);
+    spr.deleteSprite();
     delay(10);
+}
+
+
+/***************************************************************************************
+** Pulse recording (.rfp)
+** Receive-only capture of the RMT durations to SD. Fixed fields are little endian.
+**   header : "RFP1" | u32 tick_ns | u32 start_ms
+**   burst  : varint dt_ms (since previous burst) | varint n | u8 first level
+**            n x varint zigzag(duration[i] - duration[i-2])
+**   index  : m x (u32 file offset, u32 time_ms), one entry every rfpIndexStride bursts
+**   footer : u32 index offset | u32 m | u32 bursts | "RFPX"
+** Durations of the same level are close to each other, so the delta against i-2 keeps
+** almost every value in one or two bytes. Decoder/converter: tools/rfp_convert.py
+***************************************************************************************/
+#define RFP_HEADER_SIZE   12
+#define RFP_MAX_INDEX     512
+#define RFP_BURST_MAX     4096  // 2048 bytes of RMT items at most 3 bytes per duration
+#define RFP_WRITE_CHUNK   4096
 
+static RingbufHandle_t rfpOut = NULL;     // encoded bursts waiting to go to the SD
+static uint32_t rfpQueued = 0;            // bytes accepted in rfpOut since the header
+static uint32_t rfpBursts = 0;
+static uint32_t rfpDropped = 0;           // bursts that did not fit in rfpOut
+static uint32_t rfpIndex[RFP_MAX_INDEX][2];
+static uint16_t rfpIndexCount = 0;
+static uint16_t rfpIndexStride = 1;
+static uint32_t rfpStartMs = 0;
 
+static inline size_t rfpPutVarint(uint8_t *buf, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) { buf[n++] = (v & 0x7F) | 0x80; v >>= 7; }
+    buf[n++] = v;
+    return n;
+}
+
+static inline void rfpPut32(uint8_t *buf, uint32_t v) {
+    buf[0] = v; buf[1] = v >> 8; buf[2] = v >> 16; buf[3] = v >> 24;
+}
 
+/***************************************************************************************
+** Function name: rfpIndexAdd
+** Description:   keeps one index entry every rfpIndexStride bursts, when the table is
+**                full every other entry is dropped and the stride doubles
+***************************************************************************************/
+static void rfpIndexAdd(uint32_t offset, uint32_t timeMs) {
+    if (rfpBursts % rfpIndexStride) return;
+    if (rfpIndexCount == RFP_MAX_INDEX) {
+        for (int i = 0; i < RFP_MAX_INDEX / 2; i++) {
+            rfpIndex[i][0] = rfpIndex[2*i][0];
+            rfpIndex[i][1] = rfpIndex[2*i][1];
+        }
+        rfpIndexCount = RFP_MAX_INDEX / 2;
+        rfpIndexStride *= 2;
+        if (rfpBursts % rfpIndexStride) return;
+    }
+    rfpIndex[rfpIndexCount][0] = offset;
+    rfpIndex[rfpIndexCount][1] = timeMs;
+    rfpIndexCount++;
+}
+
+/***************************************************************************************
+** Function name: rfpEncodeTask
+** Description:   drains the RMT ring buffer, encodes each batch as one burst record and
+**                queues it for the writer. Never waits on the SD card.
+***************************************************************************************/
+static void rfpEncodeTask(void *pvParameters) {
+    RingbufHandle_t rb = (RingbufHandle_t)pvParameters;
+    static uint8_t burst[RFP_BURST_MAX];
+    uint32_t lastMs = rfpStartMs;
+    while(rmtDrainRunning) {
+        size_t rx_size = 0;
+        rmt_item32_t* item = (rmt_item32_t*)xRingbufferReceive(rb, &rx_size, pdMS_TO_TICKS(50));
+        if (item == nullptr) continue;
+        uint32_t nowMs = millis();
+        size_t n = rx_size / sizeof(rmt_item32_t);
+
+        // flattens the items, a zero duration ends the frame
+        uint32_t count = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (item[i].duration0 == 0) break;
+            count++;
+            if (item[i].duration1 == 0) break;
+            count++;
+        }
+
+        if (count > 0) {
+            size_t len = rfpPutVarint(burst, nowMs - lastMs);
+            len += rfpPutVarint(burst + len, count);
+            burst[len++] = item[0].level0;
+            int32_t prev[2] = {0, 0};
+            for (uint32_t k = 0; k < count; k++) {
+                int32_t d = (k & 1) ? item[k/2].duration1 : item[k/2].duration0;
+                int32_t delta = d - prev[k & 1];
+                prev[k & 1] = d;
+                len += rfpPutVarint(burst + len, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+            }
+            if (xRingbufferSend(rfpOut, burst, len, 0) == pdTRUE) {
+                rfpIndexAdd(RFP_HEADER_SIZE + rfpQueued, nowMs - rfpStartMs);
+                rfpQueued += len;
+                rfpBursts++;
+                lastMs = nowMs;
+            } else {
+                rfpDropped++;
+            }
+        }
+        vRingbufferReturnItem(rb, (void*)item);
+    }
+    rmtDrainHandle = NULL;
+    vTaskDelete(NULL);
+}
+
+/***************************************************************************************
+** Function name: rfpFlush
+** Description:   moves what is queued in rfpOut to the file, in big chunks
+***************************************************************************************/
+static size_t rfpFlush(File &file, TickType_t wait) {
+    size_t total = 0;
+    size_t size = 0;
+    void *data;
+    while ((data = xRingbufferReceiveUpTo(rfpOut, &size, wait, RFP_WRITE_CHUNK)) != NULL) {
+        total += file.write((uint8_t*)data, size);
+        vRingbufferReturnItem(rfpOut, data);
+        wait = 0;
+    }
+    return total;
+}
+
+void rf_record() {
+    tft.fillScreen(BGCOLOR);
+    tft.setTextSize(1);
+    tft.setTextColor(FGCOLOR, BGCOLOR);
+    tft.println("");
+    tft.println("  RF433 - Record RAW");
+
+    if(!sdcardMounted && !setupSdCard()) {
+        displayError("No SD card");
+        delay(2000);
+        return;
+    }
+
+    String filename = "/rf_0.rfp";
+    for (int c = 1; SD.exists(filename); c++) filename = "/rf_" + String(c) + ".rfp";
+    File file = SD.open(filename, FILE_WRITE);
+    if (!file) {
+        displayError("Can't create file");
+        delay(2000);
+        return;
+    }
+
+    size_t outSize = psramFound() ? 64 * 1024 : 16 * 1024;
+    rfpOut = xRingbufferCreate(outSize, RINGBUF_TYPE_BYTEBUF);
+    if (rfpOut == NULL) {
+        file.close();
+        displayError("Not enough memory");
+        delay(2000);
+        return;
+    }
+
+    rfpStartMs = millis();
+    uint8_t header[RFP_HEADER_SIZE] = {'R', 'F', 'P', '1'};
+    rfpPut32(header + 4, 1000000000UL / (80000000UL / RMT_CLK_DIV));
+    rfpPut32(header + 8, rfpStartMs);
+    file.write(header, RFP_HEADER_SIZE);
+    rfpQueued = rfpBursts = rfpDropped = 0;
+    rfpIndexCount = 0;
+    rfpIndexStride = 1;
+
+    pinMode(RfRx, INPUT);
+    initRMT();
+    RingbufHandle_t rb = nullptr;
+    rmt_get_ringbuf_handle(RMT_RX_CHANNEL, &rb);
+    if (rb == nullptr) {
+        // nothing can be recorded, do not leave a capture with only its header behind
+        rmt_driver_uninstall(RMT_RX_CHANNEL);
+        file.close();
+        SD.remove(filename);
+        vRingbufferDelete(rfpOut);
+        rfpOut = NULL;
+        displayError("RF receiver not available");
+        delay(2000);
+        return;
+    }
+    rmtDrainRunning = true;
+    xTaskCreatePinnedToCore(rfpEncodeTask, "RMT record", 4096, rb, 2, &rmtDrainHandle, 0);
+    rmt_rx_start(RMT_RX_CHANNEL, true);
+
+    unsigned long lastDraw = 0;
+    size_t written = RFP_HEADER_SIZE;
+    tft.println("  File: " + filename);
+    while (true) {
+        written += rfpFlush(file, pdMS_TO_TICKS(20));
+        if (millis() - lastDraw > 500) {
+            lastDraw = millis();
+            tft.setCursor(0, 40);
+            tft.printf("  Time:    %lus       \n", (millis() - rfpStartMs) / 1000);
+            tft.printf("  Bursts:  %u        \n", rfpBursts);
+            tft.printf("  Bytes:   %u        \n", written);
+            tft.printf("  Dropped: %u        \n", rfpDropped);
+            tft.println("\n  Press ESC to stop.");
+        }
+        if (checkEscPress()) {
+            returnToMenu=true;
+            break;
+        }
+    }
+
+    rmt_rx_stop(RMT_RX_CHANNEL);
+    rmtDrainRunning = false;
+    while (rmtDrainHandle != NULL) delay(5);
+    rmt_driver_uninstall(RMT_RX_CHANNEL);
+    written += rfpFlush(file, 0);
+
+    uint8_t buf[16];
+    uint32_t indexOffset = written;
+    for (int i = 0; i < rfpIndexCount; i++) {
+        rfpPut32(buf, rfpIndex[i][0]);
+        rfpPut32(buf + 4, rfpIndex[i][1]);
+        file.write(buf, 8);
+    }
+    rfpPut32(buf, indexOffset);
+    rfpPut32(buf + 4, rfpIndexCount);
+    rfpPut32(buf + 8, rfpBursts);
+    memcpy(buf + 12, "RFPX", 4);
+    file.write(buf, 16);
+    file.close();
+    vRingbufferDelete(rfpOut);
+    rfpOut = NULL;
+
+    log_d("RF record: %u bursts, %u bytes, %u dropped", rfpBursts, written, rfpDropped);
+    displaySuccess(filename + " saved");
+    delay(1500);
+}
+
+
+/***************************************************************************************
+** Decoder view
+** The drain task turns each RMT frame into mark/space pairs and runs the protocol
+** table from rf_decoder.cpp on it. Decoded messages go through a queue to the UI,
+** that keeps the latest RF_DECODED_MAX of them and folds repeats of the same code.
+***************************************************************************************/
+#define RF_DECODED_MAX   32
+#define RF_REPEAT_MS     1000 // same code inside this window counts as a repeat
+
+static QueueHandle_t rfMsgQueue = NULL;
+static RfDecoderStats rfStats;
+
+/***************************************************************************************
+** Function name: rmtToPulses
+** Description:   converts RMT items into mark/space pairs, skipping a leading space
+***************************************************************************************/
+static size_t rmtToPulses(const rmt_item32_t *item, size_t n, RfPulse *out) {
+    size_t count = 0;
+    bool inMark = false;
+    for (size_t i = 0; i < n && count < RF_MAX_PAIRS; i++) {
+        uint32_t dur[2] = {item[i].duration0, item[i].duration1};
+        uint32_t lvl[2] = {item[i].level0, item[i].level1};
+        for (int h = 0; h < 2; h++) {
+            if (dur[h] == 0) goto Done;
+            uint32_t us = dur[h] / RMT_1US_TICKS;
+            if (lvl[h]) {
+                if (inMark) out[count-1].mark = rfPulseAdd(out[count-1].mark, us); // merges two marks in a row
+                else { out[count].mark = rfPulseAdd(0, us); out[count].space = 0; count++; }
+                inMark = true;
+            } else if (count > 0) {
+                out[count-1].space = rfPulseAdd(out[count-1].space, us);
+                inMark = false;
+                if (count == RF_MAX_PAIRS) goto Done;
+            }
+        }
+    }
+    Done:
+    return count;
+}
+
+static void rfDecodeTask(void *pvParameters) {
+    RingbufHandle_t rb = (RingbufHandle_t)pvParameters;
+    static RfPulse pulses[RF_MAX_PAIRS];
+    while(rmtDrainRunning) {
+        size_t rx_size = 0;
+        rmt_item32_t* item = (rmt_item32_t*)xRingbufferReceive(rb, &rx_size, pdMS_TO_TICKS(50));
+        if (item == nullptr) continue;
+        unsigned long t0 = micros();
+        size_t count = rmtToPulses(item, rx_size / sizeof(rmt_item32_t), pulses);
+        vRingbufferReturnItem(rb, (void*)item);
+
+        RfMessage msg;
+        bool ok = rfDecodeFrame(pulses, count, msg);
+        rfStats.frames++;
+        rfStats.pulses += count;
+        rfStats.busyUs += micros() - t0;
+        if (ok) {
+            rfStats.decoded++;
+            msg.timeMs = millis();
+            xQueueSend(rfMsgQueue, &msg, 0);
+        }
+    }
+    rmtDrainHandle = NULL;
+    vTaskDelete(NULL);
+}
+
+/***************************************************************************************
+** Function name: drawDecodedList
+** Description:   newest message on top, index is the highlighted line
+***************************************************************************************/
+#define RF_LIST_LINES 12
+static void drawDecodedList(RfMessage *list, int count, int index) {
+    char line[48];
+    tft.fillRect(0, 20, WIDTH, HEIGHT - 20, BGCOLOR);
+    tft.setTextSize(FP);
+    tft.setCursor(0, 12);
+    tft.setTextColor(TFT_DARKGREY, BGCOLOR);
+    tft.printf("  frames %u  decoded %u  %uus/frame   ", rfStats.frames, rfStats.decoded,
+               rfStats.frames ? rfStats.busyUs / rfStats.frames : 0);
+    int start = index >= RF_LIST_LINES ? index - RF_LIST_LINES + 1 : 0;
+    for (int i = start; i < count && i < start + RF_LIST_LINES; i++) {
+        rfFormatMessage(list[i], line, sizeof(line));
+        tft.setCursor(4, 22 + (i - start) * (LH * FP + 1));
+        tft.setTextColor(i == index ? BGCOLOR : FGCOLOR, i == index ? FGCOLOR : BGCOLOR);
+        tft.printf("%s x%u", line, list[i].repeats);
+    }
+    if (count == 0) {
+        tft.setCursor(4, 22);
+        tft.setTextColor(FGCOLOR, BGCOLOR);
+        tft.print("Waiting for signals...");
+    }
+}
+
+void rf_decode() {
+    tft.fillScreen(BGCOLOR);
+    tft.setTextSize(1);
+    tft.setTextColor(FGCOLOR, BGCOLOR);
+    tft.println("  RF433 - Decoder");
+
+    static RfMessage list[RF_DECODED_MAX];
+    int count = 0;
+    int index = 0;
+    memset(&rfStats, 0, sizeof(rfStats));
+    rfMsgQueue = xQueueCreate(16, sizeof(RfMessage));
+
+    pinMode(RfRx, INPUT);
+    initRMT();
+    RingbufHandle_t rb = nullptr;
+    rmt_get_ringbuf_handle(RMT_RX_CHANNEL, &rb);
+    if (rb && rfMsgQueue) {
+        rmtDrainRunning = true;
+        xTaskCreatePinnedToCore(rfDecodeTask, "RMT decode", 4096, rb, 2, &rmtDrainHandle, 0);
+        rmt_rx_start(RMT_RX_CHANNEL, true);
+    }
+
+    bool redraw = true;
+    unsigned long lastDraw = 0;
+    while (rb && rfMsgQueue) {
+        RfMessage msg;
+        while (xQueueReceive(rfMsgQueue, &msg, 0) == pdTRUE) {
+            if (count > 0 && list[0].protocol == msg.protocol && list[0].data == msg.data
+                && msg.timeMs - list[0].timeMs < RF_REPEAT_MS) {
+                list[0].repeats++;
+                list[0].timeMs = msg.timeMs;
+            } else {
+                if (count < RF_DECODED_MAX) count++;
+                memmove(&list[1], &list[0], (count - 1) * sizeof(RfMessage));
+                list[0] = msg;
+                if (index > 0 && index < count - 1) index++; // keeps the same line selected
+            }
+            redraw = true;
+        }
+
+        if (redraw && millis() - lastDraw > 100) {
+            drawDecodedList(list, count, index);
+            lastDraw = millis();
+            redraw = false;
+        }
+
+        if (checkPrevPress() && count > 0) {
+            index = index > 0 ? index - 1 : count - 1;
+            redraw = true;
+            delay(150);
+        }
+        if (checkNextPress() && count > 0) {
+            index = index < count - 1 ? index + 1 : 0;
+            redraw = true;
+            delay(150);
+        }
+        if (checkEscPress()) {
+            returnToMenu=true;
+            break;
+        }
+        vTaskDelay(1);
+    }
+
+    rmt_rx_stop(RMT_RX_CHANNEL);
+    rmtDrainRunning = false;
+    while (rmtDrainHandle != NULL) delay(5);
+    rmt_driver_uninstall(RMT_RX_CHANNEL);
+    if (rfMsgQueue) vQueueDelete(rfMsgQueue);
+    rfMsgQueue = NULL;
+    log_d("RF decode: %u frames, %u pulses, %u decoded, %u us busy",
+          rfStats.frames, rfStats.pulses, rfStats.decoded, rfStats.busyUs);
 }
 
 
@@ -14,5 +14,7 @@ const int PCA9554RSX_PIN = 4;
 const int PCA9554TRX_PIN = 0;
 
 void rf_spectrum();
+void rf_record();
+void rf_decode();
 void rf_jammerIntermittent();
 void rf_jammerFull();
\ No newline at end of file
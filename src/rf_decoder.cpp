@@ -0,0 +1,107 @@
+#include "rf_decoder.h"
+#include <stdio.h>
+
+/***************************************************************************************
+** Field formatters
+** Layouts follow the rtl_433 device descriptions for the same sensors.
+***************************************************************************************/
+static inline const char *sign(int16_t v) { return v < 0 ? "-" : ""; }
+static inline int16_t absv(int16_t v) { return v < 0 ? -v : v; }
+
+static void formatNexus(const RfMessage &msg, char *out, size_t len) {
+  // id:8 battery:1 0:1 channel:2 temp:12 1111:4 humidity:8
+  uint64_t d = msg.data;
+  int id = (d >> 28) & 0xFF;
+  int channel = ((d >> 24) & 0x3) + 1;
+  int16_t temp = (int16_t)(((d >> 12) & 0xFFF) << 4) >> 4;
+  int hum = d & 0xFF;
+  snprintf(out, len, "Nexus id%d ch%d %s%d.%dC %d%%", id, channel, sign(temp), absv(temp) / 10, absv(temp) % 10, hum);
+}
+
+static void formatPrologue(const RfMessage &msg, char *out, size_t len) {
+  // type:4 id:8 battery:1 button:1 channel:2 temp:12 humidity:8
+  uint64_t d = msg.data;
+  int id = (d >> 24) & 0xFF;
+  int channel = ((d >> 20) & 0x3) + 1;
+  int16_t temp = (int16_t)(((d >> 8) & 0xFFF) << 4) >> 4;
+  int hum = d & 0xFF;
+  snprintf(out, len, "Prologue id%d ch%d %s%d.%dC %d%%", id, channel, sign(temp), absv(temp) / 10, absv(temp) % 10, hum);
+}
+
+static void formatEV1527(const RfMessage &msg, char *out, size_t len) {
+  // address:20 buttons:4
+  snprintf(out, len, "EV1527 %05lX btn %lX", (unsigned long)(msg.data >> 4), (unsigned long)(msg.data & 0xF));
+}
+
+/***************************************************************************************
+** Protocol table
+** Order matters: the first match wins, so narrower timings come first.
+***************************************************************************************/
+const RfProtocol rfProtocols[] = {
+  // name           coding  short  long  tol min max format
+  {"EV1527/PT2262", RF_PWM,   350, 1050, 35, 24, 24, formatEV1527},
+  {"HT6P20B",       RF_PWM,   450,  900, 25, 28, 28, nullptr},
+  {"Doorbell PWM",  RF_PWM,   250,  750, 35, 12, 32, nullptr},
+  {"Nexus-TH",      RF_PPM,  1000, 2000, 25, 36, 36, formatNexus},
+  {"Prologue-TH",   RF_PPM,  2000, 4000, 25, 36, 37, formatPrologue},
+  {"Generic PPM",   RF_PPM,   500, 1000, 30, 16, 64, nullptr},
+};
+const uint8_t rfProtocolCount = sizeof(rfProtocols) / sizeof(rfProtocols[0]);
+
+static inline bool near(uint16_t value, uint16_t nominal, uint8_t tolerance) {
+  uint32_t delta = (uint32_t)nominal * tolerance / 100;
+  return value + delta >= nominal && value <= nominal + delta;
+}
+
+/***************************************************************************************
+** Function name: decodeWith
+** Description:   slices one frame with a protocol timing, fails on the first pulse
+**                that does not fit
+***************************************************************************************/
+static bool decodeWith(const RfProtocol &p, const RfPulse *pulses, size_t count, RfMessage &msg) {
+  uint64_t data = 0;
+  uint8_t bits = 0;
+  for (size_t i = 0; i < count; i++) {
+    const RfPulse &pl = pulses[i];
+    bool last = (i == count - 1) || pl.space == 0;
+    int bit;
+    if (p.coding == RF_PWM) {
+      if (near(pl.mark, p.shortUs, p.tolerance) && (last || near(pl.space, p.longUs, p.tolerance))) bit = 0;
+      else if (near(pl.mark, p.longUs, p.tolerance) && (last || near(pl.space, p.shortUs, p.tolerance))) bit = 1;
+      else return false;
+      // PWM frames end with a sync mark that carries no data
+      if (last && bits == p.maxBits) break;
+    } else {
+      if (last) break; // final mark closes the last space
+      if (pl.mark > p.shortUs) return false;
+      if (near(pl.space, p.shortUs, p.tolerance)) bit = 0;
+      else if (near(pl.space, p.longUs, p.tolerance)) bit = 1;
+      else return false;
+    }
+    if (bits == 64) return false;
+    data = (data << 1) | bit;
+    bits++;
+  }
+  if (bits < p.minBits || bits > p.maxBits) return false;
+  msg.bits = bits;
+  msg.data = data;
+  return true;
+}
+
+bool rfDecodeFrame(const RfPulse *pulses, size_t count, RfMessage &msg) {
+  if (count < 8) return false;
+  for (uint8_t i = 0; i < rfProtocolCount; i++) {
+    if (decodeWith(rfProtocols[i], pulses, count, msg)) {
+      msg.protocol = i;
+      msg.repeats = 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+void rfFormatMessage(const RfMessage &msg, char *out, size_t len) {
+  const RfProtocol &p = rfProtocols[msg.protocol];
+  if (p.format) p.format(msg, out, len);
+  else snprintf(out, len, "%s %ub %llX", p.name, msg.bits, (unsigned long long)msg.data);
+}
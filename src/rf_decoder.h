@@ -0,0 +1,68 @@
+#ifndef RF_DECODER_H
+#define RF_DECODER_H
+
+// Table driven OOK decoder for 433 MHz remotes, doorbells and weather sensors.
+// Plain C++ on purpose (no Arduino headers) so it also builds on a host.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define RF_MAX_PAIRS 128
+
+enum RfCoding : uint8_t {
+  RF_PWM,  // bit is in the mark width:  short mark + long space = 0, long + short = 1
+  RF_PPM,  // fixed mark, bit is in the space width: short space = 0, long space = 1
+};
+
+#define RF_PULSE_MAX 0xFFFF  // longer marks and gaps are clamped, no protocol is near it
+
+struct RfPulse {
+  uint16_t mark;   // us with carrier
+  uint16_t space;  // us without carrier, 0 for the last mark of a frame
+};
+
+// Adds us to a mark or a space, saturating at RF_PULSE_MAX
+static inline uint16_t rfPulseAdd(uint16_t total, uint32_t us) {
+  return us >= (uint32_t)(RF_PULSE_MAX - total) ? RF_PULSE_MAX : total + us;
+}
+
+struct RfMessage;
+typedef void (*RfFormatFn)(const RfMessage &msg, char *out, size_t len);
+
+struct RfProtocol {
+  const char *name;
+  RfCoding coding;
+  uint16_t shortUs;
+  uint16_t longUs;
+  uint8_t  tolerance;  // percent around shortUs/longUs
+  uint8_t  minBits;
+  uint8_t  maxBits;
+  RfFormatFn format;   // writes the decoded fields, nullptr prints the raw code
+};
+
+struct RfMessage {
+  uint8_t  protocol;   // index in rfProtocols
+  uint8_t  bits;
+  uint64_t data;       // first bit received is the most significant
+  uint32_t timeMs;
+  uint16_t repeats;
+};
+
+struct RfDecoderStats {
+  uint32_t frames;
+  uint32_t pulses;
+  uint32_t decoded;
+  uint32_t busyUs;     // time spent inside rfDecodeFrame
+};
+
+extern const RfProtocol rfProtocols[];
+extern const uint8_t rfProtocolCount;
+
+// Tries every protocol of the table against one frame, returns true and fills msg
+// with the first one that matches.
+bool rfDecodeFrame(const RfPulse *pulses, size_t count, RfMessage &msg);
+
+// Human readable line for a decoded message.
+void rfFormatMessage(const RfMessage &msg, char *out, size_t len);
+
+#endif
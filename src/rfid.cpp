@@ -77,8 +77,10 @@ void rfid_loop() {
             }
         }
 
+        mfrc522.PCD_ResetStats();
         if (mfrc522.PICC_IsNewCardPresent()) {
         if (mfrc522.PICC_ReadCardSerial()) {
+        log_d("PICC select: %u I2C transactions, %u bytes", mfrc522.PCD_GetStats().transactions, mfrc522.PCD_GetStats().bytes);
 
 
         switch (currentState) {
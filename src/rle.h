@@ -0,0 +1,82 @@
+#ifndef RLE_H
+#define RLE_H
+
+// Decoder of the 1 bit run length encoded images made by tools/rle_assets.py (assets.h).
+// The painter is templated on the display (tft on the device) so test/test_rle checks
+// it against the source XBM on a host framebuffer.
+
+#include <Arduino.h>
+
+struct RleImage {
+  uint16_t width, height;
+  uint32_t size;           // bytes of data
+  const uint8_t *data;     // runs, see tools/rle_assets.py
+};
+
+#define RLE_LITERAL 2
+
+static inline uint32_t rleVarint(const uint8_t *&p) {
+  uint32_t value = 0;
+  uint8_t shift = 0, b;
+  do {
+    b = pgm_read_byte(p++);
+    value |= (uint32_t)(b & 0x7F) << shift;
+    shift += 7;
+  } while (b & 0x80);
+  return value;
+}
+
+/***************************************************************************************
+** Function name: rleDecode
+** Description:   calls emit(set, n) for each span of equal pixels, in raster order
+***************************************************************************************/
+template <typename Emit>
+void rleDecode(const RleImage &img, Emit emit) {
+  const uint8_t *p = img.data, *end = img.data + img.size;
+  while (p < end) {
+    uint32_t token = rleVarint(p);
+    uint32_t n = token >> 2;
+    if ((token & 3) != RLE_LITERAL) {
+      emit(token & 1, n);
+      continue;
+    }
+    bool bit = false;
+    uint32_t span = 0;
+    for (uint32_t i = 0; i < n; i++) {
+      bool b = pgm_read_byte(p + i / 8) & (1 << (i & 7));
+      if (span && b != bit) { emit(bit, span); span = 0; }
+      bit = b;
+      span++;
+    }
+    if (span) emit(bit, span);
+    p += (n + 7) / 8;
+  }
+}
+
+/***************************************************************************************
+** Function name: rleDraw
+** Description:   opens one window for the image and streams the spans in it, an image
+**                partly off screen is drawn line by line with clipped hlines
+***************************************************************************************/
+template <class Gfx>
+void rleDraw(Gfx &gfx, int x, int y, const RleImage &img, uint16_t color, uint16_t bgcolor) {
+  if (x >= 0 && y >= 0 && x + img.width <= gfx.width() && y + img.height <= gfx.height()) {
+    gfx.startWrite();
+    gfx.setWindow(x, y, x + img.width - 1, y + img.height - 1);
+    rleDecode(img, [&](bool set, uint32_t n) { gfx.pushBlock(set ? color : bgcolor, n); });
+    gfx.endWrite();
+    return;
+  }
+  uint32_t pos = 0;
+  rleDecode(img, [&](bool set, uint32_t n) {
+    while (n) {
+      uint16_t col = pos % img.width;
+      uint32_t span = n < (uint32_t)(img.width - col) ? n : img.width - col;
+      gfx.drawFastHLine(x + col, y + pos / img.width, span, set ? color : bgcolor);
+      pos += span;
+      n -= span;
+    }
+  });
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "scrollback.h"
+#include <ctype.h>
+#include <string.h>
+
+#define SPACE_RUN 0x80  // 0x80 | n stands for n spaces, cells only hold ASCII
+
+Scrollback::Scrollback(uint8_t *buffer, uint32_t bufferSize) {
+  buf = buffer;
+  size = buffer ? bufferSize : 0;
+  clear();
+}
+
+void Scrollback::clear() {
+  head = tail = used = lines = 0;
+  total = 0;
+}
+
+void Scrollback::dropOldest() {
+  uint32_t n = at(tail);
+  tail = (tail + n + 2) % size;
+  used -= n + 2;
+  lines--;
+}
+
+/***************************************************************************************
+** Function name: push
+** Description:   packs a row into a record, evicting old lines until it fits
+***************************************************************************************/
+void Scrollback::push(const TermCell *row, uint8_t cols) {
+  if (size < SCROLLBACK_LINE_MAX + 2) return;
+
+  uint8_t packed[SCROLLBACK_LINE_MAX];
+  uint8_t n = 0;
+  uint8_t end = cols;
+  while (end > 0 && row[end - 1].ch == ' ') end--;
+  for (uint8_t x = 0; x < end;) {
+    uint8_t run = 0;
+    while (x + run < end && row[x + run].ch == ' ' && run < 0x7F) run++;
+    if (run >= 2) {
+      packed[n++] = SPACE_RUN | run;
+      x += run;
+    } else {
+      packed[n++] = row[x].ch & 0x7F;
+      x++;
+    }
+  }
+
+  while (used + n + 2 > size) dropOldest();
+  buf[head] = n;
+  for (uint8_t i = 0; i < n; i++) buf[(head + 1 + i) % size] = packed[i];
+  buf[(head + 1 + n) % size] = n;
+  head = (head + n + 2) % size;
+  used += n + 2;
+  lines++;
+  total++;
+}
+
+uint32_t Scrollback::recordEnd(uint32_t back) const {
+  uint32_t pos = head;
+  for (uint32_t i = 0; i < back; i++) pos = before(pos, at(before(pos, 1)) + 2);
+  return pos;
+}
+
+size_t Scrollback::decode(uint32_t end, char *out, size_t max) const {
+  uint8_t n = at(before(end, 1));
+  uint32_t pos = before(end, n + 1);
+  size_t len = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    uint8_t c = at(pos + i);
+    uint8_t repeat = (c & SPACE_RUN) ? c & 0x7F : 1;
+    char ch = (c & SPACE_RUN) ? ' ' : (char)c;
+    while (repeat-- && len + 1 < max) out[len++] = ch;
+  }
+  if (max) out[len] = '\0';
+  return len;
+}
+
+bool Scrollback::line(uint32_t back, char *out, size_t max) const {
+  if (back >= lines) return false;
+  decode(recordEnd(back), out, max);
+  return true;
+}
+
+uint32_t Scrollback::next(uint32_t pos, char *out, size_t max) const {
+  uint32_t end = (pos + at(pos) + 2) % size;
+  decode(end, out, max);
+  return end;
+}
+
+void Scrollback::searchStart(ScrollbackSearch &s, const char *needle) const {
+  size_t i = 0;
+  for (; needle[i] && i < sizeof(s.needle) - 1; i++) s.needle[i] = tolower((unsigned char)needle[i]);
+  s.needle[i] = '\0';
+  s.back = 0;
+  s.pushedAt = total;
+  s.pos = head;
+  s.active = i > 0;
+}
+
+/***************************************************************************************
+** Function name: searchStep
+** Description:   walks up to budget records from where the last step stopped
+***************************************************************************************/
+int32_t Scrollback::searchStep(ScrollbackSearch &s, uint32_t budget) const {
+  if (!s.active) return -2;
+
+  // lines pushed since the last step moved every back index, records stay in place
+  s.back += total - s.pushedAt;
+  s.pushedAt = total;
+
+  char text[SCROLLBACK_LINE_MAX + 1];
+  while (budget--) {
+    if (s.back >= lines) {
+      s.active = false;
+      return -2;
+    }
+    size_t len = decode(s.pos, text, sizeof(text));
+    for (size_t i = 0; i < len; i++) text[i] = tolower((unsigned char)text[i]);
+    uint32_t found = s.back;
+    s.pos = before(s.pos, at(before(s.pos, 1)) + 2);
+    s.back++;
+    if (strstr(text, s.needle)) return found;
+  }
+  return -1;
+}
@@ -0,0 +1,68 @@
+#ifndef SCROLLBACK_H
+#define SCROLLBACK_H
+
+// Ring of the terminal lines that scrolled off the screen.
+// Lines are stored as text with trailing blanks dropped and runs of spaces packed in
+// one byte, each record is [len][text][len] so the ring can be walked both ways.
+// The oldest lines are dropped when the ring is full. Plain C++ like terminal.h.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "terminal.h"
+
+#define SCROLLBACK_LINE_MAX 255
+
+struct ScrollbackSearch {
+  char     needle[32];   // lower case
+  uint32_t back;         // next line to test, 0 is the newest
+  uint32_t pushedAt;     // pushed() when back was computed
+  uint32_t pos;          // ring offset just after that line's record
+  bool     active;
+};
+
+class Scrollback {
+public:
+  // buffer is owned by the caller
+  Scrollback(uint8_t *buffer, uint32_t size);
+
+  void push(const TermCell *row, uint8_t cols);
+  void clear();
+
+  uint32_t count() const { return lines; }       // lines held
+  uint32_t pushed() const { return total; }      // lines ever pushed, to follow the ring moving
+  uint32_t bytesUsed() const { return used; }
+  uint32_t capacity() const { return size; }
+
+  // Text of a line, back 0 is the newest. Returns false when it is not held anymore.
+  bool line(uint32_t back, char *out, size_t max) const;
+
+  // Walks every line oldest first in one pass, line() costs a walk from the newest:
+  //   uint32_t pos = oldest();
+  //   for (uint32_t i = 0; i < count(); i++) pos = next(pos, text, sizeof(text));
+  // The ring must not be pushed to in between.
+  uint32_t oldest() const { return tail; }
+  uint32_t next(uint32_t pos, char *out, size_t max) const;
+
+  // Incremental case insensitive search towards older lines, tests at most budget
+  // lines per call so it can run between frames. Returns the back index of a match,
+  // -1 while searching, -2 once every line was tested.
+  void searchStart(ScrollbackSearch &s, const char *needle) const;
+  int32_t searchStep(ScrollbackSearch &s, uint32_t budget) const;
+
+private:
+  uint8_t *buf;
+  uint32_t size;
+  uint32_t head;   // where the next record goes
+  uint32_t tail;   // oldest record
+  uint32_t used;
+  uint32_t lines;
+  uint32_t total;
+
+  uint8_t at(uint32_t pos) const { return buf[pos % size]; }
+  uint32_t before(uint32_t pos, uint32_t n) const { return (pos + size - n % size) % size; }
+  uint32_t recordEnd(uint32_t back) const;
+  size_t decode(uint32_t end, char *out, size_t max) const;
+  void dropOldest();
+};
+
+#endif
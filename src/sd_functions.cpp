@@ -2,41 +2,147 @@
 #include "sd_functions.h"
 #include "mykeyboard.h"   // usinf keyboard when calling rename
 #include "display.h"      // using displayRedStripe as error msg
+#include "upnew.h"        // installImage
+#include "ota_sink.h"     // parseSha256
+#include <Update.h>
+#include <esp_ota_ops.h>
+#include <freertos/semphr.h>
+#include <freertos/queue.h>
+#include <rom/crc.h>
 
 SPIClass sdcardSPI;
 String fileToCopy;
 String fileList[MAXFILES][3];
 
 
+StorageStats storageStats;
+static SemaphoreHandle_t sdLock = NULL;
+static uint8_t sdLeases = 0;
+static uint32_t sdCheckedAt = 0;     // last mount attempt or probe
+static bool sdStale = false;         // a probe failed while leases were held, remount once released
+
+static void sdLockTake() {
+  if (sdLock == NULL) sdLock = xSemaphoreCreateRecursiveMutex();
+  xSemaphoreTakeRecursive(sdLock, portMAX_DELAY);
+}
+
+static void sdLockGive() {
+  xSemaphoreGiveRecursive(sdLock);
+}
+
+static uint8_t sdSector[512];
+
+// One sector read, fails once the card was pulled out or swapped
+static bool sdProbe() {
+  storageStats.probes++;
+  return SD.readRAW(sdSector, 0);
+}
+
+// SPI clocks tried at mount, fastest first. Pins going through the GPIO matrix or long
+// traces can make the fast ones fail, the card then answers the probe with a CRC error.
+static const uint32_t sdClocks[] = { 40000000, 20000000, 10000000, 4000000 };
+#define SD_CLOCKS (sizeof(sdClocks) / sizeof(sdClocks[0]))
+static uint8_t sdClockFirst = 0;    // lowered when the same card keeps failing probes
+static bool sdRetried = false;      // the card failed a probe and was remounted at the same clock
+static uint32_t sdCardId = 0;       // size and sector 0 of the mounted card, tells a swap from a glitch
+
 /***************************************************************************************
-** Function name: setupSdCard
-** Description:   Start SD Card
+** Function name: sdMount
+** Description:   mounts at the fastest clock whose sector read works
 ***************************************************************************************/
-bool setupSdCard() {
+static bool sdMount() {
+  uint32_t t = millis();
   sdcardSPI.begin(SDCARD_SCK, SDCARD_MISO, SDCARD_MOSI, SDCARD_CS); // start SPI communications
-  delay(10);
-  if (!SD.begin(SDCARD_CS, sdcardSPI)) { 
-    sdcardSPI.end(); // Closes SPI connections and release pin header.
-    //Serial.println("Failed to mount SDCARD");
-    sdcardMounted = false;
-    return false;
+  for (uint8_t i = sdClockFirst; i < SD_CLOCKS; i++) {
+    if (!SD.begin(SDCARD_CS, sdcardSPI, sdClocks[i])) continue;
+    if (sdProbe()) {
+      storageStats.spiHz = sdClocks[i];
+      storageStats.mounts++;
+      storageStats.mountMs = millis() - t;
+      sdClockFirst = i;
+      uint64_t size = SD.cardSize();
+      sdCardId = crc32_le((uint32_t)size, sdSector, sizeof(sdSector));
+      log_d("SD: mounted at %lu Hz in %lu ms", sdClocks[i], storageStats.mountMs);
+      return true;
+    }
+    SD.end();
   }
-  else {
-    //Serial.println("SDCARD mounted successfully");
-    sdcardMounted = true;
-    return true;
+  sdcardSPI.end(); // Closes SPI connections and release pin header.
+  storageStats.failures++;
+  storageStats.spiHz = 0;
+  sdClockFirst = 0;   // no card, the next one starts from the top again
+  sdRetried = false;
+  return false;
+}
+
+static void sdUnmount() {
+  SD.end();
+  sdcardSPI.end(); // Closes SPI connections and release pins.
+}
+
+/***************************************************************************************
+** Function name: sdRemount
+** Description:   remounts a card that failed its probe, only without leases. The first
+**                failure is taken for a swap or a glitch and retried at the same clock,
+**                the same card failing again there is mounted one clock lower. Another
+**                card starts from the fastest clock.
+***************************************************************************************/
+static void sdRemount() {
+  uint32_t failedId = sdCardId;
+  bool again = sdRetried;
+  if (again && sdClockFirst + 1 < SD_CLOCKS) sdClockFirst++;
+  sdUnmount();
+  sdStale = false;
+  sdcardMounted = sdMount();
+  if (sdcardMounted && sdCardId != failedId && sdClockFirst > 0) {
+    sdUnmount();
+    sdClockFirst = 0;
+    sdcardMounted = sdMount();
   }
+  sdRetried = sdcardMounted && sdCardId == failedId && !again;
+}
+
+/***************************************************************************************
+** Function name: setupSdCard
+** Description:   makes sure the card is mounted. A mounted card is only probed, at most
+**                every SD_CHECK_MS, and remounted when the probe fails (card changed).
+**                While leases are held the remount waits for the last one to go.
+**                A failed mount is not retried before SD_CHECK_MS either.
+***************************************************************************************/
+bool setupSdCard() {
+  sdLockTake();
+  if (sdCheckedAt == 0 || millis() - sdCheckedAt >= SD_CHECK_MS) {
+    sdCheckedAt = millis();
+    if (sdcardMounted && !sdStale && !sdProbe()) {
+      log_d("SD: probe failed at %lu Hz, %u leases", storageStats.spiHz, sdLeases);
+      sdStale = true;
+    }
+    if (sdStale && sdLeases == 0) sdRemount();
+    else if (!sdcardMounted) {
+      sdClockFirst = 0;   // a fresh mount starts from the fastest clock
+      sdRetried = false;
+      sdcardMounted = sdMount();
+    }
+  }
+  bool mounted = sdcardMounted;
+  sdLockGive();
+  return mounted;
 }
 
 /***************************************************************************************
 ** Function name: closeSdCard
-** Description:   Turn Off SDCard, set sdcardMounted state to false
+** Description:   Turn Off SDCard, set sdcardMounted state to false. Refused while a
+**                lease is held, a file of its owner may still be open.
 ***************************************************************************************/
 void closeSdCard() {
-  SD.end();
-  sdcardSPI.end(); // Closes SPI connections and release pins.
-  //Serial.println("SD Card Unmounted...");
-  sdcardMounted = false;
+  sdLockTake();
+  if (sdLeases == 0 && sdcardMounted) {
+    sdUnmount();
+    sdcardMounted = false;
+    sdStale = false;
+    sdCheckedAt = 0;   // the next setupSdCard() is an explicit mount, not throttled
+  }
+  sdLockGive();
 }
 
 /***************************************************************************************
@@ -46,13 +152,44 @@ void closeSdCard() {
 bool ToggleSDCard() {
   if (sdcardMounted == true) {
     closeSdCard();
-    sdcardMounted = false;
-    return false;
+    return sdcardMounted;
   } else {
-      sdcardMounted = setupSdCard();
-      return sdcardMounted;
+    return setupSdCard();
+  }
+}
+
+SdLease::SdLease() {
+  sdLockTake();
+  ok = setupSdCard();
+  if (ok) {
+    sdLeases++;
+    storageStats.leases++;
   }
+  sdLockGive();
+}
+
+SdLease::~SdLease() {
+  if (!ok) return;
+  sdLockTake();
+  if (bytesRead || bytesWritten) log_d("SD: lease read %llu, wrote %llu bytes", bytesRead, bytesWritten);
+  if (--sdLeases == 0 && sdStale) sdRemount();
+  sdLockGive();
+}
+
+void SdLease::countRead(uint64_t n) {
+  sdLockTake();
+  bytesRead += n;
+  storageStats.bytesRead += n;
+  sdLockGive();
+}
+
+void SdLease::countWritten(uint64_t n) {
+  sdLockTake();
+  bytesWritten += n;
+  storageStats.bytesWritten += n;
+  sdLockGive();
 }
+
 /***************************************************************************************
 ** Function name: deleteFromSd
 ** Description:   delete file or folder
@@ -101,123 +238,239 @@ bool renameFile(FS fs, String path, String filename) {
         return false;
     }
 }
+#define COPY_CHUNK     8192   // two of them: the reader task fills one while the other is written
+#define COPY_REDRAW_MS 250
+
+struct CopyChunk {
+  uint8_t  buf;
+  uint16_t len;         // 0 ends the file
+};
+
+struct CopyJob {
+  File *src;
+  uint8_t *buf[2];
+  QueueHandle_t freeQ;  // buffer indexes ready to be filled
+  QueueHandle_t fullQ;  // CopyChunk ready to be written
+  volatile bool abort;  // set by the writer, the reader stops at the next chunk
+  uint64_t total;       // bytes of the whole copy, for the progress
+  uint64_t done;
+  uint32_t start;
+  uint32_t drawn;
+};
+
+static void copyReadTask(void *arg) {
+  CopyJob *job = (CopyJob *)arg;
+  CopyChunk c;
+  while (!job->abort) {
+    xQueueReceive(job->freeQ, &c.buf, portMAX_DELAY);
+    c.len = job->src->read(job->buf[c.buf], COPY_CHUNK);
+    if (c.len == 0) { xQueueSend(job->freeQ, &c.buf, 0); break; }
+    xQueueSend(job->fullQ, &c, portMAX_DELAY);
+  }
+  c.len = 0;
+  xQueueSend(job->fullQ, &c, portMAX_DELAY);
+  vTaskDelete(NULL);
+}
+
+static void copyProgress(CopyJob &job, bool force) {
+  if (!force && millis() - job.drawn < COPY_REDRAW_MS) return;
+  job.drawn = millis();
+  uint32_t ms = job.drawn - job.start;
+  int angle = job.total ? 360 * job.done / job.total : 360;
+  tft.drawArc(WIDTH/2,HEIGHT/2,HEIGHT/4,HEIGHT/5,0,angle,ALCOLOR,BGCOLOR,true);
+  tft.setTextSize(FP);
+  tft.setTextColor(FGCOLOR, BGCOLOR);
+  tft.setCursor(WIDTH/2 - 4*LW, HEIGHT/2 + HEIGHT/4 + 4);
+  tft.printf("%.2f MB/s  ", ms ? job.done / 1000.0 / ms : 0.0);
+}
+
 /***************************************************************************************
-** Function name: copyToFs
-** Description:   copy file from SD or LittleFS to LittleFS or SD
+** Function name: copyData
+** Description:   copies one open file, small files in the calling task, bigger ones
+**                with a reader task so reading and writing overlap
 ***************************************************************************************/
-bool copyToFs(FS from, FS to, String path) {
-  // Tamanho do buffer para leitura/escrita
-  const size_t bufferSize = 2048*2; // Ajuste conforme necessário para otimizar a performance
-  uint8_t buffer[bufferSize];
-  bool result;
-
-  if (!SD.begin()) { result = false; displayError("Error 1"); } 
-  if(!LittleFS.begin()) { result = false; displayError("Error 2"); } 
-  
-  File source = from.open(path, FILE_READ);
-  if (!source) {
-    displayError("Error 3");
-    result = false;
+static const char *copyData(File &src, File &dst, CopyJob &job) {
+  size_t size = src.size();
+  size_t copied = 0;
+  if (size <= COPY_CHUNK) {
+    size_t n = src.read(job.buf[0], COPY_CHUNK);
+    if (dst.write(job.buf[0], n) != n) return "Write failed";
+    copied = n;
+    job.done += n;
+    copyProgress(job, false);
+  } else {
+    job.src = &src;
+    job.abort = false;
+    xTaskCreatePinnedToCore(copyReadTask, "copyRead", 3072, &job, 2, NULL, 0);
+    CopyChunk c;
+    while (xQueueReceive(job.fullQ, &c, portMAX_DELAY) == pdTRUE && c.len) {
+      if (!job.abort) {
+        if (dst.write(job.buf[c.buf], c.len) != c.len) job.abort = true;
+        else copied += c.len;
+      }
+      xQueueSend(job.freeQ, &c.buf, 0);
+      job.done += c.len;
+      copyProgress(job, false);
+    }
+    if (job.abort) return "Write failed";
   }
-  path = path.substring(path.lastIndexOf('/'));
-  if(!path.startsWith("/")) path = "/" + path;
-  File dest = to.open(path, FILE_WRITE);
-  if (!dest) {
-    displayError("Error 4");
-    result = false;
+  return copied == size ? NULL : "Read failed";
+}
+
+static String joinPath(const String &folder, const String &name) {
+  return folder.endsWith("/") ? folder + name : folder + "/" + name;
+}
+
+static uint64_t treeSize(FS &fs, const String &path) {
+  File f = fs.open(path);
+  if (!f) return 0;
+  if (!f.isDirectory()) return f.size();
+  uint64_t size = 0;
+  for (File child = f.openNextFile(); child; child = f.openNextFile()) {
+    String childPath = child.path();
+    bool dir = child.isDirectory();
+    size += dir ? 0 : child.size();
+    child.close();
+    if (dir) size += treeSize(fs, childPath);
   }
-  size_t bytesRead;
-  int tot=source.size();
-  int prog=0;
-  //tft.drawRect(5,HEIGHT-12, (WIDTH-10), 9, FGCOLOR);
-  while ((bytesRead = source.read(buffer, bufferSize)) > 0) {
-    if (dest.write(buffer, bytesRead) != bytesRead) {
-      //Serial.println("Falha ao escrever no arquivo de destino");
-      source.close();
-      dest.close();
-      result = false;
-      displayError("Error 5");
-    } else {
-      prog+=bytesRead;
-      float rad = 360*prog/tot;
-      tft.drawArc(WIDTH/2,HEIGHT/2,HEIGHT/4,HEIGHT/5,0,int(rad),ALCOLOR,BGCOLOR,true);
+  return size;
+}
+
+/***************************************************************************************
+** Function name: copyTree
+** Description:   copies src (a file or a folder with everything in it) to dst
+***************************************************************************************/
+static const char *copyTree(FS &from, FS &to, const String &src, const String &dst, CopyJob &job) {
+  File f = from.open(src);
+  if (!f) return "Cannot open source";
+  const char *error = NULL;
+  if (f.isDirectory()) {
+    if (!to.exists(dst) && !to.mkdir(dst)) error = "Cannot create folder";
+    for (File child = f.openNextFile(); child && !error; child = f.openNextFile()) {
+      String childPath = child.path();
+      child.close();
+      error = copyTree(from, to, childPath, joinPath(dst, childPath.substring(childPath.lastIndexOf('/') + 1)), job);
+    }
+  } else {
+    File out = to.open(dst, FILE_WRITE);
+    if (!out) error = "Cannot create file";
+    else {
+      error = copyData(f, out, job);
+      out.close();
     }
   }
-  if(prog==tot) result = true;
-  else { result = false; displayError("Error 6"); }
-
-  if(!result) delay(5000);
-  return result;
+  f.close();
+  return error;
 }
 
 /***************************************************************************************
-** Function name: copyFile
-** Description:   copy file address to memory
+** Function name: copyPath
+** Description:   copies a file or folder into a folder, of the same or another
+**                filesystem, showing the progress. Errors are shown here.
 ***************************************************************************************/
-bool copyFile(FS fs, String path) {
-  File file = fs.open(path, FILE_READ);
-  if(!file.isDirectory()) {
-    fileToCopy = path;
-    file.close();
-    return true;
+static bool copyPath(FS &from, FS &to, String src, String dstFolder, bool sameFs) {
+  SdLease sd;   // one of the two is usually the card, keep it from being unmounted
+  String dst = joinPath(dstFolder, src.substring(src.lastIndexOf('/') + 1));
+  const char *error = NULL;
+  if (sameFs && (dst == src || dst.startsWith(src + "/"))) error = "Cannot copy into itself";
+
+  CopyJob job = {};
+  job.buf[0] = error ? NULL : (uint8_t *)malloc(2 * COPY_CHUNK);
+  if (!error && !job.buf[0]) error = "Not enough memory";
+  if (!error) {
+    job.buf[1] = job.buf[0] + COPY_CHUNK;
+    job.freeQ = xQueueCreate(2, sizeof(uint8_t));
+    job.fullQ = xQueueCreate(3, sizeof(CopyChunk));
+    for (uint8_t i = 0; i < 2; i++) xQueueSend(job.freeQ, &i, 0);
+    job.total = treeSize(from, src);
+    job.start = millis();
+    copyProgress(job, true);
+    error = copyTree(from, to, src, dst, job);
+    copyProgress(job, true);
+    if (&from == &SD) sd.countRead(job.done);
+    if (&to == &SD) sd.countWritten(job.done);
+    log_d("copy: %llu bytes in %lu ms", job.done, millis() - job.start);
+    vQueueDelete(job.freeQ);
+    vQueueDelete(job.fullQ);
+    free(job.buf[0]);
   }
-  else {
-    displayRedStripe("Cannot copy Folder");
-    file.close();
+
+  if (error) {
+    displayError(error);
+    delay(2000);
     return false;
   }
-  
+  return true;
 }
 
 /***************************************************************************************
-** Function name: pasteFile
-** Description:   paste file to new folder
+** Function name: copyToFs
+** Description:   copy file or folder from SD or LittleFS to the root of LittleFS or SD
 ***************************************************************************************/
-bool pasteFile(FS fs, String path) {
-  // Tamanho do buffer para leitura/escrita
-  const size_t bufferSize = 2048*2; // Ajuste conforme necessário para otimizar a performance
-  uint8_t buffer[bufferSize];
-
-  // Abrir o arquivo original
-  File sourceFile = fs.open(fileToCopy, FILE_READ);
-  if (!sourceFile) {
-    //Serial.println("Falha ao abrir o arquivo original para leitura");
-    return false;
-  }
+bool copyToFs(FS from, FS to, String path) {
+  return copyPath(from, to, path, "/", false);
+}
 
-  // Criar o arquivo de destino
-  File destFile = fs.open(path + "/" + fileToCopy.substring(fileToCopy.lastIndexOf('/') + 1), FILE_WRITE);
-  if (!destFile) {
-    //Serial.println("Falha ao criar o arquivo de destino");
-    sourceFile.close();
-    return false;
+/***************************************************************************************
+** Function name: installFile
+** Description:   flashes a .bin or .bin.gz as firmware (target 0) or as the LittleFS
+**                image (target 1), checked against "<image>.sha256" when there is one:
+**                the digest is of the image written, so fw.bin.gz is checked against
+**                fw.bin.sha256 like fw.bin is, not against a hash of the .gz file
+***************************************************************************************/
+bool installFile(FS fs, String path, int target) {
+  SdLease sd;
+  File file = fs.open(path, FILE_READ);
+  if (!file || file.isDirectory()) { displayError("Error opening file"); delay(2000); return false; }
+  size_t size = file.size();
+
+  uint8_t expected[32];
+  bool verify = false;
+  // the sink hashes what it flashes, the inflated image of a .gz
+  String image = path.endsWith(".gz") ? path.substring(0, path.length() - 3) : path;
+  File shaFile = fs.open(image + ".sha256", FILE_READ);
+  if (shaFile) {
+    verify = parseSha256(shaFile.readStringUntil('\n').c_str(), expected);
+    shaFile.close();
   }
 
-  // Ler dados do arquivo original e escrever no arquivo de destino
-  size_t bytesRead;
-  int tot=sourceFile.size();
-  int prog=0;
-  //tft.drawRect(5,HEIGHT-12, (WIDTH-10), 9, FGCOLOR);
-  while ((bytesRead = sourceFile.read(buffer, bufferSize)) > 0) {
-    if (destFile.write(buffer, bytesRead) != bytesRead) {
-      //Serial.println("Falha ao escrever no arquivo de destino");
-      sourceFile.close();
-      destFile.close();
-      return false;
-    } else {
-      prog+=bytesRead;
-      float rad = 360*prog/tot;
-      tft.drawArc(WIDTH/2,HEIGHT/2,HEIGHT/4,HEIGHT/5,0,int(rad),ALCOLOR,BGCOLOR,true);
-      //tft.fillRect(7,HEIGHT-10, (WIDTH-14)*prog/tot, 5, FGCOLOR);
-    }
+  prog_handler = target;
+  if (target == 1) LittleFS.end();   // the partition is rewritten under it
+  uint32_t start = millis();
+  const char *error = installImage(&file, size, target == 1 ? U_SPIFFS : U_FLASH, verify ? expected : NULL);
+  uint32_t ms = millis() - start;
+  sd.countRead(file.position());
+  file.close();
+  if (target == 1) LittleFS.begin();
+
+  if (error) {
+    displayError(error);
+    delay(3000);
+    return false;
   }
+  displaySuccess(String(size / (ms ? ms : 1)) + " kB/s" + (verify ? ", SHA ok" : ""));
+  delay(2000);
+  if (target == 0) ESP.restart();
+  return true;
+}
 
-  // Fechar ambos os arquivos
-  sourceFile.close();
-  destFile.close();
+/***************************************************************************************
+** Function name: copyFile
+** Description:   copy file or folder address to memory
+***************************************************************************************/
+bool copyFile(FS fs, String path) {
+  fileToCopy = path;
   return true;
 }
 
+/***************************************************************************************
+** Function name: pasteFile
+** Description:   paste the copied file or folder to a folder
+***************************************************************************************/
+bool pasteFile(FS fs, String path) {
+  return copyPath(fs, fs, fileToCopy, path, true);
+}
+
 
 /***************************************************************************************
 ** Function name: createFolder
@@ -382,12 +635,13 @@ String loopSD(FS &fs, bool filePicker) {
   String PreFolder = "/";
   tft.fillScreen(BGCOLOR);
   tft.drawRoundRect(5,5,WIDTH-10,HEIGHT-10,5,FGCOLOR);
-  closeSdCard();
   setupSdCard();
 
   readFs(fs, Folder, fileList);
 
   for(int i=0; i<MAXFILES; i++) if(fileList[i][2]!="") maxFiles++; else break;
+  InputEvent ev;
+  inputFlush();
   while(1){
     if(returnToMenu) break; // stop this loop and retur to the previous loop
 
@@ -402,42 +656,39 @@ String loopSD(FS &fs, bool filePicker) {
       }
       listFiles(index, fileList);
 
-      delay(150);
       redraw = false;
     }
 
-    if(checkPrevPress()) {
+    if(!inputWait(ev, 1000)) continue;
+
+    if(ev.key == IN_PREV && (ev.type == EV_PRESS || ev.type == EV_REPEAT)) {
       if(index==0) index = maxFiles - 1;
       else if(index>0) index--;
       redraw = true;
     }
     /* DW Btn to next item */
-    if(checkNextPress()) { 
+    if(ev.key == IN_NEXT && (ev.type == EV_PRESS || ev.type == EV_REPEAT)) { 
       index++;
       if(index==maxFiles) index = 0;
       redraw = true;
     }
 
-    /* Select to install */
-    if(checkSelPress()) { 
-      delay(200);
-      
-      #if defined(CARDPUTER)
-      Keyboard.update();
-      if(Keyboard.isKeyPressed(KEY_ENTER)) 
-      #else
-      if(digitalRead(SEL_BTN)==LOW) 
-      #endif
+    /* Select: a short press opens, holding it shows the options */
+    if(ev.key == IN_SEL && (ev.type == EV_LONG || (ev.type == EV_RELEASE && ev.heldMs < INPUT_LONG_MS))) { 
+      if(ev.type == EV_LONG)
       {
         // Definição da matriz "Options" 
         if(fileList[index][2]=="folder") {
           options = {
             {"New Folder", [=]() { createFolder(fs, Folder); }},
             {"Rename", [=]() { renameFile(fs, fileList[index][1], fileList[index][0]); }},
-            {"Delete", [=]() { deleteFromSd(fs, fileList[index][1]); }},
-            {"Main Menu", [=]() { backToMenu(); }},
+            {"Copy", [=]() { copyFile(fs, fileList[index][1]); }},
           };
-          delay(200);
+          if(fileToCopy!="") options.push_back({"Paste", [=]() { pasteFile(fs, fileList[index][1]); }});
+          options.push_back({"Delete", [=]() { deleteFromSd(fs, fileList[index][1]); }});
+          if(&fs == &SD) options.push_back({"Copy->LittleFS", [=]() { copyToFs(SD,LittleFS, fileList[index][1]); }});
+          if(&fs == &LittleFS && sdcardMounted) options.push_back({"Copy->SD", [=]() { copyToFs(LittleFS, SD, fileList[index][1]); }});
+          options.push_back({"Main Menu", [=]() { backToMenu(); }});
           loopOptions(options);
           tft.drawRoundRect(5,5,WIDTH-10,HEIGHT-10,5,FGCOLOR);  
           reload = true;     
@@ -450,7 +701,6 @@ String loopSD(FS &fs, bool filePicker) {
           };
           if(fileToCopy!="") options.push_back({"Paste", [=]() { pasteFile(fs, Folder); }});
           options.push_back({"Main Menu", [=]() { backToMenu(); }});
-          delay(200);
           loopOptions(options);
           tft.drawRoundRect(5,5,WIDTH-10,HEIGHT-10,5,FGCOLOR);
           reload = true;  
@@ -470,10 +720,15 @@ String loopSD(FS &fs, bool filePicker) {
           if(fileToCopy!="") options.push_back({"Paste",  [=]() { pasteFile(fs, Folder); }});
           options.push_back({"Delete", [=]() { deleteFromSd(fs, fileList[index][1]); }});
           if(&fs == &SD) options.push_back({"Copy->LittleFS", [=]() { copyToFs(SD,LittleFS, fileList[index][1]); }});
+          if(&fs == &SD && (fileList[index][0].endsWith(".bin") || fileList[index][0].endsWith(".bin.gz"))) {
+            // custom_4Mb.csv has a single app slot, nothing to install into
+            if(esp_ota_get_next_update_partition(NULL) != NULL)
+              options.push_back({"Install", [=]() { installFile(SD, fileList[index][1], 0); }});
+            options.push_back({"Install LittleFS", [=]() { installFile(SD, fileList[index][1], 1); }});
+          }
           if(&fs == &LittleFS && sdcardMounted) options.push_back({"Copy->SD", [=]() { copyToFs(LittleFS, SD, fileList[index][1]); }});
 
           options.push_back({"Main Menu", [=]() { backToMenu(); }});
-          delay(200);
           if(!filePicker) loopOptions(options);
           else { 
             result = fileList[index][1];
@@ -493,7 +748,10 @@ String loopSD(FS &fs, bool filePicker) {
     }
 
     #ifdef CARDPUTER
-      if(checkEscPress()) break;
+      if(ev.key == IN_ESC && ev.type == EV_PRESS) {
+        returnToMenu = true;
+        break;
+      }
     #endif
   }
   return result;
@@ -4,8 +4,45 @@
 #include <SPI.h>
 
 
+#define SD_CHECK_MS 1000     // setupSdCard() probes the card at most this often
+
+// The SD card is mounted by setupSdCard() and stays mounted, there is no need to
+// close it after use. Code keeping files open holds an SdLease, closeSdCard() does
+// nothing while one exists. The SPI clock is the fastest that reads a sector at mount,
+// a card failing a probe later is remounted at the same clock once, then one lower.
+
+struct StorageStats {
+  uint32_t mounts;
+  uint32_t failures;   // mounts that failed
+  uint32_t probes;     // sector reads checking the mounted card is still there
+  uint32_t leases;     // SdLease taken
+  uint32_t mountMs;    // duration of the last mount
+  uint32_t spiHz;      // negotiated at mount, 0 while unmounted
+  uint64_t bytesRead;  // SD bytes counted by the lease holders, all leases together
+  uint64_t bytesWritten;
+};
+
 extern SPIClass sdcardSPI;
-  
+extern StorageStats storageStats;
+
+class SdLease {
+public:
+  SdLease();
+  ~SdLease();
+  operator bool() const { return ok; }
+  // The SD library has no hook to count bytes, the holder counts what it moved through
+  // the lease. The counts go into storageStats as they come, so a lease held until the
+  // restart (the sniffer) shows up there too.
+  void countRead(uint64_t n);
+  void countWritten(uint64_t n);
+  uint64_t bytesRead = 0;
+  uint64_t bytesWritten = 0;
+private:
+  bool ok;
+  SdLease(const SdLease&) = delete;
+  SdLease& operator=(const SdLease&) = delete;
+};
+
 bool setupSdCard();
 
 void closeSdCard();
@@ -20,6 +57,8 @@ bool copyFile(FS fs, String path);
 
 bool copyToFs(FS from, FS to, String path);
 
+bool installFile(FS fs, String path, int target);
+
 bool pasteFile(FS fs, String path);
 
 bool createFolder(FS fs, String path);
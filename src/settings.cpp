@@ -3,14 +3,14 @@
 #include "display.h"  // calling loopOptions(options, true);
 #include "wifi_common.h"
 #include "mykeyboard.h"
-#include <EEPROM.h>
+#include "settings_store.h"
 
 
 
 
 /*********************************************************************
 **  Function: setBrightness
-**  save brightness value into EEPROM
+**  sets the backlight and saves the value in the settings
 **********************************************************************/
 void setBrightness(int bright, bool save) {
   if(bright>100) bright=100;
@@ -22,20 +22,18 @@ void setBrightness(int bright, bool save) {
   axp192.ScreenBreath(bright);
   #endif
 
-  EEPROM.begin(EEPROMSIZE); // open eeprom
-  EEPROM.write(2, bright); //set the byte
-  EEPROM.commit(); // Store data to EEPROM
-  EEPROM.end(); // Free EEPROM memory
+  if(save) {
+    bruceConfig.bright = bright;
+    settingsChanged();
+  }
 }
 
 /*********************************************************************
 **  Function: getBrightness
-**  save brightness value into EEPROM
+**  applies the saved brightness
 **********************************************************************/
 void getBrightness() {
-  EEPROM.begin(EEPROMSIZE);
-  int bright = EEPROM.read(2);
-  EEPROM.end(); // Free EEPROM memory
+  int bright = bruceConfig.bright;
   if(bright>100) {
     bright = 100;
     #if !defined(STICK_C_PLUS)
@@ -57,11 +55,10 @@ void getBrightness() {
 
 /*********************************************************************
 **  Function: gsetRotation
-**  get orientation from EEPROM
+**  get orientation from the settings, or flip it
 **********************************************************************/
 int gsetRotation(bool set){
-  EEPROM.begin(EEPROMSIZE);
-  int getRot = EEPROM.read(0);
+  int getRot = bruceConfig.rotation;
   int result = ROTATION;
 
   if(getRot==1 && set) result = 3;
@@ -75,10 +72,9 @@ int gsetRotation(bool set){
   if(set) {
     rotation = result;
     tft.setRotation(result);
-    EEPROM.write(0, result);    // Left rotation
-    EEPROM.commit();
+    bruceConfig.rotation = result;
+    settingsChanged();
   }
-  EEPROM.end(); // Free EEPROM memory
   returnToMenu=true;
   return result;
 }
@@ -88,17 +84,18 @@ int gsetRotation(bool set){
 **  Function: setBrightnessMenu
 **  Handles Menu to set brightness
 **********************************************************************/
+static void menuBrightness(int bright) { setBrightness(bright); }
+
+static const MenuItem brightnessMenu[] = {
+  {"100%", menuBrightness, 100, NULL},
+  {"75 %", menuBrightness, 75,  NULL},
+  {"50 %", menuBrightness, 50,  NULL},
+  {"25 %", menuBrightness, 25,  NULL},
+  {" 0 %", menuBrightness, 1,   NULL},
+};
+
 void setBrightnessMenu() {
-  options = {
-    {"100%", [=]() { setBrightness(100); }},
-    {"75 %", [=]() { setBrightness(75); }},
-    {"50 %", [=]() { setBrightness(50); }},
-    {"25 %", [=]() { setBrightness(25); }},
-    {" 0 %", [=]() { setBrightness(1); }},
-  };
-  delay(200);
-  loopOptions(options, true);
-  delay(200);
+  loopOptions(brightnessMenu, MENU_COUNT(brightnessMenu), true);
 }
 
 /*********************************************************************
@@ -117,27 +114,27 @@ WiFiUDP ntpUDP;
 NTPClient timeClient(ntpUDP, ntpServer, selectedTimezone, daylightOffset_sec);
 
 
-void setUIColor(){
-    EEPROM.begin(EEPROMSIZE);
-    //int color = EEPROM.read(5);
-
-    options = {
-      {"Default",  [&]() { FGCOLOR=TFT_PURPLE+0x3000;EEPROM.write(5,0);EEPROM.commit(); }},
-      {"White",  [&]() { FGCOLOR=TFT_WHITE; EEPROM.write(5,1);EEPROM.commit(); }},
-      {"Red",   [&]() { FGCOLOR=TFT_RED; EEPROM.write(5,2);EEPROM.commit(); }},
-      {"Green",   [&]() { FGCOLOR=TFT_DARKGREEN; EEPROM.write(5,3);EEPROM.commit(); }},
-      {"Blue",  [&]() { FGCOLOR=TFT_BLUE; EEPROM.write(5,4);EEPROM.commit(); }},
-      {"Yellow",   [&]() { FGCOLOR=TFT_YELLOW; EEPROM.write(5,5);EEPROM.commit(); }},
-      {"Magenta",   [&]() { FGCOLOR=TFT_MAGENTA; EEPROM.write(5,6);EEPROM.commit(); }},
-      {"Orange",   [&]() { FGCOLOR=TFT_ORANGE; EEPROM.write(5,7);EEPROM.commit(); }},
-    };
-    delay(200);
-    loopOptions(options);
-    tft.setTextColor(TFT_BLACK, FGCOLOR);
-    EEPROM.end();
-    }
+static void menuUIColor(int color) {
+  bruceConfig.color = color;
+  settingsChanged();
+  readFGCOLOR();
+}
 
+static const MenuItem uiColorMenu[] = {
+  {"Default", menuUIColor, 0, NULL},
+  {"White",   menuUIColor, 1, NULL},
+  {"Red",     menuUIColor, 2, NULL},
+  {"Green",   menuUIColor, 3, NULL},
+  {"Blue",    menuUIColor, 4, NULL},
+  {"Yellow",  menuUIColor, 5, NULL},
+  {"Magenta", menuUIColor, 6, NULL},
+  {"Orange",  menuUIColor, 7, NULL},
+};
 
+void setUIColor(){
+    loopOptions(uiColorMenu, MENU_COUNT(uiColorMenu));
+    tft.setTextColor(TFT_BLACK, FGCOLOR);
+}
 
 void setClock() {
   bool auto_mode=true;
@@ -166,10 +163,8 @@ void setClock() {
     };
     delay(200);
     loopOptions(options);
-    EEPROM.begin(EEPROMSIZE); // open eeprom
-    EEPROM.write(8, tmz);     // set the byte
-    EEPROM.commit();          // Store data to EEPROM
-    EEPROM.end();             // Free EEPROM memory
+    bruceConfig.tmz = tmz;
+    settingsChanged();
 
     delay(200);
     timeClient.begin();
@@ -314,11 +309,10 @@ void runClockLoop() {
 
 /*********************************************************************
 **  Function: gsetIrTxPin
-**  get or set IR Pin from EEPROM
+**  get or set IR Pin in the settings
 **********************************************************************/
 int gsetIrTxPin(bool set){
-  EEPROM.begin(EEPROMSIZE);
-  int result = EEPROM.read(6);
+  int result = bruceConfig.irTx;
   if(result>50) result = LED;
   if(set) {
     options = {
@@ -333,13 +327,10 @@ int gsetIrTxPin(bool set){
       {"Groove Y", [&]() { result = GROVE_SDA; }},
 
     };
-    delay(200);
     loopOptions(options);
-    delay(200);
-    EEPROM.write(6, result);
-    EEPROM.commit();
+    bruceConfig.irTx = result;
+    settingsChanged();
   }
-  EEPROM.end();
   returnToMenu=true;
   IrTx = result;
   return result;
@@ -347,11 +338,10 @@ int gsetIrTxPin(bool set){
 
 /*********************************************************************
 **  Function: gsetIrRxPin
-**  get or set IR Rx Pin from EEPROM
+**  get or set IR Rx Pin in the settings
 **********************************************************************/
 int gsetIrRxPin(bool set){
-  EEPROM.begin(EEPROMSIZE);
-  int result = EEPROM.read(63);
+  int result = bruceConfig.irRx;
   if(result>36) result = GROVE_SCL;
   if(set) {
     options = {
@@ -365,13 +355,10 @@ int gsetIrRxPin(bool set){
       {"Groove Y", [&]() { result = GROVE_SDA; }},
 
     };
-    delay(200);
     loopOptions(options);
-    delay(200);
-    EEPROM.write(63, result);
-    EEPROM.commit();
+    bruceConfig.irRx = result;
+    settingsChanged();
   }
-  EEPROM.end();
   returnToMenu=true;
   IrRx = result;
   return result;
@@ -379,11 +366,10 @@ int gsetIrRxPin(bool set){
 
 /*********************************************************************
 **  Function: gsetRfTxPin
-**  get or set RF Tx Pin from EEPROM
+**  get or set RF Tx Pin in the settings
 **********************************************************************/
 int gsetRfTxPin(bool set){
-  EEPROM.begin(EEPROMSIZE);
-  int result = EEPROM.read(7);
+  int result = bruceConfig.rfTx;
   if(result>36) result = GROVE_SDA;
   if(set) {
     options = {
@@ -394,24 +380,20 @@ int gsetRfTxPin(bool set){
       {"G0",     [&]() { result=0; }},
     #endif
     };
-    delay(200);
     loopOptions(options);
-    delay(200);
-    EEPROM.write(7, result);    // Left rotation
-    EEPROM.commit();
+    bruceConfig.rfTx = result;
+    settingsChanged();
   }
-  EEPROM.end();
   returnToMenu=true;
   RfTx = result;
   return result;
 }
 /*********************************************************************
 **  Function: gsetRfRxPin
-**  get or set FR Rx Pin from EEPROM
+**  get or set RF Rx Pin in the settings
 **********************************************************************/
 int gsetRfRxPin(bool set){
-  EEPROM.begin(EEPROMSIZE);
-  int result = EEPROM.read(7);
+  int result = bruceConfig.rfRx;
   if(result>36) result = GROVE_SCL;
   if(set) {
     options = {
@@ -422,13 +404,10 @@ int gsetRfRxPin(bool set){
       {"G0",     [&]() { result=0; }},
     #endif
     };
-    delay(200);
     loopOptions(options);
-    delay(200);
-    EEPROM.write(7, result);    // Left rotation
-    EEPROM.commit();
+    bruceConfig.rfRx = result;
+    settingsChanged();
   }
-  EEPROM.end();
   returnToMenu=true;
   RfRx = result;
   return result;
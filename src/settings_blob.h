@@ -0,0 +1,49 @@
+#ifndef SETTINGS_BLOB_H
+#define SETTINGS_BLOB_H
+
+// Layout of the settings blob in NVS and the checks it has to pass on the way back.
+// Kept apart from the writer task in settings_store.cpp, and templated on the store
+// (Preferences on the device), so it also builds and is tested on a host.
+
+#include "settings_store.h"
+#include <rom/crc.h>
+
+#define SETTINGS_KEY "cfg"
+
+struct SettingsBlob {
+  uint16_t version;
+  uint16_t size;       // sizeof(BruceConfig) when it was written
+  uint32_t crc;        // crc32 of cfg
+  BruceConfig cfg;
+};
+
+static inline uint32_t settingsCrc(const BruceConfig &cfg) {
+  return crc32_le(0, (const uint8_t *)&cfg, sizeof(cfg));
+}
+
+// Copies the stored blob into cfg when its length, version, size and CRC all match.
+// Otherwise cfg is left as it was and the caller falls back to its defaults.
+template <class Store>
+bool settingsLoad(Store &store, BruceConfig &cfg) {
+  SettingsBlob blob;
+  if (store.getBytesLength(SETTINGS_KEY) != sizeof(blob)) return false;
+  if (store.getBytes(SETTINGS_KEY, &blob, sizeof(blob)) != sizeof(blob)) return false;
+  if (blob.version != SETTINGS_VERSION || blob.size != sizeof(BruceConfig)) return false;
+  if (blob.crc != settingsCrc(blob.cfg)) return false;
+  cfg = blob.cfg;
+  return true;
+}
+
+// Writes cfg as a new blob, false when the store did not take all of it
+template <class Store>
+bool settingsStore(Store &store, const BruceConfig &cfg) {
+  SettingsBlob blob;
+  memset(&blob, 0, sizeof(blob));  // padding goes to flash too
+  blob.version = SETTINGS_VERSION;
+  blob.size = sizeof(BruceConfig);
+  blob.cfg = cfg;
+  blob.crc = settingsCrc(blob.cfg);
+  return store.putBytes(SETTINGS_KEY, &blob, sizeof(blob)) == sizeof(blob);
+}
+
+#endif
@@ -0,0 +1,123 @@
+#include "settings_store.h"
+#include "settings_blob.h"
+#include "globals.h"
+#include <Preferences.h>
+
+BruceConfig bruceConfig;
+SettingsStats settingsStats;
+
+static Preferences prefs;
+static SemaphoreHandle_t prefsLock = NULL;
+static TaskHandle_t writerTask = NULL;
+static portMUX_TYPE cfgMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool pending = false;
+static BruceConfig written;  // last blob that reached the flash
+
+static void setDefaults(BruceConfig &c) {
+  memset(&c, 0, sizeof(c));
+  c.rotation = ROTATION;
+  c.bright = 100;
+  c.color = 0;
+  c.irTx = LED;
+  c.irRx = GROVE_SCL;
+  c.rfTx = GROVE_SDA;
+  c.rfRx = GROVE_SCL;
+  c.tmz = 0;
+}
+
+/***************************************************************************************
+** Function name: migrateEeprom
+** Description:   reads the values the older firmware kept at fixed EEPROM offsets,
+**                with the same range checks the getters used
+***************************************************************************************/
+static void migrateEeprom(BruceConfig &c) {
+  setDefaults(c);
+  EEPROM.begin(EEPROMSIZE);
+  uint8_t v = EEPROM.read(0);
+  if (v <= 3) c.rotation = v;
+  v = EEPROM.read(2);
+  c.bright = (v == 0 || v > 100) ? 100 : v;
+  v = EEPROM.read(5);
+  if (v <= 7) c.color = v;
+  v = EEPROM.read(6);
+  if (v <= 50) c.irTx = v;
+  v = EEPROM.read(63);
+  if (v <= 36) c.irRx = v;
+  v = EEPROM.read(7);     // RF TX and RX shared this byte
+  if (v <= 36) c.rfTx = c.rfRx = v;
+  v = EEPROM.read(8);
+  if (v <= 8) c.tmz = v;
+  String pwd = EEPROM.readString(10);
+  strncpy(c.wifiPwd, pwd.c_str(), sizeof(c.wifiPwd) - 1);
+  EEPROM.end();
+}
+
+static bool settingsWrite() {
+  BruceConfig cfg;
+  xSemaphoreTake(prefsLock, portMAX_DELAY);
+  portENTER_CRITICAL(&cfgMux);
+  cfg = bruceConfig;
+  pending = false;
+  portEXIT_CRITICAL(&cfgMux);
+  if (memcmp(&cfg, &written, sizeof(written)) == 0) {  // nothing new, or changed back
+    xSemaphoreGive(prefsLock);
+    return true;
+  }
+
+  uint32_t t0 = micros();
+  bool ok = settingsStore(prefs, cfg);
+  uint32_t us = micros() - t0;
+  if (ok) written = cfg;
+  xSemaphoreGive(prefsLock);
+
+  settingsStats.lastWriteUs = us;
+  if (us > settingsStats.maxWriteUs) settingsStats.maxWriteUs = us;
+  if (ok) {
+    settingsStats.writes++;
+  } else {
+    settingsStats.failed++;
+  }
+  log_d("settings: %s in %u us, %u writes for %u changes", ok ? "saved" : "save failed",
+        us, settingsStats.writes, settingsStats.changes);
+  return ok;
+}
+
+static void settingsWriter(void *arg) {
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    // changes made within the window go in the same write
+    while (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SETTINGS_FLUSH_MS)) > 0) {}
+    settingsWrite();
+  }
+}
+
+/***************************************************************************************
+** Function name: settingsBegin
+** Description:   loads the settings blob, checking version, size and CRC
+***************************************************************************************/
+void settingsBegin() {
+  prefsLock = xSemaphoreCreateMutex();
+  prefs.begin("bruce", false);
+
+  if (settingsLoad(prefs, bruceConfig)) {
+    written = bruceConfig;
+  } else {
+    log_d("settings: no valid blob, migrating the EEPROM values");
+    migrateEeprom(bruceConfig);
+    memset(&written, 0xFF, sizeof(written));
+    settingsWrite();
+  }
+  bruceConfig.wifiPwd[sizeof(bruceConfig.wifiPwd) - 1] = '\0';
+
+  xTaskCreatePinnedToCore(settingsWriter, "settings", 3072, NULL, 1, &writerTask, 0);
+}
+
+void settingsChanged() {
+  settingsStats.changes++;
+  pending = true;
+  if (writerTask) xTaskNotifyGive(writerTask);
+}
+
+void settingsFlush() {
+  if (pending) settingsWrite();
+}
@@ -0,0 +1,49 @@
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+// Settings kept in RAM and saved to NVS as one versioned blob with a CRC.
+// Setters change bruceConfig and call settingsChanged(): the write happens in a
+// background task SETTINGS_FLUSH_MS after the last change, so several changes
+// (e.g. scrolling through brightness levels) cost one flash write and the UI
+// never waits for it. NVS writes the new entry before dropping the old one, a
+// power cut mid-write leaves the previous blob readable.
+// The first boot after the update migrates the values from the old EEPROM offsets.
+
+#include <Arduino.h>
+
+#define SETTINGS_VERSION  1
+#define SETTINGS_FLUSH_MS 2000
+
+struct BruceConfig {
+  uint8_t rotation;
+  uint8_t bright;      // 1-100
+  uint8_t color;       // index in the UI color table (setUIColor)
+  uint8_t irTx;
+  uint8_t irRx;
+  uint8_t rfTx;
+  uint8_t rfRx;
+  uint8_t tmz;         // index in the NTP timezone menu (setClock)
+  char    wifiPwd[64];
+};
+
+struct SettingsStats {
+  uint32_t changes;    // settingsChanged() calls
+  uint32_t writes;     // blobs written to flash
+  uint32_t failed;
+  uint32_t lastWriteUs;
+  uint32_t maxWriteUs; // time the writer spent in flash, not seen by the UI
+};
+
+extern BruceConfig bruceConfig;
+extern SettingsStats settingsStats;
+
+// Loads the blob, or migrates/defaults it, and starts the writer task
+void settingsBegin();
+
+// Schedules a write of bruceConfig
+void settingsChanged();
+
+// Writes now if a change is pending, before a restart
+void settingsFlush();
+
+#endif
@@ -42,6 +42,15 @@ unsigned long lastChannelChange = 0;
 int counter = 0;
 int ch = CHANNEL;
 bool fileOpen = false;
+static SdLease *snifferLease = NULL;   // of sniffer_setup(), counts the bytes saved
+static uint32_t snifferCounted = 0;    // bytes of the open file counted on it
+
+// Counts the bytes the capture file grew by since the last save
+static void countSaved() {
+  uint32_t size = file.size();
+  if (snifferLease) snifferLease->countWritten(size - snifferCounted);
+  snifferCounted = size;
+}
 
 //PCAP pcap = PCAP();
 PCAP pcap;
@@ -123,6 +132,7 @@ void openFile2(){
   }
   
   fileOpen = openFile();
+  snifferCounted = 0;
 
   Serial.println("opened: "+filename);
 
@@ -139,13 +149,11 @@ void sniffer_setup() {
   //delay(2000);
   Serial.println();
 
-  sdcardSPI.begin(SDCARD_SCK, SDCARD_MISO, SDCARD_MOSI, SDCARD_CS);
-  delay(10);
-  SD.begin(SDCARD_CS, sdcardSPI);
+  SdLease sd;   // the capture file stays open until the device restarts
   
   uint8_t cardType = SD.cardType();
   
-  if(cardType == CARD_NONE){
+  if(!sd || cardType == CARD_NONE){
       Serial.println("No SD card attached");
       displayRedStripe("No SD card");
       return;
@@ -188,7 +196,9 @@ void sniffer_setup() {
   
   displayRedStripe("Sniffer started!", TFT_WHITE, TFT_DARKGREEN );
  
+  snifferLease = &sd;
   sniffer_loop();
+  snifferLease = NULL;
 
 }
 
@@ -210,6 +220,7 @@ void sniffer_loop() {
 
         if(fileOpen && currentTime - lastTime > 1000){
           file.flush(); //save file
+          countSaved();
           lastTime = currentTime; //update time
           counter++; //add 1 to counter
         }
@@ -217,6 +228,7 @@ void sniffer_loop() {
         /* when counter > 30s interval */
         if(counter > SAVE_INTERVAL){
           //closeFile(); //save & close the file
+          countSaved();
           file.close();
           fileOpen = false; //update flag
           Serial.println("==================");
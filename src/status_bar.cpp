@@ -0,0 +1,94 @@
+#include "status_bar.h"
+#include "display.h"
+#include "wg.h" //for isConnectedWireguard
+
+struct StatusCache {
+  char clock[16];           // what the clock item shows
+  uint8_t links;            // bit 0 WiFi, 1 BLE, 2 WireGuard
+  int battery;              // percent, -1 before the first sample
+  uint32_t clockDue;        // millis() of the next minute
+  bool clockSet;            // clock_set when the clock was read
+  bool dirty[STATUS_ITEMS];
+  bool stale[STATUS_ITEMS]; // read again even if not due
+};
+
+static StatusCache bar = { "", 0, -1, 0, false, { true, true, true }, { true, true, true } };
+
+void statusBarInvalidate() {
+  for (uint8_t i = 0; i < STATUS_ITEMS; i++) bar.dirty[i] = true;
+}
+
+void statusBarRefresh(StatusItem item) {
+  if (item < STATUS_ITEMS) bar.stale[item] = true;
+}
+
+/***************************************************************************************
+** Function name: statusBarUpdate
+** Description:   reads the sources that are due, an item only gets dirty when the
+**                value it shows changed
+***************************************************************************************/
+void statusBarUpdate() {
+  uint32_t now = millis();
+
+  if (bar.stale[STATUS_CLOCK] || clock_set != bar.clockSet || (int32_t)(now - bar.clockDue) >= 0) {
+    char text[sizeof(bar.clock)];
+    if (clock_set) {
+      struct tm t = rtc.getTimeStruct();
+      updateTimeStr(t);
+      snprintf(text, sizeof(text), "%s", timeStr);
+      bar.clockDue = now + (60 - t.tm_sec) * 1000UL;  // next minute tick
+    } else {
+      snprintf(text, sizeof(text), "BRUCE %s", BRUCE_VERSION);
+      bar.clockDue = now + 60000UL;
+    }
+    bar.clockSet = clock_set;
+    bar.stale[STATUS_CLOCK] = false;
+    if (strcmp(text, bar.clock)) {
+      strcpy(bar.clock, text);
+      bar.dirty[STATUS_CLOCK] = true;
+    }
+  }
+
+  if (bar.stale[STATUS_LINKS]) {  // set by statusBarRefresh() where a link comes or goes
+    uint8_t links = (wifiConnected ? 1 : 0) | (BLEConnected ? 2 : 0) | (isConnectedWireguard ? 4 : 0);
+    if (links != bar.links) bar.dirty[STATUS_LINKS] = true;
+    bar.links = links;
+    bar.stale[STATUS_LINKS] = false;
+  }
+
+  int battery = getBattery();  // filtered in the background, reading it costs nothing
+  bar.stale[STATUS_BATTERY] = false;
+  if (battery != bar.battery) {
+    bar.battery = battery;
+    bar.dirty[STATUS_BATTERY] = true;
+  }
+}
+
+/***************************************************************************************
+** Function name: statusBarDraw
+** Description:   repaints the dirty items over their own area only
+***************************************************************************************/
+void statusBarDraw() {
+  if (bar.dirty[STATUS_CLOCK]) {
+    tft.setTextSize(1);
+    tft.setTextColor(FGCOLOR, BGCOLOR);
+    tft.setTextPadding(LW * (sizeof(bar.clock) - 1));  // clears what a longer text left
+    tft.drawString(bar.clock, 12, 12, 1);
+    tft.setTextPadding(0);
+    bar.dirty[STATUS_CLOCK] = false;
+  }
+
+  if (bar.dirty[STATUS_LINKS]) {
+    tft.fillRect(WIDTH - 132, 7, 59, 17, BGCOLOR);
+    int i = 0;
+    if (bar.links & 1) { drawWifiSmall(WIDTH - 90, 7); i++; }                  //Draw Wifi Symbol beside battery
+    if (bar.links & 2) { drawBLESmall(WIDTH - (90 + 20*i), 7); i++; }          //Draw BLE beside Wifi
+    if (bar.links & 4) { drawWireguardStatus(WIDTH - (90 + 21*i), 7); i++; }   //Draw Wg beside BLE
+    bar.dirty[STATUS_LINKS] = false;
+  }
+
+  if (bar.dirty[STATUS_BATTERY] && bar.battery >= 0) {
+    drawBatteryStatus(bar.battery);
+    bar.dirty[STATUS_BATTERY] = false;
+  }
+}
@@ -0,0 +1,31 @@
+#ifndef STATUS_BAR_H
+#define STATUS_BAR_H
+
+// Top bar of the main border: clock (or the version), link icons and battery.
+// Each item caches the value it shows and is only repainted when that value
+// changes. statusBarUpdate() reads the clock once a minute and the battery level
+// published by battery.h on every call. The link flags are only read after the code
+// changing wifiConnected, BLEConnected or isConnectedWireguard called statusBarRefresh().
+
+#include <Arduino.h>
+
+enum StatusItem : uint8_t {
+  STATUS_CLOCK,
+  STATUS_LINKS,    // WiFi, BLE and WireGuard icons, they shift when one goes away
+  STATUS_BATTERY,
+  STATUS_ITEMS
+};
+
+// The bar area was cleared, every item repaints on the next statusBarDraw()
+void statusBarInvalidate();
+
+// Marks one item to be read again on the next statusBarUpdate(), e.g. after a link changed
+void statusBarRefresh(StatusItem item);
+
+// Reads the sources that are due and marks the items whose value changed
+void statusBarUpdate();
+
+// Repaints the dirty items
+void statusBarDraw();
+
+#endif
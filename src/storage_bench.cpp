@@ -0,0 +1,111 @@
+#include "storage_bench.h"
+#include "globals.h"
+#include "display.h"
+#include "input.h"
+#include "sd_functions.h"
+
+static const uint16_t benchBlocks[] = { 512, 4096, 16384 };
+
+enum BenchTest : uint8_t { SEQ_WRITE, SEQ_READ, RAND_WRITE, RAND_READ, BENCH_TESTS };
+static const char *benchNames[BENCH_TESTS] = { "seq_write", "seq_read", "rand_write", "rand_read" };
+
+// kB/s of bytes moved in us
+static uint32_t benchRate(uint32_t bytes, uint32_t us) {
+  return us ? (uint64_t)bytes * 1000000 / 1024 / us : 0;
+}
+
+/***************************************************************************************
+** Function name: benchRun
+** Description:   one test on a file of size bytes, the sequential write makes the file
+**                the others use. Returns kB/s, 0 if the file could not be used. The
+**                bytes moved on the card are counted on its lease.
+***************************************************************************************/
+static uint32_t benchRun(FS &fs, uint8_t test, uint32_t size, uint16_t block, uint8_t *buf, SdLease *sd) {
+  const char *mode = test == SEQ_WRITE ? FILE_WRITE : test == RAND_WRITE ? "r+" : FILE_READ;
+  File f = fs.open(BENCH_FILE, mode);
+  if (!f) return 0;
+  uint32_t bytes = 0;
+  uint32_t start = micros();
+  if (test == SEQ_WRITE) {
+    while (bytes < size && f.write(buf, block) == block) bytes += block;
+  } else if (test == SEQ_READ) {
+    size_t n;
+    while ((n = f.read(buf, block)) > 0) bytes += n;
+  } else {
+    for (uint16_t i = 0; i < BENCH_RANDOM_OPS; i++) {
+      if (!f.seek((uint32_t)random(size / block) * block)) break;
+      size_t n = test == RAND_WRITE ? f.write(buf, block) : f.read(buf, block);
+      if (n != block) break;
+      bytes += n;
+    }
+  }
+  f.close();   // flushes, part of the write time
+  uint32_t us = micros() - start;
+  if (sd && (test == SEQ_WRITE || test == RAND_WRITE)) sd->countWritten(bytes);
+  else if (sd) sd->countRead(bytes);
+  return benchRate(bytes, us);
+}
+
+/***************************************************************************************
+** Function name: benchFs
+** Description:   every test at every block size, a line per block size on screen
+***************************************************************************************/
+static void benchFs(FS &fs, const char *name, uint32_t size, uint8_t *buf, File &csv, SdLease *sd) {
+  for (uint8_t b = 0; b < sizeof(benchBlocks) / sizeof(benchBlocks[0]); b++) {
+    uint16_t block = benchBlocks[b];
+    uint32_t rate[BENCH_TESTS];
+    for (uint8_t t = 0; t < BENCH_TESTS; t++) {
+      rate[t] = benchRun(fs, t, size, block, buf, sd);
+      String row = String(name) + "," + benchNames[t] + "," + block + "," + rate[t] + "," +
+                   (&fs == &SD ? storageStats.spiHz : 0);
+      Serial.println(row);
+      if (csv) csv.println(row);
+    }
+    tft.printf("%-3s%5u w%-5u r%-5u rw%-4u rr%u\n", name, block, (unsigned)rate[SEQ_WRITE],
+               (unsigned)rate[SEQ_READ], (unsigned)rate[RAND_WRITE], (unsigned)rate[RAND_READ]);
+    tft.setCursor(10, tft.getCursorY());
+  }
+  fs.remove(BENCH_FILE);
+}
+
+/***************************************************************************************
+** Function name: storageBenchmark
+** Description:   Others menu screen, results in kB/s
+***************************************************************************************/
+void storageBenchmark() {
+  uint8_t *buf = (uint8_t *)malloc(benchBlocks[sizeof(benchBlocks) / sizeof(benchBlocks[0]) - 1]);
+  if (!buf) { displayError("Not enough memory"); delay(2000); return; }
+  for (uint16_t i = 0; i < benchBlocks[sizeof(benchBlocks) / sizeof(benchBlocks[0]) - 1]; i++) buf[i] = i;
+
+  drawMainBorder();
+  tft.setTextSize(FP);
+  tft.setTextColor(FGCOLOR, BGCOLOR);
+  tft.setCursor(10, 30);
+  tft.println("kB/s  w/r seq, rw/rr random");
+  tft.setCursor(10, tft.getCursorY());
+
+  SdLease sd;
+  File csv;
+  if (sd) {
+    bool header = !SD.exists(BENCH_CSV);
+    csv = SD.open(BENCH_CSV, FILE_APPEND);
+    if (csv && header) csv.println("fs,test,block,kBps,spi_hz");
+    Serial.println("fs,test,block,kBps,spi_hz");
+    benchFs(SD, "SD", BENCH_SD_BYTES, buf, csv, &sd);
+  } else {
+    tft.println("No SD card");
+    tft.setCursor(10, tft.getCursorY());
+  }
+
+  uint32_t lfsFree = LittleFS.totalBytes() - LittleFS.usedBytes();
+  uint32_t lfsSize = BENCH_LFS_BYTES;
+  while (lfsSize > 16384 && lfsSize * 2 > lfsFree) lfsSize /= 2;   // leave room for the files
+  benchFs(LittleFS, "LFS", lfsSize, buf, csv, NULL);
+
+  if (csv) csv.close();
+  free(buf);
+
+  InputEvent ev;
+  inputFlush();
+  while (!inputWait(ev, 1000) || ev.type != EV_PRESS) {}
+}
@@ -0,0 +1,15 @@
+#ifndef STORAGE_BENCH_H
+#define STORAGE_BENCH_H
+
+// Sequential and random read/write speed of the SD card and LittleFS at a few block
+// sizes. Results are shown, printed on Serial and appended to BENCH_CSV on the card.
+
+#define BENCH_FILE       "/bench.tmp"
+#define BENCH_CSV        "/bruce_bench.csv"
+#define BENCH_SD_BYTES   (1024 * 1024)
+#define BENCH_LFS_BYTES  (128 * 1024)
+#define BENCH_RANDOM_OPS 64
+
+void storageBenchmark();
+
+#endif
@@ -0,0 +1,113 @@
+#include "telnet.h"
+#include <lwip/sockets.h>
+#include <errno.h>
+#include <string.h>
+
+static void telnetReply(TelnetParser &tn, const uint8_t *data, uint8_t len) {
+  if (tn.replyLen + len > sizeof(tn.reply)) return;
+  memcpy(tn.reply + tn.replyLen, data, len);
+  tn.replyLen += len;
+}
+
+/***************************************************************************************
+** Function name: telnetOption
+** Description:   answers one WILL/WONT/DO/DONT: the server may echo and suppress go
+**                ahead, we send our terminal type and window size, refuse the rest
+***************************************************************************************/
+static void telnetOption(TelnetParser &tn, uint8_t verb, uint8_t option) {
+  uint8_t answer[3] = { TN_IAC, 0, option };
+  if (verb == TN_WILL) answer[1] = (option == TN_ECHO || option == TN_SGA) ? TN_DO : TN_DONT;
+  else if (verb == TN_DO) answer[1] = (option == TN_TTYPE || option == TN_NAWS) ? TN_WILL : TN_WONT;
+  else return; // WONT and DONT need no answer
+  telnetReply(tn, answer, 3);
+
+  if (verb == TN_DO && option == TN_NAWS) {
+    // RFC 1073: width and height as 16 bit values, a 255 byte among them is doubled
+    uint8_t naws[11] = { TN_IAC, TN_SB, TN_NAWS };
+    uint8_t n = 3;
+    const uint8_t size[4] = { 0, tn.cols, 0, tn.rows };
+    for (uint8_t b : size) {
+      naws[n++] = b;
+      if (b == TN_IAC) naws[n++] = TN_IAC;
+    }
+    naws[n++] = TN_IAC;
+    naws[n++] = TN_SE;
+    telnetReply(tn, naws, n);
+  }
+}
+
+/***************************************************************************************
+** Function name: telnetFilter
+** Description:   removes the IAC sequences from a received block in place, queues the
+**                answers in tn.reply and returns the number of data bytes left
+***************************************************************************************/
+size_t telnetFilter(TelnetParser &tn, uint8_t *data, size_t len) {
+  size_t out = 0;
+  for (size_t i = 0; i < len; i++) {
+    uint8_t c = data[i];
+    switch (tn.state) {
+      case 0:
+        if (c == TN_IAC) tn.state = 1;
+        else data[out++] = c;
+        break;
+      case 1:
+        if (c == TN_IAC) { data[out++] = c; tn.state = 0; }  // escaped 255
+        else if (c >= TN_WILL) { tn.verb = c; tn.state = 2; }
+        else if (c == TN_SB) { tn.sbLen = 0; tn.state = 3; }
+        else tn.state = 0;  // NOP, GA and the other single byte commands
+        break;
+      case 2:
+        telnetOption(tn, tn.verb, c);
+        tn.state = 0;
+        break;
+      case 3:
+        if (c == TN_IAC) tn.state = 4;
+        else if (tn.sbLen < sizeof(tn.sbData)) tn.sbData[tn.sbLen++] = c;
+        break;
+      case 4:
+        if (c == TN_SE) {
+          // TTYPE SEND (1) is answered with TTYPE IS (0) "VT100"
+          if (tn.sbLen >= 2 && tn.sbData[0] == TN_TTYPE && tn.sbData[1] == 1) {
+            const uint8_t ttype[] = { TN_IAC, TN_SB, TN_TTYPE, 0, 'V', 'T', '1', '0', '0', TN_IAC, TN_SE };
+            telnetReply(tn, ttype, sizeof(ttype));
+          }
+          tn.state = 0;
+        } else {
+          if (tn.sbLen < sizeof(tn.sbData)) tn.sbData[tn.sbLen++] = c;
+          tn.state = 3;
+        }
+        break;
+    }
+  }
+  return out;
+}
+
+/***************************************************************************************
+** Function name: telnetPoll
+** Description:   one frame of the session: wait for data, then read until the socket
+**                would block so output larger than a buffer is not left behind
+***************************************************************************************/
+int telnetPoll(int sock, TelnetParser &tn, Terminal &term, uint32_t timeoutUs) {
+  fd_set readSet;
+  FD_ZERO(&readSet);
+  FD_SET(sock, &readSet);
+  struct timeval timeout = { (time_t)(timeoutUs / 1000000), (suseconds_t)(timeoutUs % 1000000) };
+  if (select(sock + 1, &readSet, NULL, NULL, &timeout) <= 0) return 0;
+
+  uint8_t buffer[1024];
+  int total = 0;
+  int len;
+  while ((len = recv(sock, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+    size_t n = telnetFilter(tn, buffer, len);
+    term.write(buffer, n);
+    if (tn.replyLen) {
+      send(sock, tn.reply, tn.replyLen, 0);
+      tn.replyLen = 0;
+    }
+    tn.rxBytes += len;
+    total += len;
+  }
+  // readable with nothing to read is the server closing the connection
+  if (len == 0 || (len < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) return -1;
+  return total;
+}
@@ -0,0 +1,46 @@
+#ifndef TELNET_H
+#define TELNET_H
+
+// Telnet session plumbing for the Telnet client: strips the IAC commands from the
+// received stream, answers option negotiation and drains the socket into the terminal.
+// Only lwIP's BSD socket calls are used, test/native maps them to the host's.
+
+#include <stdint.h>
+#include <stddef.h>
+#include "terminal.h"
+
+// Telnet protocol bytes (RFC 854) and the options this client negotiates
+#define TN_SE    240
+#define TN_SB    250
+#define TN_WILL  251
+#define TN_WONT  252
+#define TN_DO    253
+#define TN_DONT  254
+#define TN_IAC   255
+#define TN_ECHO  1
+#define TN_SGA   3
+#define TN_TTYPE 24
+#define TN_NAWS  31
+
+struct TelnetParser {
+  uint8_t state;      // 0 data, 1 after IAC, 2 option of WILL/WONT/DO/DONT, 3 subnegotiation, 4 IAC in subnegotiation
+  uint8_t verb;
+  uint8_t sbOption;
+  uint8_t sbLen;
+  uint8_t sbData[8];
+  uint8_t cols, rows;
+  uint8_t reply[64];
+  uint8_t replyLen;
+  uint32_t rxBytes;
+};
+
+// Removes the IAC sequences from a received block in place, queues the answers in
+// tn.reply and returns the number of data bytes left
+size_t telnetFilter(TelnetParser &tn, uint8_t *data, size_t len);
+
+// Waits at most timeoutUs for the socket to become readable, then drains everything
+// it holds through telnetFilter into term and sends the queued answers.
+// Returns the bytes received, 0 on a timeout, -1 once the server closed.
+int telnetPoll(int sock, TelnetParser &tn, Terminal &term, uint32_t timeoutUs);
+
+#endif
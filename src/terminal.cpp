@@ -0,0 +1,356 @@
+#include "terminal.h"
+#include <stdlib.h>
+#include <string.h>
+
+Terminal::Terminal(uint8_t c, uint8_t r) {
+  cols = c ? c : 1;
+  rows = r > TERM_MAX_ROWS ? TERM_MAX_ROWS : (r ? r : 1);
+  cells = (TermCell *)malloc((size_t)cols * rows * sizeof(TermCell));
+  memset(&stats, 0, sizeof(stats));
+  reset();
+}
+
+Terminal::~Terminal() {
+  free(cells);
+}
+
+void Terminal::reset() {
+  pen.ch = ' ';
+  pen.fg = TERM_DEFAULT_FG;
+  pen.bg = TERM_DEFAULT_BG;
+  pen.attr = 0;
+  cx = cy = savedX = savedY = 0;
+  top = 0;
+  bottom = rows - 1;
+  wrapPending = false;
+  showCursor = true;
+  state = GROUND;
+  paramCount = 0;
+  privateMode = false;
+  utf8Left = 0;
+  if (cells) for (uint8_t y = 0; y < rows; y++) clearCells(y, 0, cols - 1);
+  invalidate();
+}
+
+void Terminal::write(const uint8_t *data, size_t len) {
+  if (!cells) return;
+  stats.bytes += len;
+  for (size_t i = 0; i < len; i++) put(data[i]);
+}
+
+void Terminal::write(const char *text) {
+  write((const uint8_t *)text, strlen(text));
+}
+
+uint32_t Terminal::rowMask(uint8_t from, uint8_t to) const {
+  uint32_t upto = to >= 31 ? 0xFFFFFFFFUL : (2UL << to) - 1;
+  return upto & ~((1UL << from) - 1);
+}
+
+uint16_t Terminal::param(uint8_t i, uint16_t def) const {
+  return (i < paramCount && params[i]) ? params[i] : def;
+}
+
+void Terminal::clearCells(uint8_t y, uint8_t x0, uint8_t x1) {
+  TermCell blank = pen;
+  blank.ch = ' ';
+  blank.attr = 0;
+  TermCell *r = cells + (size_t)y * cols;
+  for (uint8_t x = x0; x <= x1 && x < cols; x++) r[x] = blank;
+  touch(y);
+}
+
+void Terminal::moveTo(int x, int y) {
+  if (x < 0) x = 0;
+  if (x >= cols) x = cols - 1;
+  if (y < 0) y = 0;
+  if (y >= rows) y = rows - 1;
+  touch(cy);  // the cursor leaves this row
+  cx = x;
+  cy = y;
+  touch(cy);
+  wrapPending = false;
+}
+
+/***************************************************************************************
+** Function name: scrollUp / scrollDown
+** Description:   shift the rows of a region, blank rows enter on the other side.
+**                n is the raw CSI parameter, clamped to the region height
+***************************************************************************************/
+void Terminal::scrollUp(uint8_t from, uint8_t to, uint16_t n) {
+  if (n > to - from + 1) n = to - from + 1;
+  memmove(cells + (size_t)from * cols, cells + (size_t)(from + n) * cols, (size_t)(to - from + 1 - n) * cols * sizeof(TermCell));
+  for (uint8_t y = to - n + 1; y <= to; y++) clearCells(y, 0, cols - 1);
+  dirty |= rowMask(from, to);
+}
+
+void Terminal::scrollDown(uint8_t from, uint8_t to, uint16_t n) {
+  if (n > to - from + 1) n = to - from + 1;
+  memmove(cells + (size_t)(from + n) * cols, cells + (size_t)from * cols, (size_t)(to - from + 1 - n) * cols * sizeof(TermCell));
+  for (uint8_t y = from; y < from + n; y++) clearCells(y, 0, cols - 1);
+  dirty |= rowMask(from, to);
+}
+
+void Terminal::lineFeed() {
+  if (cy == bottom) {
+    // only output scrolling the whole screen is history, a region (status bars,
+    // editors) or DL/SU just rearrange what is on screen
+    if (top == 0 && bottom == rows - 1) {
+      stats.scrolls++;
+      if (scrollOut) scrollOut(row(0), cols, scrollOutCtx);
+    }
+    scrollUp(top, bottom, 1);
+  }
+  else if (cy < rows - 1) moveTo(cx, cy + 1);
+  wrapPending = false;
+}
+
+void Terminal::reverseLineFeed() {
+  if (cy == top) scrollDown(top, bottom, 1);
+  else if (cy > 0) moveTo(cx, cy - 1);
+}
+
+/***************************************************************************************
+** Function name: put
+** Description:   escape sequence state machine, one byte at a time
+***************************************************************************************/
+void Terminal::put(uint8_t c) {
+  // CAN and SUB abort a sequence, ESC restarts one from any state but OSC
+  if (c == 0x18 || c == 0x1A) { state = GROUND; return; }
+  if (c == 0x1B && state != OSC) { state = ESCAPE; return; }
+
+  switch (state) {
+    case GROUND:
+      if (c < 0x20 || c == 0x7F) control(c);
+      else if (c < 0x80) print(c);
+      else if ((c & 0xE0) == 0xC0) { utf8Left = 1; state = UTF8; }
+      else if ((c & 0xF0) == 0xE0) { utf8Left = 2; state = UTF8; }
+      else if ((c & 0xF8) == 0xF0) { utf8Left = 3; state = UTF8; }
+      else print('?');
+      break;
+
+    case UTF8:
+      // the GLCD font has no glyphs outside ASCII, one placeholder per code point
+      if ((c & 0xC0) != 0x80) { state = GROUND; print('?'); put(c); break; }
+      if (--utf8Left == 0) { state = GROUND; print('?'); }
+      break;
+
+    case ESCAPE:
+      escape(c);
+      break;
+
+    case CSI:
+      if (c >= '0' && c <= '9') {
+        if (paramCount == 0) paramCount = 1;
+        uint16_t &p = params[paramCount - 1];
+        if (p < 10000) p = p * 10 + (c - '0');
+      } else if (c == ';') {
+        if (paramCount == 0) paramCount = 1;
+        if (paramCount < TERM_MAX_PARAMS) params[paramCount++] = 0;
+      } else if (c == '?' || c == '>' || c == '=') {
+        privateMode = true;
+      } else if (c >= 0x40 && c <= 0x7E) {
+        csi(c);
+        state = GROUND;
+      } else if (c < 0x20) {
+        control(c);  // C0 controls are executed inside a sequence
+      }
+      break;
+
+    case OSC:
+      // window title and friends, skipped up to BEL or ST
+      if (c == 0x07) state = GROUND;
+      else if (c == 0x1B) state = OSC_ESC;
+      break;
+
+    case OSC_ESC:
+      state = c == '\\' ? GROUND : OSC;
+      break;
+
+    case CHARSET:
+      state = GROUND;  // ESC ( B and friends, only ASCII is drawn
+      break;
+  }
+}
+
+void Terminal::print(char c) {
+  if (wrapPending) {
+    cx = 0;
+    lineFeed();
+  }
+  TermCell &cell = cells[(size_t)cy * cols + cx];
+  cell = pen;
+  cell.ch = c;
+  touch(cy);
+  if (cx == cols - 1) wrapPending = true;
+  else cx++;
+}
+
+void Terminal::control(uint8_t c) {
+  switch (c) {
+    case '\r': moveTo(0, cy); break;
+    case '\n':
+    case 0x0B:
+    case 0x0C: lineFeed(); break;
+    case '\b': if (cx > 0) moveTo(cx - 1, cy); break;
+    case '\t': moveTo((cx / 8 + 1) * 8, cy); break;
+    default: break;  // BEL, NUL, DEL and the rest are not drawn
+  }
+}
+
+void Terminal::escape(uint8_t c) {
+  state = GROUND;
+  stats.sequences++;
+  switch (c) {
+    case '[':
+      state = CSI;
+      paramCount = 0;
+      privateMode = false;
+      memset(params, 0, sizeof(params));
+      stats.sequences--;  // counted when the final byte arrives
+      break;
+    case ']': state = OSC; break;
+    case '(':
+    case ')': state = CHARSET; break;
+    case '7': savedX = cx; savedY = cy; break;
+    case '8': moveTo(savedX, savedY); break;
+    case 'D': lineFeed(); break;
+    case 'E': moveTo(0, cy); lineFeed(); break;
+    case 'M': reverseLineFeed(); break;
+    case 'c': reset(); break;
+    case '=':
+    case '>': break;  // keypad modes
+    default: stats.unknown++; break;
+  }
+}
+
+/***************************************************************************************
+** Function name: csi
+** Description:   executes a complete ESC [ sequence
+***************************************************************************************/
+void Terminal::csi(uint8_t final) {
+  stats.sequences++;
+  uint16_t n = param(0, 1);
+
+  if (privateMode) {
+    // only cursor visibility matters here, the other DEC modes are accepted and ignored
+    if ((final == 'h' || final == 'l') && param(0, 0) == 25) {
+      showCursor = final == 'h';
+      touch(cy);
+    }
+    return;
+  }
+
+  switch (final) {
+    case 'A': moveTo(cx, cy - n); break;
+    case 'B': moveTo(cx, cy + n); break;
+    case 'C': moveTo(cx + n, cy); break;
+    case 'D': moveTo(cx - n, cy); break;
+    case 'E': moveTo(0, cy + n); break;
+    case 'F': moveTo(0, cy - n); break;
+    case 'G':
+    case '`': moveTo(n - 1, cy); break;
+    case 'd': moveTo(cx, n - 1); break;
+    case 'H':
+    case 'f': moveTo(param(1, 1) - 1, n - 1); break;
+
+    case 'J': {
+      uint16_t mode = param(0, 0);
+      if (mode == 0) {
+        clearCells(cy, cx, cols - 1);
+        for (uint8_t y = cy + 1; y < rows; y++) clearCells(y, 0, cols - 1);
+      } else if (mode == 1) {
+        for (uint8_t y = 0; y < cy; y++) clearCells(y, 0, cols - 1);
+        clearCells(cy, 0, cx);
+      } else {
+        for (uint8_t y = 0; y < rows; y++) clearCells(y, 0, cols - 1);
+      }
+      break;
+    }
+
+    case 'K': {
+      uint16_t mode = param(0, 0);
+      if (mode == 0) clearCells(cy, cx, cols - 1);
+      else if (mode == 1) clearCells(cy, 0, cx);
+      else clearCells(cy, 0, cols - 1);
+      break;
+    }
+
+    case 'L': if (cy >= top && cy <= bottom) scrollDown(cy, bottom, n); break;
+    case 'M': if (cy >= top && cy <= bottom) scrollUp(cy, bottom, n); break;
+
+    case 'P': {  // delete characters
+      TermCell *r = cells + (size_t)cy * cols;
+      if (n > cols - cx) n = cols - cx;
+      memmove(r + cx, r + cx + n, (cols - cx - n) * sizeof(TermCell));
+      clearCells(cy, cols - n, cols - 1);
+      break;
+    }
+
+    case '@': {  // insert blank characters
+      TermCell *r = cells + (size_t)cy * cols;
+      if (n > cols - cx) n = cols - cx;
+      memmove(r + cx + n, r + cx, (cols - cx - n) * sizeof(TermCell));
+      clearCells(cy, cx, cx + n - 1);
+      break;
+    }
+
+    case 'X': clearCells(cy, cx, cx + n - 1 < cols ? cx + n - 1 : cols - 1); break;
+    case 'S': scrollUp(top, bottom, n); break;
+    case 'T': scrollDown(top, bottom, n); break;
+
+    case 'r': {
+      uint16_t t = param(0, 1) - 1;
+      uint16_t b = param(1, rows) - 1;
+      if (b >= rows) b = rows - 1;
+      if (t < b) {
+        top = t;
+        bottom = b;
+        moveTo(0, 0);
+      }
+      break;
+    }
+
+    case 's': savedX = cx; savedY = cy; break;
+    case 'u': moveTo(savedX, savedY); break;
+    case 'm': sgr(); break;
+    case 'h':
+    case 'l':
+    case 'n':  // device status reports would need a reply channel, ignored
+    case 'c':
+    case 't': break;
+    default: stats.unknown++; break;
+  }
+}
+
+/***************************************************************************************
+** Function name: sgr
+** Description:   Select Graphic Rendition, colors and attributes of the pen
+***************************************************************************************/
+void Terminal::sgr() {
+  if (paramCount == 0) paramCount = 1;  // ESC [ m is ESC [ 0 m
+  for (uint8_t i = 0; i < paramCount; i++) {
+    uint16_t p = params[i];
+    if (p == 0) {
+      pen.fg = TERM_DEFAULT_FG;
+      pen.bg = TERM_DEFAULT_BG;
+      pen.attr = 0;
+    }
+    else if (p == 1) pen.attr |= TERM_ATTR_BOLD;
+    else if (p == 4) pen.attr |= TERM_ATTR_UNDER;
+    else if (p == 7) pen.attr |= TERM_ATTR_INVERSE;
+    else if (p == 22) pen.attr &= ~TERM_ATTR_BOLD;
+    else if (p == 24) pen.attr &= ~TERM_ATTR_UNDER;
+    else if (p == 27) pen.attr &= ~TERM_ATTR_INVERSE;
+    else if (p >= 30 && p <= 37) pen.fg = p - 30;
+    else if (p == 39) pen.fg = TERM_DEFAULT_FG;
+    else if (p >= 40 && p <= 47) pen.bg = p - 40;
+    else if (p == 49) pen.bg = TERM_DEFAULT_BG;
+    else if (p >= 90 && p <= 97) pen.fg = p - 90 + 8;
+    else if (p >= 100 && p <= 107) pen.bg = p - 100;
+    else if ((p == 38 || p == 48) && i + 1 < paramCount) {
+      // 256 color and truecolor are reduced to skipping their arguments
+      i += params[i + 1] == 5 ? 2 : 4;
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+// VT100/ANSI terminal engine shared by the SSH and Telnet clients.
+// Keeps a grid of cells and the rows that changed since the last draw, the
+// clients only redraw dirty rows. Plain C++ on purpose (no Arduino headers)
+// so recorded byte streams can be replayed on a host.
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define TERM_MAX_ROWS   32   // dirty rows are tracked in a 32 bit mask
+#define TERM_MAX_PARAMS 8
+
+#define TERM_ATTR_BOLD    0x01
+#define TERM_ATTR_UNDER   0x02
+#define TERM_ATTR_INVERSE 0x04
+
+#define TERM_DEFAULT_FG 7
+#define TERM_DEFAULT_BG 0
+
+struct TermCell {
+  char    ch;
+  uint8_t fg;    // ANSI color 0-15
+  uint8_t bg;    // ANSI color 0-7
+  uint8_t attr;
+};
+
+// Called with the top row when a line feed scrolls the whole screen, before it is overwritten
+typedef void (*TermScrollOutFn)(const TermCell *row, uint8_t cols, void *ctx);
+
+struct TermStats {
+  uint32_t bytes;      // bytes fed to the parser
+  uint32_t sequences;  // escape sequences handled
+  uint32_t unknown;    // escape sequences ignored
+  uint32_t scrolls;    // lines a line feed scrolled off the top of the screen
+};
+
+class Terminal {
+public:
+  Terminal(uint8_t cols, uint8_t rows);
+  ~Terminal();
+
+  bool ok() const { return cells != nullptr; }
+
+  // Feeds bytes received from the host
+  void write(const uint8_t *data, size_t len);
+  void write(const char *text);
+
+  // Clears the screen and resets modes, like ESC c
+  void reset();
+
+  uint8_t width() const { return cols; }
+  uint8_t height() const { return rows; }
+  const TermCell *row(uint8_t y) const { return cells + (size_t)y * cols; }
+
+  uint8_t cursorX() const { return cx < cols ? cx : cols - 1; }
+  uint8_t cursorY() const { return cy; }
+  bool cursorVisible() const { return showCursor; }
+
+  // Rows changed since the last takeDirty(), bit n is row n
+  uint32_t takeDirty() { uint32_t d = dirty; dirty = 0; return d; }
+  void invalidate() { dirty = rowMask(0, rows - 1); }
+
+  const TermStats &getStats() const { return stats; }
+
+  void onScrollOut(TermScrollOutFn fn, void *ctx) { scrollOut = fn; scrollOutCtx = ctx; }
+
+private:
+  enum State : uint8_t { GROUND, ESCAPE, CSI, OSC, OSC_ESC, CHARSET, UTF8 };
+
+  TermCell *cells;
+  uint8_t cols, rows;
+  uint8_t cx, cy;
+  uint8_t savedX, savedY;
+  uint8_t top, bottom;       // scroll region, inclusive
+  bool wrapPending;
+  bool showCursor;
+  TermCell pen;              // attributes of the next printed character
+  uint32_t dirty;
+
+  State state;
+  bool privateMode;
+  uint8_t paramCount;
+  uint16_t params[TERM_MAX_PARAMS];
+  uint8_t utf8Left;
+
+  TermStats stats;
+  TermScrollOutFn scrollOut = nullptr;
+  void *scrollOutCtx = nullptr;
+
+  void put(uint8_t c);
+  void print(char c);
+  void control(uint8_t c);
+  void escape(uint8_t c);
+  void csi(uint8_t final);
+  void sgr();
+
+  uint16_t param(uint8_t i, uint16_t def) const;
+  uint32_t rowMask(uint8_t from, uint8_t to) const;
+  void touch(uint8_t y) { dirty |= 1UL << y; }
+  void moveTo(int x, int y);
+  void lineFeed();
+  void reverseLineFeed();
+  void scrollUp(uint8_t from, uint8_t to, uint16_t n);
+  void scrollDown(uint8_t from, uint8_t to, uint16_t n);
+  void clearCells(uint8_t y, uint8_t x0, uint8_t x1);
+};
+
+#endif
@@ -1,13 +1,24 @@
 #include <WiFiClientSecure.h>
 #include <HTTPClient.h>
 #include <Update.h>
+#include <esp_ota_ops.h>
 #include <TFT_eSPI.h>
-#include "update.h"
+#include <freertos/queue.h>
+#include <Preferences.h>
+#include "upnew.h"
+#include "ota_sink.h"
+#include "display.h"
+
+#define OTA_CHUNK      4096   // two of them: the network task fills one while the other is flashed
+#define OTA_TIMEOUT_MS 10000  // a download that gets no byte for this long is given up
+#define OTA_REDRAW_MS  250    // progress bar repaint period
+#define OTA_RESUMES    3      // times a broken download is resumed with a Range request
 
 extern TFT_eSPI tft;
 
 const char* versionUrl = "https://kript0n007.github.io/bruce_arp_spoofing/version.txt";
 const char* firmwareUrl = "https://kript0n007.github.io/bruce_arp_spoofing/firmware.bin";
+const char* firmwareShaUrl = "https://kript0n007.github.io/bruce_arp_spoofing/firmware.bin.sha256";
 const char* currentVersion = "1.4";
 
 void checkForUpdate();
@@ -52,13 +63,37 @@ void checkForUpdate() {
     tft.setTextSize(1);
 
     showStatusMessage("Checking for firmware version...");
+    // The last answer is kept with its ETag, an unchanged version.txt costs a 304
+    Preferences prefs;
+    prefs.begin("ota", false);
+    String etag = prefs.getString("etag", "");
+    const char* headers[] = { "ETag" };
+
     client.setInsecure();
     http.begin(client, versionUrl);
+    http.collectHeaders(headers, 1);
+    if (etag.length()) http.addHeader("If-None-Match", etag);
     int httpCode = http.GET();
+    if (httpCode == HTTP_CODE_NOT_MODIFIED && prefs.getString("version", "").length() == 0) {
+        // the ETag outlived the version it was stored with, ask for the whole file again
+        http.end();
+        prefs.remove("etag");
+        http.begin(client, versionUrl);
+        http.collectHeaders(headers, 1);
+        httpCode = http.GET();
+    }
 
-    if (httpCode == HTTP_CODE_OK) {
-        String newVersion = http.getString();
-        newVersion.trim();
+    if (httpCode == HTTP_CODE_OK || httpCode == HTTP_CODE_NOT_MODIFIED) {
+        String newVersion;
+        if (httpCode == HTTP_CODE_OK) {
+            newVersion = http.getString();
+            newVersion.trim();
+            prefs.putString("etag", http.header("ETag"));
+            prefs.putString("version", newVersion);
+        } else {
+            newVersion = prefs.getString("version", "");
+        }
+        prefs.end();
 
         Serial.printf("Current version: %s\n", currentVersion);
         Serial.printf("New version: %s\n", newVersion.c_str());
@@ -72,6 +107,7 @@ void checkForUpdate() {
             showStatusMessage("Firmware is up to date.");
         }
     } else {
+        prefs.end();
         char buffer[50];
         sprintf(buffer, "HTTP error code: %d", httpCode);
         showStatusMessage("HTTP request failed.");
@@ -81,6 +117,129 @@ void checkForUpdate() {
     http.end();
 }
 
+struct OtaChunk {
+    uint8_t buf;
+    uint16_t len;     // 0 ends the download
+};
+
+struct OtaJob {
+    Stream* stream;         // HTTP body or SD file
+    size_t total;
+    uint8_t* buf[2];
+    QueueHandle_t freeQ;    // buffer indexes ready to be filled
+    QueueHandle_t fullQ;    // OtaChunk ready to be flashed
+    volatile bool abort;    // set by the writer, the network task stops at the next chunk
+};
+
+// The sink writes to the OTA slot or the LittleFS partition through Update
+class UpdateTarget : public OtaTarget {
+public:
+    bool begin(size_t size, int command) override { return Update.begin(size, command); }
+    size_t write(const uint8_t* data, size_t len) override { return Update.write((uint8_t*)data, len); }
+    bool end() override { return Update.end(true); }
+    void abort() override { Update.abort(); }
+    const char* errorString() override { return Update.errorString(); }
+};
+
+static UpdateTarget updateTarget;
+
+/***************************************************************************************
+** Function name: otaNetTask
+** Description:   reads the firmware into the free buffer, a short chunk means the server
+**                stopped sending for OTA_TIMEOUT_MS, the last chunk sent has len 0
+***************************************************************************************/
+static void otaNetTask(void* arg) {
+    OtaJob* job = (OtaJob*)arg;
+    size_t got = 0;
+    OtaChunk c;
+    while (got < job->total && !job->abort) {
+        xQueueReceive(job->freeQ, &c.buf, portMAX_DELAY);
+        size_t want = job->total - got < OTA_CHUNK ? job->total - got : OTA_CHUNK;
+        c.len = job->stream->readBytes(job->buf[c.buf], want);
+        if (c.len == 0) break;
+        got += c.len;
+        xQueueSend(job->fullQ, &c, portMAX_DELAY);
+        if (c.len < want) break;
+    }
+    c.len = 0;
+    xQueueSend(job->fullQ, &c, portMAX_DELAY);
+    vTaskDelete(NULL);
+}
+
+// The digest published next to the firmware, parsed by parseSha256() (ota_sink.h)
+static bool fetchSha256(uint8_t out[32]) {
+    WiFiClientSecure client;
+    HTTPClient http;
+    client.setInsecure();
+    http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+    http.begin(client, firmwareShaUrl);
+    bool ok = http.GET() == HTTP_CODE_OK && parseSha256(http.getString().c_str(), out);
+    http.end();
+    return ok;
+}
+
+/***************************************************************************************
+** Function name: otaStream
+** Description:   feeds the sink with what the network task downloads, from byte "from"
+**                of the image, returns the bytes received
+***************************************************************************************/
+static size_t otaStream(Stream* stream, size_t from, OtaSink& sink) {
+    OtaJob job;
+    job.stream = stream;
+    job.total = sink.total - from;
+    job.abort = false;
+    job.buf[0] = (uint8_t*)malloc(2 * OTA_CHUNK);
+    if (job.buf[0] == NULL) {
+        sink.error = "Error: Not enough memory.";
+        return 0;
+    }
+    job.buf[1] = job.buf[0] + OTA_CHUNK;
+    job.freeQ = xQueueCreate(2, sizeof(uint8_t));
+    job.fullQ = xQueueCreate(3, sizeof(OtaChunk));
+    for (uint8_t i = 0; i < 2; i++) xQueueSend(job.freeQ, &i, 0);
+
+    stream->setTimeout(OTA_TIMEOUT_MS);
+    xTaskCreatePinnedToCore(otaNetTask, "otaNet", 6144, &job, 2, NULL, 0);
+
+    size_t received = 0;
+    uint32_t drawn = 0;
+    uint32_t start = millis();
+    OtaChunk c;
+    while (xQueueReceive(job.fullQ, &c, portMAX_DELAY) == pdTRUE && c.len) {
+        otaFeed(sink, job.buf[c.buf], c.len);
+        if (sink.error) job.abort = true;
+        received += c.len;
+        xQueueSend(job.freeQ, &c.buf, 0);
+        if (millis() - drawn >= OTA_REDRAW_MS || received == job.total) {
+            drawn = millis();
+            progressHandler(from + received, sink.total);
+        }
+    }
+    log_d("OTA: %u bytes in %lu ms, %u written", received, millis() - start, sink.written);
+
+    vQueueDelete(job.freeQ);
+    vQueueDelete(job.fullQ);
+    free(job.buf[0]);
+    return received;
+}
+
+static void otaBegin(OtaSink& sink, size_t total, int command) {
+    otaSinkBegin(sink, &updateTarget, total, command);
+    progressHandler(0, total);
+}
+
+const char* installImage(Stream* in, size_t size, int command, const uint8_t* expected) {
+    OtaSink sink;
+    otaBegin(sink, size, command);
+    size_t received = otaStream(in, 0, sink);
+    return otaSinkFinish(sink, received, expected);
+}
+
+/***************************************************************************************
+** Function name: performOTA
+** Description:   downloads the image into the other OTA slot, a broken download is
+**                resumed from where it stopped with a Range request
+***************************************************************************************/
 void performOTA() {
     WiFiClientSecure client;
     HTTPClient http;
@@ -92,85 +251,73 @@ void performOTA() {
     tft.println("Performing OTA...");
     tft.setTextSize(1);
 
+    if (esp_ota_get_next_update_partition(NULL) == NULL) {
+        // custom_4Mb.csv has a single app slot
+        showStatusMessage("No OTA slot on this board, flash it over USB.");
+        return;
+    }
+
+    uint8_t expected[32];
+    bool verify = fetchSha256(expected);
+    if (!verify) showStatusMessage("No SHA-256 published, not verified");
+
     showStatusMessage("Checking for firmware update...");
     client.setInsecure();
     http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+    const char* otaHeaders[] = { "Content-Encoding" };
     http.begin(client, firmwareUrl);
+    http.collectHeaders(otaHeaders, 1);
+    http.addHeader("Accept-Encoding", "gzip");
     int httpCode = http.GET();
 
-    if (httpCode == HTTP_CODE_OK) {
-        int contentLength = http.getSize();
-        Serial.printf("Content length: %d\n", contentLength);
-
-        if (contentLength > 0) {
-            bool canBegin = Update.begin(contentLength);
-            Serial.printf("Can begin update: %s\n", canBegin ? "Yes" : "No");
-
-            if (canBegin) {
-                showStatusMessage("Begin OTA update...");
-                WiFiClient * stream = http.getStreamPtr();
-                size_t written = 0;
-                uint8_t buff[128] = { 0 }; // Diminuir o tamanho do buffer para 128 bytes
-                int retryCount = 0;
-                const int maxRetries = 5; // número máximo de tentativas
-
-                while (written < contentLength) {
-                    size_t len = stream->available();
-                    if (len) {
-                        int c = stream->readBytes(buff, ((len > sizeof(buff)) ? sizeof(buff) : len));
-                        written += Update.write(buff, c);
-                        Serial.printf("Written bytes: %d\n", written);
-                        retryCount = 0; // Resetar contador de tentativas após sucesso
-                    } else {
-                        delay(50); // Atraso para evitar travamentos
-                        retryCount++;
-                        if (retryCount > maxRetries) {
-                            showStatusMessage("Error: Too many retries.");
-                            Update.abort();
-                            return;
-                        }
-                    }
-                    // Verificação de memória disponível
-                    showMemoryInfo();
-                    size_t freeHeap = ESP.getFreeHeap();
-                    if (freeHeap < 10000) { // Se a memória livre for menor que 10KB, abortar
-                        showStatusMessage("Error: Not enough memory.");
-                        Update.abort();
-                        return;
-                    }
-                }
-
-                if (written == contentLength) {
-                    showStatusMessage("OTA update completed!");
-                    if (Update.end()) {
-                        showStatusMessage("Update successfully applied, restarting...");
-                        delay(2000);
-                        ESP.restart();
-                    } else {
-                        showStatusMessage("Update failed.");
-                        showStatusMessage(Update.errorString());
-                        // Serial.printf("Update failed: %s\n", Update.errorString().c_str());
-                    }
-                } else {
-                    char buffer[50];
-                    sprintf(buffer, "Written only: %d/%d. Retry?", written, contentLength);
-                    showStatusMessage(buffer);
-                    Serial.printf("Written only: %d/%d. Retry?\n", written, contentLength);
-                }
-            } else {
-                showStatusMessage("Not enough space to begin OTA update");
-            }
-        } else {
-            showStatusMessage("Content length is 0. Aborting update.");
-        }
-    } else {
+    if (httpCode != HTTP_CODE_OK) {
         char buffer[50];
         sprintf(buffer, "HTTP error code: %d", httpCode);
         showStatusMessage("HTTP request failed.");
         showStatusMessage(http.errorToString(httpCode).c_str());
         showStatusMessage(buffer);
+        http.end();
+        return;
+    }
+    int contentLength = http.getSize();
+    Serial.printf("Content length: %d\n", contentLength);
+    if (contentLength <= 0) {
+        showStatusMessage("Content length is 0. Aborting update.");
+        http.end();
+        return;
+    }
+
+    // A Range of a compressed response counts bytes of that one compression, the server
+    // may compress the next response differently. A .gz file sent as is can be resumed.
+    String encoding = http.header("Content-Encoding");
+    bool resumable = encoding.length() == 0 || encoding.equalsIgnoreCase("identity");
+
+    showStatusMessage("Begin OTA update...");
+    OtaSink sink;
+    otaBegin(sink, contentLength, U_FLASH);
+
+    size_t received = otaStream(http.getStreamPtr(), 0, sink);
+    for (int resume = 0; resumable && resume < OTA_RESUMES && received < sink.total && !sink.error; resume++) {
+        http.end();
+        log_d("OTA: resuming at %u", received);
+        http.begin(client, firmwareUrl);
+        http.addHeader("Accept-Encoding", "gzip");
+        http.addHeader("Range", "bytes=" + String(received) + "-");
+        if (http.GET() != HTTP_CODE_PARTIAL_CONTENT) break;   // the server does not do ranges
+        received += otaStream(http.getStreamPtr(), received, sink);
     }
     http.end();
+
+    const char* error = otaSinkFinish(sink, received, verify ? expected : NULL);
+    tft.fillScreen(TFT_BLACK);
+    tft.setCursor(10, 10);
+    if (error) {
+        showStatusMessage(error);
+    } else {
+        showStatusMessage("Update successfully applied, restarting...");
+        delay(2000);
+        ESP.restart();
+    }
 }
 
 void showStatusMessage(const char* message) {
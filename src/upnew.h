@@ -1,7 +1,15 @@
 #ifndef UPDATE_H
 #define UPDATE_H
 
+#include <Arduino.h>
+
 void checkForUpdate();
 void performOTA();
 
+// Writes a raw or gzip image read from in to the OTA slot (U_FLASH) or to the
+// LittleFS partition (U_SPIFFS), checked against the SHA-256 expected when it is
+// not NULL. The digest is of the image as written, inflated when in is gzip.
+// Returns NULL once the image is committed, or why it was discarded.
+const char* installImage(Stream* in, size_t size, int command, const uint8_t* expected);
+
 #endif // UPDATE_H
@@ -3,6 +3,7 @@
 #include "display.h"
 #include "sd_functions.h"
 #include "wifi_common.h"
+#include "status_bar.h"
 
 
 char private_key[45];
@@ -86,11 +87,7 @@ void parse_config_file(File configFile) {
 **  tries to open file wg.conf on local SD 
 **********************************************************************/
 void read_and_parse_file() {
-  sdcardSPI.begin(SDCARD_SCK, SDCARD_MISO, SDCARD_MOSI, SDCARD_CS);
-  delay(10);
-  SD.begin(SDCARD_CS, sdcardSPI);
-
-  if (!SD.begin(SS)) {
+  if (!setupSdCard()) {
     Serial.println("Failed to initialize SD card");
     return;
   }
@@ -163,5 +160,6 @@ void wg_setup()
     Serial.println(local_ip);
     delay(7000);
     isConnectedWireguard = true;
+    statusBarRefresh(STATUS_LINKS);
     tft.fillScreen(BGCOLOR);
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "mykeyboard.h"
 #include "evil_portal.h"
 #include "wifi_common.h"
+#include "status_bar.h"
 
 
 /**
@@ -155,6 +156,7 @@ void target_atk(String tssid,String mac, uint8_t channel) {
     while(!checkSelPress()) { yield(); }
   }
   wifiConnected=true;
+  statusBarRefresh(STATUS_LINKS);
   memcpy(deauth_frame, deauth_frame_default, sizeof(deauth_frame_default));
   wsl_bypasser_send_raw_frame(&ap_record,channel);
 
@@ -444,6 +446,7 @@ void beaconAttack() {
   delay(200);
 
   wifiConnected = true; // display wifi icon
+  statusBarRefresh(STATUS_LINKS);
   drawMainMenu(0);
   displayRedStripe(txt,TFT_WHITE, FGCOLOR);
   while (1) {
@@ -1,7 +1,9 @@
 #include "globals.h"
 #include "wifi_common.h"
+#include "status_bar.h"
 #include "mykeyboard.h"   // usinf keyboard when calling rename
 #include "display.h"      // using displayRedStripe  and loop options
+#include "settings_store.h"
 
 
 /***************************************************************************************
@@ -10,20 +12,17 @@
 ***************************************************************************************/
 bool wifiConnect(String ssid, int encryptation, bool isAP) {
   if(!isAP) {
-    int tmz;
-    EEPROM.begin(EEPROMSIZE);
-    tmz = EEPROM.read(8);        // read timezone
+    int tmz = bruceConfig.tmz;   // timezone
     if(tmz>8) tmz=0;
 
-    pwd = EEPROM.readString(10); //password
+    pwd = bruceConfig.wifiPwd;
 
     delay(200);
     if(encryptation>0) pwd = keyboard(pwd,63, "Network Password:");
 
-    if (pwd!=EEPROM.readString(10)) { //43
-      EEPROM.writeString(10, pwd); //43
-      EEPROM.commit(); // Store data to EEPROM
-      EEPROM.end(); // Free EEPROM memory
+    if (pwd!=bruceConfig.wifiPwd) {
+      strncpy(bruceConfig.wifiPwd, pwd.c_str(), sizeof(bruceConfig.wifiPwd) - 1);
+      settingsChanged();
     }
     
     drawMainBorder();
@@ -47,6 +46,7 @@ bool wifiConnect(String ssid, int encryptation, bool isAP) {
 
     if(WiFi.status() == WL_CONNECTED) { 
       wifiConnected=true;
+      statusBarRefresh(STATUS_LINKS);
       timeClient.begin();
       timeClient.update();
       if(tmz==0) timeClient.setTimeOffset(-3 * 3600);
@@ -74,6 +74,7 @@ bool wifiConnect(String ssid, int encryptation, bool isAP) {
     WiFi.softAP("BruceNet", "",6,0,4,false);
     Serial.print("IP: "); Serial.println(WiFi.softAPIP());
     wifiConnected=true;
+    statusBarRefresh(STATUS_LINKS);
     return true;
   } 
   delay(200);
@@ -91,6 +92,7 @@ void wifiDisconnect() {
   WiFi.disconnect(true,true);  // turn off STA mode
   WiFi.mode(WIFI_OFF);         // enforces WIFI_OFF mode
   wifiConnected=false;
+  statusBarRefresh(STATUS_LINKS);
   returnToMenu=true;
 }
 
@@ -0,0 +1,54 @@
+// Just enough of the Arduino core for the host tests (pio test -e native) to build
+// the modules that only use its types, timing and Serial.
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <chrono>
+#include <thread>
+
+typedef uint8_t byte;
+typedef uint16_t word;
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+class __FlashStringHelper;
+#define F(text) ((const __FlashStringHelper *)(text))
+
+#define DEC 10
+#define HEX 16
+
+inline unsigned long millis() {
+  using namespace std::chrono;
+  static const steady_clock::time_point start = steady_clock::now();
+  return duration_cast<milliseconds>(steady_clock::now() - start).count();
+}
+inline unsigned long micros() {
+  using namespace std::chrono;
+  static const steady_clock::time_point start = steady_clock::now();
+  return duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+// Tests run against simulated hardware, waiting for it is wasted time
+inline void delay(unsigned long) {}
+inline void yield() {}
+
+class HostSerial {
+public:
+  void print(const char *s) { fputs(s, stdout); }
+  void print(const __FlashStringHelper *s) { print((const char *)s); }
+  void print(char c) { putchar(c); }
+  void print(long v, int base = DEC) { printf(base == HEX ? "%lX" : "%ld", v); }
+  void print(unsigned long v, int base = DEC) { printf(base == HEX ? "%lX" : "%lu", v); }
+  void print(int v, int base = DEC) { print((long)v, base); }
+  void print(unsigned v, int base = DEC) { print((unsigned long)v, base); }
+  void print(byte v, int base = DEC) { print((unsigned long)v, base); }
+  template <typename T> void println(T v) { print(v); putchar('\n'); }
+  template <typename T> void println(T v, int base) { print(v, base); putchar('\n'); }
+  void println() { putchar('\n'); }
+};
+inline HostSerial Serial;
+
+#endif
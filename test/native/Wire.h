@@ -0,0 +1,21 @@
+// Stand-in for the Arduino Wire library on the host tests, a bus with nothing on it.
+// Simulated devices are reached through their own transport instead.
+#ifndef NATIVE_WIRE_H
+#define NATIVE_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+  void begin() {}
+  void beginTransmission(uint8_t) {}
+  size_t write(uint8_t) { return 1; }
+  size_t write(const uint8_t *, size_t count) { return count; }
+  uint8_t endTransmission(bool = true) { return 2; }  // address NACK
+  uint8_t requestFrom(uint8_t, uint8_t) { return 0; }
+  int available() { return 0; }
+  int read() { return -1; }
+};
+inline TwoWire Wire;
+
+#endif
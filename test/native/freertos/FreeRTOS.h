@@ -0,0 +1,17 @@
+// Host stand-in for the FreeRTOS basics the tested modules use, one tick is 1 ms
+// like the ESP32 Arduino core's configTICK_RATE_HZ of 1000.
+#ifndef NATIVE_FREERTOS_H
+#define NATIVE_FREERTOS_H
+
+#include <stdint.h>
+
+typedef int32_t  BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  pdTRUE
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+#endif
@@ -0,0 +1,56 @@
+// Host FreeRTOS queue on a mutex and condition variable, items are copied in and out
+// by value and a receive blocks for up to its tick count like on the ESP32.
+#ifndef NATIVE_FREERTOS_QUEUE_H
+#define NATIVE_FREERTOS_QUEUE_H
+
+#include "FreeRTOS.h"
+#include <string.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+struct HostQueue {
+  std::mutex lock;
+  std::condition_variable ready;
+  std::deque<std::vector<uint8_t>> items;
+  size_t depth, itemSize;
+};
+typedef HostQueue *QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(size_t depth, size_t itemSize) {
+  QueueHandle_t q = new HostQueue;
+  q->depth = depth;
+  q->itemSize = itemSize;
+  return q;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t) {
+  {
+    std::lock_guard<std::mutex> hold(q->lock);
+    if (q->items.size() >= q->depth) return pdFALSE;
+    const uint8_t *bytes = (const uint8_t *)item;
+    q->items.emplace_back(bytes, bytes + q->itemSize);
+  }
+  q->ready.notify_one();
+  return pdTRUE;
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks) {
+  std::unique_lock<std::mutex> hold(q->lock);
+  auto some = [q] { return !q->items.empty(); };
+  if (ticks == portMAX_DELAY) q->ready.wait(hold, some);
+  else if (!q->ready.wait_for(hold, std::chrono::milliseconds(ticks), some)) return pdFALSE;
+  memcpy(item, q->items.front().data(), q->itemSize);
+  q->items.pop_front();
+  return pdTRUE;
+}
+
+inline BaseType_t xQueueReset(QueueHandle_t q) {
+  std::lock_guard<std::mutex> hold(q->lock);
+  q->items.clear();
+  return pdPASS;
+}
+
+#endif
@@ -0,0 +1,121 @@
+// RGB565 framebuffer with the calls of TFT_eSPI that src/kb_widget.h and src/rle.h paint
+// with, WIDTH and HEIGHT come from the test. It counts what the same calls cost on the
+// SPI bus: every fillRect, hline and setWindow (and each of the four lines of a drawRect)
+// is an address window, CASET + RASET + RAMWR = 11 bytes, then 2 bytes per pixel.
+// drawPixel sends CASET (5 bytes) and RASET (5) only when the column or row changed, then
+// RAMWR and the colour. drawChar follows TFT_eSPI's GLCD path: with a background at size 1
+// the cell is one 6x8 window, larger sizes send a fillRect per font pixel.
+
+#ifndef HOST_FB_H
+#define HOST_FB_H
+
+#include <Arduino.h>
+#include <Fonts/glcdfont.c>
+#include <string.h>
+
+#define WINDOW_BYTES 11
+
+class HostFb {
+public:
+  uint16_t px[WIDTH * HEIGHT];
+  uint32_t windows = 0;
+  uint64_t pixels = 0;
+  uint64_t commands = 0;   // bytes of the address commands of drawPixel
+
+  uint64_t busBytes() const { return (uint64_t)windows * WINDOW_BYTES + pixels * 2 + commands; }
+  void resetCounts() { windows = 0; pixels = 0; commands = 0; }
+  bool operator==(const HostFb &o) const { return memcmp(px, o.px, sizeof(px)) == 0; }
+
+  int16_t width() const { return WIDTH; }
+  int16_t height() const { return HEIGHT; }
+  void startWrite() {}
+  void endWrite() {}
+
+  void fillScreen(uint16_t c) { fillRect(0, 0, WIDTH, HEIGHT, c); }
+
+  void setWindow(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    windows++;
+    winX0 = x0; winX1 = x1; winY1 = y1;
+    curX = x0; curY = y0;
+    addrCol = addrRow = -1;
+  }
+
+  // The pixels go in the window left to right, top to bottom
+  void pushBlock(uint16_t c, uint32_t n) {
+    pixels += n;
+    for (; n; n--) {
+      if (curY <= winY1) plot(curX, curY, c);
+      if (++curX > winX1) { curX = winX0; curY++; }
+    }
+  }
+
+  void drawPixel(int32_t x, int32_t y, uint16_t c) {
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT) return;
+    if (addrCol != x) { commands += 5; addrCol = x; }
+    if (addrRow != y) { commands += 5; addrRow = y; }
+    commands++;
+    pixels++;
+    px[y * WIDTH + x] = c;
+  }
+
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t c) { fillRect(x, y, w, 1, c); }
+
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t c) {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > WIDTH) w = WIDTH - x;
+    if (y + h > HEIGHT) h = HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+    windows++;
+    addrCol = addrRow = -1;
+    pixels += w * h;
+    for (int32_t j = y; j < y + h; j++)
+      for (int32_t i = x; i < x + w; i++) px[j * WIDTH + i] = c;
+  }
+
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t c) {
+    fillRect(x, y, w, 1, c);
+    fillRect(x, y + h - 1, w, 1, c);
+    fillRect(x, y + 1, 1, h - 2, c);
+    fillRect(x + w - 1, y + 1, 1, h - 2, c);
+  }
+
+  void setTextSize(uint8_t s) { size = s ? s : 1; }
+  void setTextColor(uint16_t f, uint16_t b) { fg = f; bg = b; }
+
+  int16_t drawChar(uint16_t c, int32_t x, int32_t y) {
+    if (size == 1) {
+      windows++;
+      addrCol = addrRow = -1;
+      pixels += 48;
+      for (int i = 0; i < 6; i++) {
+        uint8_t line = i < 5 ? pgm_read_byte(font + c * 5 + i) : 0;
+        for (int j = 0; j < 8; j++, line >>= 1) plot(x + i, y + j, (line & 1) ? fg : bg);
+      }
+    } else {
+      for (int i = 0; i < 6; i++) {
+        uint8_t line = i < 5 ? pgm_read_byte(font + c * 5 + i) : 0;
+        for (int j = 0; j < 8; j++, line >>= 1) fillRect(x + i * size, y + j * size, size, size, (line & 1) ? fg : bg);
+      }
+    }
+    return 6 * size;
+  }
+
+  int16_t drawString(const char *s, int32_t x, int32_t y) {
+    int16_t w = 0;
+    for (; *s; s++) w += drawChar(*s, x + w, y);
+    return w;
+  }
+
+private:
+  uint8_t size = 1;
+  uint16_t fg = 0xFFFF, bg = 0;
+  int32_t winX0 = 0, winX1 = 0, winY1 = 0, curX = 0, curY = 0;
+  int32_t addrCol = -1, addrRow = -1;   // window drawPixel left set
+
+  void plot(int32_t x, int32_t y, uint16_t c) {
+    if (x >= 0 && y >= 0 && x < WIDTH && y < HEIGHT) px[y * WIDTH + x] = c;
+  }
+};
+
+#endif
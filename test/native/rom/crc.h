@@ -0,0 +1,17 @@
+// Host version of the ESP32 ROM crc32_le(): CRC-32/ISO-HDLC, the one zlib uses,
+// with the same pre and post inversion, so crc32_le(0, "123456789", 9) = CBF43926.
+#ifndef NATIVE_ROM_CRC_H
+#define NATIVE_ROM_CRC_H
+
+#include <stdint.h>
+
+static inline uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *buf++;
+    for (int b = 0; b < 8; b++) crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+  }
+  return ~crc;
+}
+
+#endif
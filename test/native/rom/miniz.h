@@ -0,0 +1,281 @@
+// Host version of the tinfl calls of the ESP32 ROM miniz: a raw deflate decoder (RFC 1951,
+// decoding as in zlib's contrib/puff) with tinfl's buffer contract. Like the ROM, without
+// TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF the output buffer from outStart is a circular
+// dictionary of a power of two size, outNext + *outLen must reach its end, and matches are
+// copied from it. A caller that moves outNext wrongly gets the wrong bytes back.
+// Input is taken like tinfl does: all of it when more is needed, up to the end of the
+// stream when it is done, so the bytes after it (the gzip trailer) are left to the caller.
+#ifndef NATIVE_ROM_MINIZ_H
+#define NATIVE_ROM_MINIZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define TINFL_LZ_DICT_SIZE 32768
+#define TINFL_FLAG_HAS_MORE_INPUT 2
+#define TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF 4
+
+typedef enum {
+  TINFL_STATUS_BAD_PARAM = -3,
+  TINFL_STATUS_ADLER32_MISMATCH = -2,
+  TINFL_STATUS_FAILED = -1,
+  TINFL_STATUS_DONE = 0,
+  TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+  TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+enum { NATIVE_TINFL_HEADER, NATIVE_TINFL_STORED, NATIVE_TINFL_CODES, NATIVE_TINFL_DONE };
+
+typedef struct {
+  short count[16];      // codes of each length
+  short symbol[288];    // symbols by code
+} native_tinfl_huff;
+
+// Plain data, the sink mallocs it
+typedef struct {
+  int mode;
+  bool last;            // in the final block
+  uint8_t hold[1024];   // input of a symbol or block header that was cut short
+  size_t holdLen;
+  size_t holdBit;       // bits of hold[0] already used
+  uint32_t stored;      // bytes left of a stored block
+  uint32_t copyLen;     // bytes left of a match
+  uint32_t copyDist;
+  uint64_t total;       // bytes out so far, no match may reach before the first
+  native_tinfl_huff lit, dist;
+} tinfl_decompressor;
+
+static inline void tinfl_init(tinfl_decompressor *r) { memset(r, 0, sizeof(*r)); }
+
+// The held bytes followed by the caller's input, read bit by bit
+struct NativeTinflBits {
+  const uint8_t *hold;
+  size_t holdLen;
+  const uint8_t *in;
+  size_t inLen;
+  size_t pos;           // bit position from hold[0]
+
+  bool bits(int n, int &val) {
+    if (pos + n > (holdLen + inLen) * 8) return false;
+    val = 0;
+    for (int i = 0; i < n; i++, pos++) {
+      size_t at = pos / 8;
+      uint8_t b = at < holdLen ? hold[at] : in[at - holdLen];
+      val |= ((b >> (pos & 7)) & 1) << i;
+    }
+    return true;
+  }
+};
+
+// 0 for a complete code, > 0 incomplete, < 0 over-subscribed
+static inline int nativeTinflBuild(native_tinfl_huff *h, const short *length, int n) {
+  short offs[16];
+  memset(h->count, 0, sizeof(h->count));
+  for (int s = 0; s < n; s++) h->count[length[s]]++;
+  if (h->count[0] == n) return 0;
+  int left = 1;
+  for (int len = 1; len < 16; len++) {
+    left <<= 1;
+    left -= h->count[len];
+    if (left < 0) return left;
+  }
+  offs[1] = 0;
+  for (int len = 1; len < 15; len++) offs[len + 1] = offs[len] + h->count[len];
+  for (int s = 0; s < n; s++)
+    if (length[s]) h->symbol[offs[length[s]]++] = s;
+  return left;
+}
+
+// The next symbol, -2 when the input ran out, -1 for a code that is not in the table
+static inline int nativeTinflDecode(NativeTinflBits &b, const native_tinfl_huff *h) {
+  int code = 0, first = 0, index = 0, bit;
+  for (int len = 1; len < 16; len++) {
+    if (!b.bits(1, bit)) return -2;
+    code |= bit;
+    int count = h->count[len];
+    if (code - count < first) return h->symbol[index + (code - first)];
+    index += count;
+    first += count;
+    first <<= 1;
+    code <<= 1;
+  }
+  return -1;
+}
+
+// Tables of the block whose header starts at b.pos: 1 done, 0 more input needed, -1 bad
+static inline int nativeTinflTables(tinfl_decompressor *r, NativeTinflBits &b, int type) {
+  short lengths[320];
+  if (type == 1) {
+    int s = 0;
+    for (; s < 144; s++) lengths[s] = 8;
+    for (; s < 256; s++) lengths[s] = 9;
+    for (; s < 280; s++) lengths[s] = 7;
+    for (; s < 288; s++) lengths[s] = 8;
+    nativeTinflBuild(&r->lit, lengths, 288);
+    for (s = 0; s < 30; s++) lengths[s] = 5;
+    nativeTinflBuild(&r->dist, lengths, 30);
+    return 1;
+  }
+  static const short order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+  int nlen, ndist, ncode, v;
+  if (!b.bits(5, nlen) || !b.bits(5, ndist) || !b.bits(4, ncode)) return 0;
+  nlen += 257;
+  ndist += 1;
+  ncode += 4;
+  if (nlen > 286 || ndist > 30) return -1;
+  int index = 0;
+  for (; index < ncode; index++) {
+    if (!b.bits(3, v)) return 0;
+    lengths[order[index]] = v;
+  }
+  for (; index < 19; index++) lengths[order[index]] = 0;
+  if (nativeTinflBuild(&r->lit, lengths, 19) != 0) return -1;
+  for (index = 0; index < nlen + ndist;) {
+    int sym = nativeTinflDecode(b, &r->lit);
+    if (sym == -2) return 0;
+    if (sym < 0) return -1;
+    if (sym < 16) {
+      lengths[index++] = sym;
+      continue;
+    }
+    short len = 0;
+    int repeat;
+    if (sym == 16) {
+      if (index == 0) return -1;
+      len = lengths[index - 1];
+      if (!b.bits(2, repeat)) return 0;
+      repeat += 3;
+    } else if (sym == 17) {
+      if (!b.bits(3, repeat)) return 0;
+      repeat += 3;
+    } else {
+      if (!b.bits(7, repeat)) return 0;
+      repeat += 11;
+    }
+    if (index + repeat > nlen + ndist) return -1;
+    while (repeat--) lengths[index++] = len;
+  }
+  if (lengths[256] == 0) return -1;
+  int err = nativeTinflBuild(&r->lit, lengths, nlen);
+  if (err < 0 || (err > 0 && nlen - r->lit.count[0] != 1)) return -1;
+  err = nativeTinflBuild(&r->dist, lengths + nlen, ndist);
+  if (err < 0 || (err > 0 && ndist - r->dist.count[0] != 1)) return -1;
+  return 1;
+}
+
+static inline tinfl_status tinfl_decompress(tinfl_decompressor *r, const uint8_t *in, size_t *inLen,
+                                            uint8_t *outStart, uint8_t *outNext, size_t *outLen,
+                                            uint32_t flags) {
+  static const short lenBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+  static const short lenExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                     3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+  static const short distBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                     257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                     8193, 12289, 16385, 24577};
+  static const short distExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                      7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+  if (flags & TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF) return TINFL_STATUS_BAD_PARAM;   // not used by src
+  size_t dictSize = (size_t)(outNext - outStart) + *outLen;
+  if (outNext < outStart || dictSize == 0 || (dictSize & (dictSize - 1))) {
+    *inLen = *outLen = 0;
+    return TINFL_STATUS_BAD_PARAM;
+  }
+  size_t mask = dictSize - 1, pos = outNext - outStart, outEnd = pos + *outLen;
+  NativeTinflBits b = {r->hold, r->holdLen, in, *inLen, r->holdBit};
+  tinfl_status status = TINFL_STATUS_FAILED;
+  int v;
+
+  while (true) {
+    size_t unit = b.pos;   // where the symbol or header began, to go back when it is cut short
+    if (r->mode == NATIVE_TINFL_DONE) { status = TINFL_STATUS_DONE; break; }
+    if (r->mode == NATIVE_TINFL_HEADER) {
+      int type;
+      if (!b.bits(1, v) || !b.bits(2, type)) { b.pos = unit; status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+      r->last = v;
+      if (type == 0) {
+        b.pos = (b.pos + 7) & ~(size_t)7;
+        int len, nlen, hi;
+        if (!b.bits(8, len) || !b.bits(8, hi)) { b.pos = unit; status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+        len |= hi << 8;
+        if (!b.bits(8, nlen) || !b.bits(8, hi)) { b.pos = unit; status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+        nlen |= hi << 8;
+        if (len != (~nlen & 0xFFFF)) break;
+        r->stored = len;
+        r->mode = NATIVE_TINFL_STORED;
+      } else if (type == 3) {
+        break;
+      } else {
+        int got = nativeTinflTables(r, b, type);
+        if (got < 0) break;
+        if (got == 0) { b.pos = unit; status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+        r->mode = NATIVE_TINFL_CODES;
+      }
+      continue;
+    }
+    if (r->mode == NATIVE_TINFL_STORED) {
+      if (r->stored == 0) { r->mode = r->last ? NATIVE_TINFL_DONE : NATIVE_TINFL_HEADER; continue; }
+      if (pos == outEnd) { status = TINFL_STATUS_HAS_MORE_OUTPUT; break; }
+      if (!b.bits(8, v)) { status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+      outStart[pos++ & mask] = v;
+      r->total++;
+      r->stored--;
+      continue;
+    }
+    // NATIVE_TINFL_CODES
+    if (r->copyLen) {
+      if (pos == outEnd) { status = TINFL_STATUS_HAS_MORE_OUTPUT; break; }
+      outStart[pos & mask] = outStart[(pos - r->copyDist) & mask];
+      pos++;
+      r->total++;
+      r->copyLen--;
+      continue;
+    }
+    int sym = nativeTinflDecode(b, &r->lit);
+    if (sym == -2) { b.pos = unit; status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+    if (sym < 0) break;
+    if (sym < 256) {
+      if (pos == outEnd) { b.pos = unit; status = TINFL_STATUS_HAS_MORE_OUTPUT; break; }
+      outStart[pos++ & mask] = sym;
+      r->total++;
+      continue;
+    }
+    if (sym == 256) { r->mode = r->last ? NATIVE_TINFL_DONE : NATIVE_TINFL_HEADER; continue; }
+    sym -= 257;
+    if (sym >= 29) break;
+    int len, dsym, dist;
+    if (!b.bits(lenExtra[sym], len)) { b.pos = unit; status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+    dsym = nativeTinflDecode(b, &r->dist);
+    if (dsym == -2) { b.pos = unit; status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+    if (dsym < 0 || dsym >= 30) break;
+    if (!b.bits(distExtra[dsym], dist)) { b.pos = unit; status = TINFL_STATUS_NEEDS_MORE_INPUT; break; }
+    dist += distBase[dsym];
+    if ((uint64_t)dist > r->total || (size_t)dist > dictSize) break;
+    r->copyLen = lenBase[sym] + len;
+    r->copyDist = dist;
+  }
+
+  *outLen = pos - (outNext - outStart);
+  // The bytes from the one b.pos is in are held for the next call, or handed back
+  size_t avail = r->holdLen + *inLen;
+  size_t keepFrom = b.pos / 8, keepTo;
+  if (status == TINFL_STATUS_NEEDS_MORE_INPUT) keepTo = avail;
+  else if (status == TINFL_STATUS_DONE) keepFrom = keepTo = (b.pos + 7) / 8;
+  else keepTo = (b.pos + 7) / 8;
+  if (keepTo < r->holdLen) keepTo = r->holdLen;
+  if (keepTo - keepFrom > sizeof(r->hold)) {
+    *inLen = 0;
+    return TINFL_STATUS_FAILED;
+  }
+  uint8_t held[sizeof(r->hold)];
+  for (size_t i = keepFrom; i < keepTo; i++) held[i - keepFrom] = i < r->holdLen ? r->hold[i] : in[i - r->holdLen];
+  *inLen = keepTo - r->holdLen;
+  memcpy(r->hold, held, keepTo - keepFrom);
+  r->holdLen = keepTo - keepFrom;
+  r->holdBit = b.pos - keepFrom * 8;
+  if (status == TINFL_STATUS_DONE) r->holdLen = r->holdBit = 0;
+  return status;
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Host tests for batteryFilter() in src/battery.h, run with: pio test -e native -f test_battery
+
+#include <unity.h>
+#include <battery.h>
+#include <string>
+
+// Filter output in mV, the way batterySample() publishes it
+static uint32_t mvOf(int32_t state) { return state >> 4; }
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_first_sample_seeds_the_filter(void) {
+  int32_t state = batteryFilter(0, 3987);
+  TEST_ASSERT_EQUAL_UINT32(3987, mvOf(state));
+
+  // a board with no battery reading returns 0 mV and keeps the filter unseeded,
+  // the first real sample still goes in as is
+  state = batteryFilter(0, 0);
+  TEST_ASSERT_EQUAL_INT32(0, state);
+  TEST_ASSERT_EQUAL_UINT32(4012, mvOf(batteryFilter(state, 4012)));
+}
+
+void test_steady_input_stays_put(void) {
+  int32_t state = batteryFilter(0, 3700);
+  for (int i = 0; i < 100; i++) state = batteryFilter(state, 3700);
+  TEST_ASSERT_EQUAL_UINT32(3700, mvOf(state));
+}
+
+// Plugging the charger in: every step covers 1/4 of what is left, so within 1 mV of a
+// 400 mV jump takes about 22 samples, under two minutes at BATTERY_SAMPLE_MS.
+void test_converges_up_and_down(void) {
+  int32_t state = batteryFilter(0, 3700);
+  int steps = 0;
+  while (mvOf(state) < 4099 && steps < 100) {
+    uint32_t before = mvOf(state);
+    state = batteryFilter(state, 4100);
+    TEST_ASSERT_TRUE(mvOf(state) >= before);  // never overshoots or moves back
+    TEST_ASSERT_TRUE(mvOf(state) <= 4100);
+    steps++;
+  }
+  TEST_ASSERT_INT_WITHIN(1, 4100, mvOf(state));
+  TEST_ASSERT_TRUE(steps <= 22);
+  TEST_MESSAGE(("3700 -> 4100 mV settled in " + std::to_string(steps) + " samples").c_str());
+
+  steps = 0;
+  while (mvOf(state) > 3601 && steps < 100) {
+    state = batteryFilter(state, 3600);
+    TEST_ASSERT_TRUE(mvOf(state) >= 3600);
+    steps++;
+  }
+  TEST_ASSERT_INT_WITHIN(1, 3600, mvOf(state));
+  TEST_ASSERT_TRUE(steps <= 25);
+}
+
+void test_smooths_adc_noise(void) {
+  // +-40 mV alternating noise around 3800 mV comes out at less than half of that
+  int32_t state = batteryFilter(0, 3800);
+  uint32_t lo = 0xFFFF, hi = 0;
+  for (int i = 0; i < 200; i++) {
+    state = batteryFilter(state, (i & 1) ? 3840 : 3760);
+    if (i < 20) continue;
+    uint32_t mv = mvOf(state);
+    if (mv < lo) lo = mv;
+    if (mv > hi) hi = mv;
+  }
+  TEST_ASSERT_TRUE(lo >= 3780 && hi <= 3820);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_sample_seeds_the_filter);
+  RUN_TEST(test_steady_input_stays_put);
+  RUN_TEST(test_converges_up_and_down);
+  RUN_TEST(test_smooths_adc_noise);
+  return UNITY_END();
+}
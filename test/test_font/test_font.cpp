@@ -0,0 +1,238 @@
+// Host tests and a benchmark for the smooth font glyph atlas and colour runs in
+// lib/TFT_eSPI/Extensions/Glyph_atlas.h, run with:
+//   pio test -e native -f test_font
+// The font is FreeSans18pt7b brought down 2x2 to a 9 pt anti-aliased font, its
+// bitmaps written to a file the way a .vlw keeps them. Rendering a screen of menu text
+// is then counted both ways:
+//   before: drawGlyph seeks once and reads every row of a glyph from the file, and
+//           sends a line or pixel command for every run of a row
+//   after:  the atlas holds the bitmaps, a glyph goes out as one address window
+//           filled with colour runs
+// Bus bytes count a window as CASET + RASET + RAMWR (11 bytes) plus 2 per pixel.
+
+#include <Arduino.h>
+#include <unity.h>
+#define LOAD_GFXFF
+#include <Fonts/GFXFF/gfxfont.h>
+#include <Extensions/Glyph_atlas.h>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define WINDOW_BYTES 11
+
+struct Glyph {
+  uint8_t width, height;
+  uint32_t offset;   // of the bitmap in the font file
+};
+
+struct HostFont {
+  std::vector<Glyph> glyphs;   // 0x20..0x7E
+  std::string path;
+  FILE *file = NULL;
+  uint32_t seeks = 0, reads = 0;
+
+  bool fileRead(uint32_t offset, uint8_t *buf, uint16_t len) {
+    seeks++;
+    reads++;
+    return fseek(file, offset, SEEK_SET) == 0 && fread(buf, 1, len, file) == len;
+  }
+};
+
+static HostFont font;
+
+// Every 2x2 block of the 1 bit glyph becomes one pixel of 0, 63, 127, 191 or 255
+static void buildFont(void) {
+  const GFXfont &src = FreeSans18pt7b;
+  font.path = (std::filesystem::temp_directory_path() / "bruce_test_font.bin").string();
+  FILE *f = fopen(font.path.c_str(), "wb");
+  uint32_t offset = 0;
+  for (uint16_t c = src.first; c <= src.last; c++) {
+    const GFXglyph &g = src.glyph[c - src.first];
+    Glyph out = {(uint8_t)((g.width + 1) / 2), (uint8_t)((g.height + 1) / 2), offset};
+    std::vector<uint8_t> alpha(out.width * out.height);
+    for (int y = 0; y < g.height; y++)
+      for (int x = 0; x < g.width; x++) {
+        uint32_t bit = g.bitmapOffset * 8 + y * g.width + x;
+        if (src.bitmap[bit / 8] & (0x80 >> (bit % 8))) alpha[(y / 2) * out.width + x / 2] += 63;
+      }
+    for (uint8_t &a : alpha) if (a == 252) a = 255;
+    fwrite(alpha.data(), 1, alpha.size(), f);
+    offset += alpha.size();
+    font.glyphs.push_back(out);
+  }
+  fclose(f);
+  font.file = fopen(font.path.c_str(), "rb");
+}
+
+static bool atlasRead(void *ctx, uint32_t offset, uint8_t *buf, uint16_t len) {
+  return ((HostFont *)ctx)->fileRead(offset, buf, len);
+}
+
+static const char *screen[] = {
+  "WiFi", "BLE", "RF", "RFID", "IR", "Others", "Clock", "Config",
+  "Scan networks", "Evil Portal", "Deauth flood", "Raw sniffer",
+  "Record RAW", "Spectrum", "Decoder", "Custom SubGhz",
+  "Battery: 87%   12:45", "SD: 7.4 GB free",
+};
+
+struct BusCost {
+  uint32_t windows = 0, pixels = 0;
+  uint64_t bytes() const { return (uint64_t)windows * WINDOW_BYTES + pixels * 2; }
+};
+
+// The loop drawGlyph keeps for the cases runs cannot take: per row, full alpha in runs
+// sent as lines, partial alpha one pixel at a time, background in runs as lines
+static void drawPerRun(const uint8_t *alpha, const Glyph &g, BusCost &bus) {
+  for (int y = 0; y < g.height; y++) {
+    uint32_t fl = 0, bl = 0;
+    for (int x = 0; x < g.width; x++) {
+      uint8_t a = alpha[y * g.width + x];
+      if (a) {
+        if (bl) { bus.windows++; bus.pixels += bl; bl = 0; }
+        if (a != 0xFF) {
+          if (fl) { bus.windows++; bus.pixels += fl; fl = 0; }
+          bus.windows++;
+          bus.pixels++;
+        } else {
+          fl++;
+        }
+      } else {
+        if (fl) { bus.windows++; bus.pixels += fl; fl = 0; }
+        bl++;
+      }
+    }
+    if (fl) { bus.windows++; bus.pixels += fl; }
+    if (bl) { bus.windows++; bus.pixels += bl; }
+  }
+}
+
+static void drawRuns(const uint8_t *alpha, const Glyph &g, BusCost &bus) {
+  bus.windows++;
+  glyphRuns(alpha, g.width * g.height, [&](uint8_t, uint32_t len) { bus.pixels += len; });
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_runs_rebuild_the_glyph(void) {
+  GlyphAtlas atlas;
+  TEST_ASSERT_TRUE(atlas.begin(font.glyphs.size(), 12 * 1024));
+  uint32_t runs = 0, pixels = 0;
+  for (size_t i = 0; i < font.glyphs.size(); i++) {
+    const Glyph &g = font.glyphs[i];
+    if (g.width * g.height == 0) continue;
+    const uint8_t *alpha = atlas.get(i, g.offset, g.width * g.height, atlasRead, &font);
+    TEST_ASSERT_NOT_NULL(alpha);
+    std::vector<uint8_t> back;
+    glyphRuns(alpha, g.width * g.height, [&](uint8_t a, uint32_t len) {
+      TEST_ASSERT_TRUE(len > 0);
+      TEST_ASSERT_TRUE(back.empty() || back.back() != a);  // runs are maximal
+      back.insert(back.end(), len, a);
+      runs++;
+    });
+    TEST_ASSERT_EQUAL(g.width * g.height, back.size());
+    TEST_ASSERT_EQUAL_MEMORY(alpha, back.data(), back.size());
+    pixels += back.size();
+  }
+  char line[96];
+  snprintf(line, sizeof(line), "%u pixels in %u runs, %.1f pixels per run", pixels, runs, (double)pixels / runs);
+  TEST_MESSAGE(line);
+  atlas.end();
+}
+
+void test_atlas_matches_file_and_evicts(void) {
+  GlyphAtlas atlas;
+  TEST_ASSERT_TRUE(atlas.begin(font.glyphs.size(), 1500));   // a fraction of the font
+  std::vector<uint8_t> direct;
+  for (int pass = 0; pass < 3; pass++) {
+    for (size_t i = 1; i < font.glyphs.size(); i++) {
+      const Glyph &g = font.glyphs[i];
+      uint16_t size = g.width * g.height;
+      const uint8_t *alpha = atlas.get(i, g.offset, size, atlasRead, &font);
+      TEST_ASSERT_NOT_NULL(alpha);
+      direct.resize(size);
+      TEST_ASSERT_TRUE(font.fileRead(g.offset, direct.data(), size));
+      TEST_ASSERT_EQUAL_MEMORY(direct.data(), alpha, size);
+      TEST_ASSERT_TRUE(atlas.bytes <= atlas.budget);
+    }
+  }
+  // a glyph over the whole budget is never cached
+  TEST_ASSERT_NULL(atlas.get(0, 0, 1501, atlasRead, &font));
+  atlas.end();
+  TEST_ASSERT_EQUAL(0, atlas.bytes);
+}
+
+void test_render_benchmark(void) {
+  const int frames = 500;
+  BusCost before, after;
+  uint32_t fileBefore = 0, fileAfter = 0, glyphs = 0;
+  std::vector<uint8_t> alpha;
+
+  font.seeks = font.reads = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int f = 0; f < frames; f++) {
+    for (const char *text : screen) {
+      for (const char *p = text; *p; p++) {
+        if (*p == ' ') continue;   // drawGlyph only fills a space
+        const Glyph &g = font.glyphs[*p - 0x20];
+        alpha.resize(g.width * g.height);
+        fseek(font.file, g.offset, SEEK_SET);
+        font.seeks++;
+        for (int y = 0; y < g.height; y++) {
+          fread(alpha.data() + y * g.width, 1, g.width, font.file);
+          font.reads++;
+        }
+        drawPerRun(alpha.data(), g, before);
+        glyphs++;
+      }
+    }
+  }
+  double sBefore = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  fileBefore = font.seeks + font.reads;
+
+  GlyphAtlas atlas;
+  atlas.begin(font.glyphs.size(), 12 * 1024);
+  font.seeks = font.reads = 0;
+  t0 = std::chrono::steady_clock::now();
+  for (int f = 0; f < frames; f++) {
+    for (const char *text : screen) {
+      for (const char *p = text; *p; p++) {
+        if (*p == ' ') continue;
+        uint16_t n = *p - 0x20;
+        const Glyph &g = font.glyphs[n];
+        drawRuns(atlas.get(n, g.offset, g.width * g.height, atlasRead, &font), g, after);
+      }
+    }
+  }
+  double sAfter = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  fileAfter = font.seeks + font.reads;
+
+  char line[160];
+  snprintf(line, sizeof(line), "per screen of %u glyphs: file calls %u -> %u, bus windows %u -> %u, bus bytes %llu -> %llu",
+           glyphs / frames, fileBefore / frames, fileAfter / frames, before.windows / frames, after.windows / frames,
+           (unsigned long long)(before.bytes() / frames), (unsigned long long)(after.bytes() / frames));
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "host time per screen: %.1f us -> %.1f us, atlas %u hits %u misses %u bytes",
+           sBefore * 1e6 / frames, sAfter * 1e6 / frames, atlas.hits, atlas.misses, atlas.bytes);
+  TEST_MESSAGE(line);
+
+  TEST_ASSERT_EQUAL(before.pixels, after.pixels);               // the same boxes get painted
+  TEST_ASSERT_EQUAL(glyphs / frames, after.windows / frames);   // one window per glyph
+  TEST_ASSERT_TRUE(after.bytes() < before.bytes());
+  TEST_ASSERT_TRUE(atlas.misses <= 96 && fileAfter == 2 * atlas.misses);   // only the first screen reads
+  atlas.end();
+}
+
+int main(int argc, char **argv) {
+  buildFont();
+  UNITY_BEGIN();
+  RUN_TEST(test_runs_rebuild_the_glyph);
+  RUN_TEST(test_atlas_matches_file_and_evicts);
+  RUN_TEST(test_render_benchmark);
+  int failures = UNITY_END();
+  fclose(font.file);
+  remove(font.path.c_str());
+  return failures;
+}
@@ -0,0 +1,144 @@
+// Host tests for src/input_events.cpp, run with: pio test -e native -f test_input
+// The debounce tests feed inputSample() the readings the 10 ms tick would make, with
+// times a little in the past so inputWait() does not drop them as stale. The latency
+// test blocks a menu loop in inputWait() on another thread and measures how long an
+// inputInject() takes to wake it, the polled loops waited delay(200) per press.
+
+#include <unity.h>
+#include <input.h>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+static uint32_t base;   // time of the first sample, 950 ms ago
+
+static void sample(uint8_t key, bool raw, uint32_t at) { inputSample(key, raw, base + at); }
+
+static std::vector<InputEvent> drain() {
+  std::vector<InputEvent> out;
+  InputEvent ev;
+  while (inputWait(ev, 0)) out.push_back(ev);
+  return out;
+}
+
+void setUp(void) {
+  inputQueueBegin();
+  base = millis() - 950;
+}
+void tearDown(void) {}
+
+void test_bounces_are_filtered(void) {
+  const bool bouncy[] = {1, 0, 1, 0, 1, 1, 1, 1, 0, 1, 1, 0, 0, 0};
+  uint32_t t = 0;
+  for (bool raw : bouncy) {
+    sample(IN_SEL, raw, t);
+    t += INPUT_TICK_MS;
+  }
+  std::vector<InputEvent> evs = drain();
+  TEST_ASSERT_EQUAL(2, evs.size());
+  TEST_ASSERT_EQUAL(EV_PRESS, evs[0].type);
+  TEST_ASSERT_EQUAL(IN_SEL, evs[0].key);
+  TEST_ASSERT_EQUAL(base + 50, evs[0].timeMs);     // the second stable sample
+  TEST_ASSERT_EQUAL(EV_RELEASE, evs[1].type);
+  TEST_ASSERT_EQUAL(base + 120, evs[1].timeMs);
+  TEST_ASSERT_EQUAL(70, evs[1].heldMs);
+  TEST_ASSERT_FALSE(inputHeld(IN_SEL));
+}
+
+void test_long_press_and_repeat(void) {
+  uint32_t t = 0;
+  for (; t <= 900; t += INPUT_TICK_MS) sample(IN_NEXT, true, t);
+  TEST_ASSERT_TRUE(inputHeld(IN_NEXT));
+  std::vector<InputEvent> evs = drain();
+  // press at 10, long at 510, repeats at 660 and 810
+  TEST_ASSERT_EQUAL(4, evs.size());
+  TEST_ASSERT_EQUAL(EV_PRESS, evs[0].type);
+  TEST_ASSERT_EQUAL(EV_LONG, evs[1].type);
+  TEST_ASSERT_EQUAL(INPUT_LONG_MS, evs[1].heldMs);
+  TEST_ASSERT_EQUAL(EV_REPEAT, evs[2].type);
+  TEST_ASSERT_EQUAL(INPUT_LONG_MS + INPUT_REPEAT_MS, evs[2].heldMs);
+  TEST_ASSERT_EQUAL(EV_REPEAT, evs[3].type);
+  TEST_ASSERT_EQUAL(INPUT_LONG_MS + 2 * INPUT_REPEAT_MS, evs[3].heldMs);
+}
+
+void test_stale_events_are_dropped(void) {
+  inputSample(IN_PREV, true, millis() - INPUT_STALE_MS - 500);
+  inputSample(IN_PREV, true, millis() - INPUT_STALE_MS - 490);
+  InputEvent ev;
+  TEST_ASSERT_FALSE(inputWait(ev, 0));
+  inputInject(IN_NEXT, EV_PRESS);
+  TEST_ASSERT_TRUE(inputWait(ev, 0));
+  TEST_ASSERT_EQUAL(IN_NEXT, ev.key);
+}
+
+void test_clicks_are_taken_once(void) {
+  inputInject(IN_SEL, EV_PRESS);
+  TEST_ASSERT_TRUE(inputTakeClick(IN_SEL));
+  TEST_ASSERT_FALSE(inputTakeClick(IN_SEL));
+  // a press taken by inputWait() is not seen again by check*Press()
+  inputInject(IN_SEL, EV_PRESS);
+  InputEvent ev;
+  TEST_ASSERT_TRUE(inputWait(ev, 0));
+  TEST_ASSERT_FALSE(inputTakeClick(IN_SEL));
+  inputInject(IN_PREV, EV_PRESS);
+  inputFlush();
+  TEST_ASSERT_FALSE(inputWait(ev, 0));
+  TEST_ASSERT_FALSE(inputTakeClick(IN_PREV));
+}
+
+void test_full_queue_counts_drops(void) {
+  for (int i = 0; i < 20; i++) inputInject(IN_NEXT, i % 2 ? EV_RELEASE : EV_PRESS);
+  TEST_ASSERT_EQUAL(20, inputStats.injected);
+  TEST_ASSERT_EQUAL(20, inputStats.events);
+  TEST_ASSERT_EQUAL(4, inputStats.dropped);
+  TEST_ASSERT_EQUAL(16, drain().size());
+}
+
+void test_inject_latency(void) {
+  const int rounds = 500;
+  std::atomic<int> woken{0};
+  std::atomic<bool> stop{false};
+  std::vector<std::chrono::steady_clock::time_point> wokeAt(rounds);
+
+  std::thread menu([&] {
+    InputEvent ev;
+    while (!stop) {
+      if (!inputWait(ev, 100)) continue;
+      wokeAt[woken] = std::chrono::steady_clock::now();
+      woken++;
+    }
+  });
+
+  std::vector<double> us;
+  for (int i = 0; i < rounds; i++) {
+    auto t0 = std::chrono::steady_clock::now();
+    inputInject(IN_SEL, EV_PRESS);
+    while (woken <= i) std::this_thread::yield();
+    us.push_back(std::chrono::duration<double, std::micro>(wokeAt[i] - t0).count());
+  }
+  stop = true;
+  menu.join();
+
+  std::sort(us.begin(), us.end());
+  char report[128];
+  snprintf(report, sizeof(report), "inject to inputWait() return, %d rounds: median %.0f us, p99 %.0f us, max %.0f us (polled: 200000 us)",
+           rounds, us[rounds / 2], us[rounds * 99 / 100], us[rounds - 1]);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_EQUAL(0, inputStats.dropped);
+  TEST_ASSERT_TRUE(us[rounds / 2] < INPUT_TICK_MS * 1000);
+}
+
+int main(int argc, char **argv) {
+  // the sample times reach a second back, start where millis() has got that far
+  while (millis() < 1100) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  UNITY_BEGIN();
+  RUN_TEST(test_bounces_are_filtered);
+  RUN_TEST(test_long_press_and_repeat);
+  RUN_TEST(test_stale_events_are_dropped);
+  RUN_TEST(test_clicks_are_taken_once);
+  RUN_TEST(test_full_queue_counts_drops);
+  RUN_TEST(test_inject_latency);
+  return UNITY_END();
+}
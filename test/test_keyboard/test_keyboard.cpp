@@ -0,0 +1,158 @@
+// Host tests and a frame time benchmark for the on-screen keyboard painters in
+// src/kb_widget.h, run with: pio test -e native -f test_keyboard
+// A password is typed on the Stick keyboard the way a user does it: next/prev presses
+// move the focus, select types the key or toggles CAP. After every press the screen is
+// updated two ways into host_fb.h framebuffers:
+//   before: the whole keyboard is repainted, as keyboard() did on every move
+//   after:  the incremental repaint keyboard() does now
+// Both framebuffers must hold the same picture after every press.
+
+#include <stdint.h>
+
+// StickC Plus2 / Cardputer build flags
+#define WIDTH  240
+#define HEIGHT 135
+#define LW     6
+#define FP     1
+#define FM     2
+#define TFT_BLACK    0x0000
+#define TFT_WHITE    0xFFFF
+#define TFT_DARKGREY 0x7BEF
+#define BGCOLOR      TFT_BLACK
+static uint16_t FGCOLOR = 0xA80F;
+
+#include <unity.h>
+#include "host_fb.h"
+#include <kb_widget.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define SPI_HZ 20000000   // SPI_FREQUENCY of all three boards
+
+struct KbState {
+  int x = 0, y = -1;
+  bool caps = false;
+  std::string text;
+};
+
+enum Press { NEXT, PREV, SEL };
+
+// The state changes keyboard() makes for a short press
+static void apply(KbState &s, Press p) {
+  if (p == SEL) {
+    if (s.y == -1 && s.x == 1) s.caps = !s.caps;
+    else if (s.y == -1 && s.x == 2 && s.text.size()) s.text.pop_back();
+    else if (s.y == -1 && s.x > 2) s.text += ' ';
+    else if (s.y > -1) s.text += kbKeys[s.y][s.x][s.caps ? 1 : 0];
+  } else if (p == NEXT) {
+    s.x++;
+    if (s.y < 0 && s.x > 3) s.x = 0;
+    if (s.x > 11) s.x = 0;
+  } else {
+    s.y++;
+    if (s.y > 3) s.y = -1;
+  }
+}
+
+// The repaint keyboard() does after a press
+static void repaint(HostFb &fb, const KbState &was, const KbState &now) {
+  if (now.caps != was.caps)
+    for (int i = 0; i < 4; i++) for (int j = 0; j < 12; j++) kbDrawKey(fb, j, i, now.x == j && now.y == i, now.caps);
+  if (now.x != was.x || now.y != was.y || now.caps != was.caps) {
+    kbDrawKey(fb, was.x, was.y, false, now.caps);
+    kbDrawKey(fb, now.x, now.y, true, now.caps);
+  }
+  if (now.text.size() != was.text.size()) kbUpdateText(fb, now.text.c_str(), now.text.size(), was.text.size());
+}
+
+// Presses to type text: rows first, then columns, CAP when the case changes
+static std::vector<Press> pressesFor(const char *text) {
+  std::vector<Press> out;
+  KbState s;
+  auto moveTo = [&](int tx, int ty) {
+    while (s.y != ty) { apply(s, PREV); out.push_back(PREV); }
+    while (s.x != tx) { apply(s, NEXT); out.push_back(NEXT); }
+  };
+  for (const char *c = text; *c; c++) {
+    int tx = -1, ty = -1, caps = 0;
+    for (int y = 0; y < 4 && tx < 0; y++)
+      for (int x = 0; x < 12 && tx < 0; x++)
+        for (int z = 0; z < 2 && tx < 0; z++)
+          if (kbKeys[y][x][z] == *c) { tx = x; ty = y; caps = z; }
+    TEST_ASSERT_TRUE(tx >= 0);
+    if ((bool)caps != s.caps) {
+      moveTo(1, -1);
+      apply(s, SEL);
+      out.push_back(SEL);
+    }
+    moveTo(tx, ty);
+    apply(s, SEL);
+    out.push_back(SEL);
+  }
+  return out;
+}
+
+static HostFb full, incremental;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_layout_fits_the_screen(void) {
+  TEST_ASSERT_TRUE(11 * KB_KEY_DX + KB_KEY_X + KB_KEY_W <= WIDTH);
+  TEST_ASSERT_TRUE(3 * KB_KEY_DY + KB_KEY_Y + KB_KEY_H <= HEIGHT);
+  TEST_ASSERT_TRUE(kbButtons[3].x + kbButtons[3].w <= WIDTH);
+  int cx, cy, size;
+  kbTextCell(75, 76, cx, cy, size);   // last character of the longest text
+  TEST_ASSERT_TRUE(cx + LW * size <= WIDTH - 1 && cy + 8 * size <= KB_KEY_Y);
+}
+
+void test_typing_benchmark(void) {
+  const char *password = "Bruce-Pass_2024!wifi.Key";
+  std::vector<Press> presses = pressesFor(password);
+  const char *msg = "Password:";
+
+  KbState s;
+  kbDrawAll(incremental, msg, "", 0, s.x, s.y, s.caps);
+  uint64_t fullBytes = 0, incBytes = 0, fullWorst = 0, incWorst = 0;
+  double fullSec = 0, incSec = 0;
+  for (Press p : presses) {
+    KbState was = s;
+    apply(s, p);
+
+    full.resetCounts();
+    auto t0 = std::chrono::steady_clock::now();
+    kbDrawAll(full, msg, s.text.c_str(), s.text.size(), s.x, s.y, s.caps);
+    fullSec += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    incremental.resetCounts();
+    t0 = std::chrono::steady_clock::now();
+    repaint(incremental, was, s);
+    incSec += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    TEST_ASSERT_TRUE(full == incremental);
+    fullBytes += full.busBytes();
+    incBytes += incremental.busBytes();
+    if (full.busBytes() > fullWorst) fullWorst = full.busBytes();
+    if (incremental.busBytes() > incWorst) incWorst = incremental.busBytes();
+  }
+  TEST_ASSERT_EQUAL_STRING(password, s.text.c_str());
+
+  size_t n = presses.size();
+  char line[160];
+  snprintf(line, sizeof(line), "%u presses to type %u characters, bus bytes per frame %llu -> %llu (worst %llu -> %llu)",
+           (unsigned)n, (unsigned)strlen(password), (unsigned long long)(fullBytes / n), (unsigned long long)(incBytes / n),
+           (unsigned long long)fullWorst, (unsigned long long)incWorst);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "frame time at %u MHz SPI: %.2f ms -> %.2f ms, host paint %.1f us -> %.1f us",
+           SPI_HZ / 1000000, fullBytes * 8e3 / SPI_HZ / n, incBytes * 8e3 / SPI_HZ / n, fullSec * 1e6 / n, incSec * 1e6 / n);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_TRUE(incBytes * 10 < fullBytes);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_layout_fits_the_screen);
+  RUN_TEST(test_typing_benchmark);
+  return UNITY_END();
+}
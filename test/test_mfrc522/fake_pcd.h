@@ -0,0 +1,261 @@
+// Simulated MFRC522 (PCD) with one card (PICC) in its field, reached through
+// MFRC522_Transport so the driver runs unchanged on the host.
+//
+// The PCD keeps the register file, the 64 byte FIFO, the CRC coprocessor and the
+// Transceive/MFAuthent commands. Commands complete at once, so every wait loop of the
+// driver sees its IRQ on the first poll and the transaction counts are the minimum a
+// real bus would see. The PICC answers REQA/WUPA, anticollision and SELECT on up to
+// two cascade levels, MIFARE Classic authentication with key A, READ and HLTA.
+// Crypto1 itself is not modelled, authenticated traffic goes in clear.
+
+#ifndef FAKE_PCD_H
+#define FAKE_PCD_H
+
+#include <mfrc522_i2c.h>
+#include <string.h>
+#include <vector>
+
+// CRC_A bit by bit (ISO/IEC 14443-3 annex B), on purpose not the byte wise form the
+// driver uses, so the two check each other.
+static inline uint16_t fakeCrcA(const byte *data, size_t len, uint16_t crc = 0x6363) {
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++) crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+  }
+  return crc;
+}
+
+class FakePicc {
+public:
+  enum State { IDLE, READY, ACTIVE, HALT };
+
+  byte uid[7];
+  byte uidSize;       // 4 (MIFARE Classic 1K) or 7 (Ultralight)
+  byte sak;
+  byte memory[64][16];
+  byte keyA[6];
+  State state = IDLE;
+  int authSector = -1;
+
+  FakePicc(const byte *id, byte size, byte selectAck) : uidSize(size), sak(selectAck) {
+    memcpy(uid, id, size);
+    memset(keyA, 0xFF, sizeof(keyA));
+    for (int b = 0; b < 64; b++)
+      for (int i = 0; i < 16; i++) memory[b][i] = (byte)(b * 16 + i);
+  }
+
+  bool authenticate(byte command, byte block, const byte *key, const byte *id) {
+    if (state != ACTIVE || command != MFRC522::PICC_CMD_MF_AUTH_KEY_A) return false;
+    if (memcmp(key, keyA, 6) != 0 || memcmp(id, levelUid(uidSize > 4 ? 2 : 1), 4) != 0) return false;
+    authSector = block / 4;
+    return true;
+  }
+
+  // Answer to a frame, false when the card stays silent
+  bool respond(const byte *tx, size_t len, byte txLastBits, std::vector<byte> &rx, byte &rxLastBits) {
+    rx.clear();
+    rxLastBits = 0;
+    if (txLastBits == 7 && len == 1) {
+      bool wake = tx[0] == MFRC522::PICC_CMD_WUPA && state == HALT;
+      if ((tx[0] == MFRC522::PICC_CMD_REQA && state == IDLE) || wake || (tx[0] == MFRC522::PICC_CMD_WUPA && state == IDLE)) {
+        state = READY;
+        level = 1;
+        authSector = -1;
+        rx = {byte(uidSize > 4 ? 0x44 : 0x04), 0x00};
+        return true;
+      }
+      return false;
+    }
+    if (txLastBits != 0 || len < 2) return false;
+
+    if (state == READY) {
+      byte sel = level == 1 ? MFRC522::PICC_CMD_SEL_CL1 : MFRC522::PICC_CMD_SEL_CL2;
+      if (tx[0] != sel) return false;
+      const byte *part = levelUid(level);
+      if (tx[1] == 0x20 && len == 2) {  // anticollision with no known bits
+        rx.assign(part, part + 4);
+        rx.push_back(part[0] ^ part[1] ^ part[2] ^ part[3]);
+        return true;
+      }
+      if (tx[1] == 0x70 && len == 9 && crcOk(tx, 9) && memcmp(tx + 2, part, 4) == 0) {
+        bool more = uidSize > 4 && level == 1;
+        if (more) level++;
+        else state = ACTIVE;
+        byte ack = more ? 0x04 : sak;
+        appendWithCrc(rx, &ack, 1);
+        return true;
+      }
+      return false;
+    }
+
+    if (state == ACTIVE && crcOk(tx, len)) {
+      if (tx[0] == MFRC522::PICC_CMD_HLTA && len == 4) {
+        state = HALT;
+        authSector = -1;
+        return false;
+      }
+      if (tx[0] == MFRC522::PICC_CMD_MF_READ && len == 4) {
+        byte block = tx[1];
+        bool classic = uidSize == 4;
+        if ((classic && (block >= 64 || block / 4 != authSector)) || (!classic && block >= 16)) {
+          rx = {0x04};  // NAK, 4 bits
+          rxLastBits = 4;
+          return true;
+        }
+        // Ultralight: 16 pages of 4 bytes, a read returns 4 pages and rolls back to page 0
+        const byte *pages = &memory[0][0];
+        byte data[16];
+        for (int i = 0; i < 16; i++) data[i] = classic ? memory[block][i] : pages[(block + i / 4) % 16 * 4 + i % 4];
+        appendWithCrc(rx, data, 16);
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  int level = 1;
+
+  const byte *levelUid(int l) const {
+    static byte part[4];
+    if (uidSize == 4) return uid;
+    if (l == 1) {
+      part[0] = MFRC522::PICC_CMD_CT;
+      memcpy(part + 1, uid, 3);
+      return part;
+    }
+    return uid + 3;
+  }
+  static bool crcOk(const byte *frame, size_t len) {
+    uint16_t crc = fakeCrcA(frame, len - 2);
+    return frame[len - 2] == (crc & 0xFF) && frame[len - 1] == (crc >> 8);
+  }
+  static void appendWithCrc(std::vector<byte> &rx, const byte *data, size_t len) {
+    rx.assign(data, data + len);
+    uint16_t crc = fakeCrcA(data, len);
+    rx.push_back(crc & 0xFF);
+    rx.push_back(crc >> 8);
+  }
+};
+
+class FakePcd : public MFRC522_Transport {
+public:
+  explicit FakePcd(FakePicc *card) : picc(card) { reset(); }
+
+  FakePicc *picc;        // NULL for an empty field
+  bool splitReads = false; // count a read as address write + read, like STOP + START
+
+  void writeRegister(byte address, byte reg, const byte *values, byte count) override {
+    (void)address;
+    stats.transactions++;
+    stats.bytes += count + 1;
+    for (byte i = 0; i < count; i++) write(reg, values[i]);
+  }
+
+  byte readRegister(byte address, byte reg, byte *values, byte count) override {
+    (void)address;
+    stats.transactions += splitReads ? 2 : 1;
+    stats.bytes += count + 1;
+    for (byte i = 0; i < count; i++) values[i] = read(reg);
+    return count;
+  }
+
+private:
+  byte regs[0x40];
+  std::vector<byte> fifo;
+
+  void reset() {
+    memset(regs, 0, sizeof(regs));
+    regs[MFRC522::CommandReg] = 0x20;
+    regs[MFRC522::ComIEnReg] = 0x80;
+    regs[MFRC522::ComIrqReg] = 0x14;
+    regs[MFRC522::ModeReg] = 0x3F;
+    regs[MFRC522::TxControlReg] = 0x80;
+    regs[MFRC522::VersionReg] = 0x92;
+    fifo.clear();
+  }
+
+  byte read(byte reg) {
+    reg &= 0x3F;
+    if (reg == MFRC522::FIFODataReg) {
+      if (fifo.empty()) return 0;
+      byte b = fifo.front();
+      fifo.erase(fifo.begin());
+      return b;
+    }
+    if (reg == MFRC522::FIFOLevelReg) return (byte)fifo.size();
+    return regs[reg];
+  }
+
+  void write(byte reg, byte value) {
+    reg &= 0x3F;
+    switch (reg) {
+      case MFRC522::FIFODataReg:
+        if (fifo.size() < MFRC522::FIFO_SIZE) fifo.push_back(value);
+        return;
+      case MFRC522::FIFOLevelReg:
+        if (value & 0x80) fifo.clear();
+        return;
+      case MFRC522::ComIrqReg:
+      case MFRC522::DivIrqReg:
+        // Set1/Set2 in bit 7 says whether the marked bits are set or cleared
+        if (value & 0x80) regs[reg] |= value & 0x7F;
+        else regs[reg] &= ~value;
+        return;
+      case MFRC522::CommandReg:
+        regs[reg] = value;
+        command(value & 0x0F);
+        return;
+      case MFRC522::BitFramingReg:
+        regs[reg] = value & 0x7F;
+        if ((value & 0x80) && (regs[MFRC522::CommandReg] & 0x0F) == MFRC522::PCD_Transceive) transceive();
+        return;
+      default:
+        regs[reg] = value;
+    }
+  }
+
+  void command(byte cmd) {
+    switch (cmd) {
+      case MFRC522::PCD_SoftReset:
+        reset();
+        regs[MFRC522::CommandReg] = 0x00;
+        return;
+      case MFRC522::PCD_CalcCRC: {
+        static const uint16_t presets[4] = {0x0000, 0x6363, 0xA671, 0xFFFF};
+        uint16_t crc = fakeCrcA(fifo.data(), fifo.size(), presets[regs[MFRC522::ModeReg] & 0x03]);
+        regs[MFRC522::CRCResultRegL] = crc & 0xFF;
+        regs[MFRC522::CRCResultRegH] = crc >> 8;
+        regs[MFRC522::DivIrqReg] |= 0x04;
+        return;
+      }
+      case MFRC522::PCD_MFAuthent:
+        if (picc && fifo.size() == 12 && picc->authenticate(fifo[0], fifo[1], &fifo[2], &fifo[8])) {
+          regs[MFRC522::Status2Reg] |= 0x08;
+          regs[MFRC522::ComIrqReg] |= 0x10;
+        } else {
+          regs[MFRC522::ComIrqReg] |= 0x01;  // the card never answers, the timer runs out
+        }
+        fifo.clear();
+        return;
+      default:
+        return;
+    }
+  }
+
+  void transceive() {
+    std::vector<byte> tx = fifo, rx;
+    byte rxLastBits = 0;
+    fifo.clear();
+    regs[MFRC522::ErrorReg] = 0;
+    if (picc && picc->respond(tx.data(), tx.size(), regs[MFRC522::BitFramingReg] & 0x07, rx, rxLastBits)) {
+      fifo = rx;
+      regs[MFRC522::ControlReg] = (regs[MFRC522::ControlReg] & 0xF8) | rxLastBits;
+      regs[MFRC522::ComIrqReg] |= 0x30;  // RxIRq, IdleIRq
+    } else {
+      regs[MFRC522::ComIrqReg] |= 0x01;  // TimerIRq
+    }
+  }
+};
+
+#endif
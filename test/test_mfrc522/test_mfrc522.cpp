@@ -0,0 +1,149 @@
+// Host tests for src/mfrc522_i2c.cpp against a simulated reader and card, run with:
+//   pio test -e native -f test_mfrc522
+// Also reports the I2C transactions each PICC operation costs. With the driver as it
+// was before the transport change (CRC_A on the coprocessor, read-modify-write FIFO
+// flush and StartSend, STOP + START register reads) the same fake counted:
+//   PICC_Select, 4 byte UID  75 (now 26)
+//   PICC_Select, 7 byte UID 147 (now 50)
+//   MIFARE_Read              49 (now 11)
+
+#include <unity.h>
+#include "fake_pcd.h"
+#include <stdio.h>
+
+static const byte classicUid[4] = {0xDE, 0xAD, 0xBE, 0xEF};
+static const byte ultralightUid[7] = {0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+
+static void report(const char *what, const MFRC522_Transport::Stats &s) {
+  char line[96];
+  snprintf(line, sizeof(line), "%s: %u I2C transactions, %u bytes", what, (unsigned)s.transactions, (unsigned)s.bytes);
+  TEST_MESSAGE(line);
+}
+
+// Wakes the card and selects it, returns the transactions PICC_Select took
+static uint32_t selectCard(MFRC522 &reader) {
+  TEST_ASSERT_TRUE(reader.PICC_IsNewCardPresent());
+  reader.PCD_ResetStats();
+  TEST_ASSERT_TRUE(reader.PICC_ReadCardSerial());
+  return reader.PCD_GetStats().transactions;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_crc_a_matches_coprocessor(void) {
+  FakePcd pcd(NULL);
+  MFRC522 reader(0x28, &pcd);
+  reader.PCD_Init();
+
+  // HLTA is the usual reference frame: 50 00 -> 57 CD
+  byte hlta[2] = {0x50, 0x00}, crc[2];
+  TEST_ASSERT_EQUAL(MFRC522::STATUS_OK, reader.PCD_CalculateCRC(hlta, 2, crc));
+  TEST_ASSERT_EQUAL_HEX8(0x57, crc[0]);
+  TEST_ASSERT_EQUAL_HEX8(0xCD, crc[1]);
+
+  // what the CRC coprocessor of the chip returns for the same data
+  byte data[18];
+  for (int len = 0; len <= 18; len++) {
+    for (int i = 0; i < len; i++) data[i] = (byte)(i * 37 + len);
+    reader.PCD_WriteRegister(MFRC522::CommandReg, MFRC522::PCD_Idle);
+    reader.PCD_WriteRegister(MFRC522::FIFOLevelReg, 0x80);
+    reader.PCD_WriteRegister(MFRC522::FIFODataReg, len, data);
+    reader.PCD_WriteRegister(MFRC522::CommandReg, MFRC522::PCD_CalcCRC);
+    TEST_ASSERT_TRUE(reader.PCD_ReadRegister(MFRC522::DivIrqReg) & 0x04);
+    reader.PCD_CalculateCRC(data, len, crc);
+    TEST_ASSERT_EQUAL_HEX8(reader.PCD_ReadRegister(MFRC522::CRCResultRegL), crc[0]);
+    TEST_ASSERT_EQUAL_HEX8(reader.PCD_ReadRegister(MFRC522::CRCResultRegH), crc[1]);
+  }
+}
+
+void test_select_4_byte_uid(void) {
+  FakePicc card(classicUid, 4, 0x08);
+  FakePcd pcd(&card);
+  MFRC522 reader(0x28, &pcd);
+  reader.PCD_Init();
+
+  uint32_t transactions = selectCard(reader);
+  report("PICC_Select, 4 byte UID", reader.PCD_GetStats());
+  TEST_ASSERT_EQUAL(4, reader.uid.size);
+  TEST_ASSERT_EQUAL_MEMORY(classicUid, reader.uid.uidByte, 4);
+  TEST_ASSERT_EQUAL_HEX8(0x08, reader.uid.sak);
+  TEST_ASSERT_EQUAL(MFRC522::PICC_TYPE_MIFARE_1K, reader.PICC_GetType(reader.uid.sak));
+  TEST_ASSERT_EQUAL(FakePicc::ACTIVE, card.state);
+  TEST_ASSERT_EQUAL(26, transactions);
+}
+
+void test_select_7_byte_uid(void) {
+  FakePicc card(ultralightUid, 7, 0x00);
+  FakePcd pcd(&card);
+  MFRC522 reader(0x28, &pcd);
+  reader.PCD_Init();
+
+  uint32_t transactions = selectCard(reader);
+  report("PICC_Select, 7 byte UID", reader.PCD_GetStats());
+  TEST_ASSERT_EQUAL(7, reader.uid.size);
+  TEST_ASSERT_EQUAL_MEMORY(ultralightUid, reader.uid.uidByte, 7);
+  TEST_ASSERT_EQUAL(MFRC522::PICC_TYPE_MIFARE_UL, reader.PICC_GetType(reader.uid.sak));
+  TEST_ASSERT_EQUAL(50, transactions);
+}
+
+void test_authenticate_and_read(void) {
+  FakePicc card(classicUid, 4, 0x08);
+  FakePcd pcd(&card);
+  MFRC522 reader(0x28, &pcd);
+  reader.PCD_Init();
+  selectCard(reader);
+
+  MFRC522::MIFARE_Key key;
+  memset(key.keyByte, 0xFF, sizeof(key.keyByte));
+  TEST_ASSERT_EQUAL(MFRC522::STATUS_OK, reader.PCD_Authenticate(MFRC522::PICC_CMD_MF_AUTH_KEY_A, 7, &key, &reader.uid));
+
+  byte buffer[18];
+  byte size = sizeof(buffer);
+  reader.PCD_ResetStats();
+  TEST_ASSERT_EQUAL(MFRC522::STATUS_OK, reader.MIFARE_Read(5, buffer, &size));
+  report("MIFARE_Read", reader.PCD_GetStats());
+  TEST_ASSERT_EQUAL(18, size);
+  TEST_ASSERT_EQUAL_MEMORY(card.memory[5], buffer, 16);
+  TEST_ASSERT_EQUAL(11, reader.PCD_GetStats().transactions);
+
+  // a block of another sector is refused with a NAK
+  size = sizeof(buffer);
+  TEST_ASSERT_EQUAL(MFRC522::STATUS_MIFARE_NACK, reader.MIFARE_Read(8, buffer, &size));
+}
+
+void test_wrong_key_and_halt(void) {
+  FakePicc card(classicUid, 4, 0x08);
+  FakePcd pcd(&card);
+  MFRC522 reader(0x28, &pcd);
+  reader.PCD_Init();
+  selectCard(reader);
+
+  MFRC522::MIFARE_Key key;
+  memset(key.keyByte, 0xA0, sizeof(key.keyByte));
+  TEST_ASSERT_EQUAL(MFRC522::STATUS_TIMEOUT, reader.PCD_Authenticate(MFRC522::PICC_CMD_MF_AUTH_KEY_A, 4, &key, &reader.uid));
+
+  TEST_ASSERT_EQUAL(MFRC522::STATUS_OK, reader.PICC_HaltA());
+  TEST_ASSERT_EQUAL(FakePicc::HALT, card.state);
+  TEST_ASSERT_FALSE(reader.PICC_IsNewCardPresent());  // REQA does not wake a halted card
+  byte atqa[2], size = sizeof(atqa);
+  TEST_ASSERT_EQUAL(MFRC522::STATUS_OK, reader.PICC_WakeupA(atqa, &size));
+}
+
+void test_empty_field(void) {
+  FakePcd pcd(NULL);
+  MFRC522 reader(0x28, &pcd);
+  reader.PCD_Init();
+  TEST_ASSERT_FALSE(reader.PICC_IsNewCardPresent());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_crc_a_matches_coprocessor);
+  RUN_TEST(test_select_4_byte_uid);
+  RUN_TEST(test_select_7_byte_uid);
+  RUN_TEST(test_authenticate_and_read);
+  RUN_TEST(test_wrong_key_and_halt);
+  RUN_TEST(test_empty_field);
+  return UNITY_END();
+}
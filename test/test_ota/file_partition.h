@@ -0,0 +1,113 @@
+// Partition backed by a file, standing in for Update so the OTA sink runs unchanged on
+// the host. Like Update it writes to a spare slot: begin() opens "<name>.new", end()
+// renames it over "<name>" (the image that boots next), abort() drops it and leaves the
+// running image alone. Writes past the partition size and, for U_FLASH, an image that
+// does not start with the ESP32 image magic byte fail with Update's error strings.
+
+#ifndef FILE_PARTITION_H
+#define FILE_PARTITION_H
+
+#include <ota_sink.h>
+#include <stdio.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define U_FLASH  0
+#define U_SPIFFS 100
+
+class FilePartition : public OtaTarget {
+public:
+  std::string path;
+  size_t capacity;
+  int command = -1;        // what begin() was given
+  size_t sizeGiven = 0;
+  int commits = 0;
+
+  FilePartition(const char *name, size_t size) : capacity(size) {
+    path = (std::filesystem::temp_directory_path() / name).string();
+    remove(path.c_str());
+    remove(spare().c_str());
+  }
+  ~FilePartition() {
+    if (file) fclose(file);
+    remove(path.c_str());
+    remove(spare().c_str());
+  }
+
+  bool begin(size_t size, int cmd) override {
+    command = cmd;
+    sizeGiven = size;
+    error = NULL;
+    if (size != OTA_SIZE_UNKNOWN && size > capacity) {
+      error = "Not Enough Space";
+      return false;
+    }
+    file = fopen(spare().c_str(), "wb");
+    written = 0;
+    return file != NULL;
+  }
+
+  size_t write(const uint8_t *data, size_t len) override {
+    if (!file || error) return 0;
+    if (written + len > capacity) {
+      error = "Not Enough Space";
+      return 0;
+    }
+    if (written == 0 && len && command == U_FLASH && data[0] != 0xE9) {
+      error = "Wrong Magic Byte";
+      return 0;
+    }
+    written += fwrite(data, 1, len, file);
+    return len;
+  }
+
+  // Update.end(true) takes what was written as the size, the sink checked it is all there
+  bool end() override {
+    if (!file || error) return false;
+    fclose(file);
+    file = NULL;
+    if (rename(spare().c_str(), path.c_str()) != 0) return false;
+    commits++;
+    return true;
+  }
+
+  void abort() override {
+    if (file) fclose(file);
+    file = NULL;
+    remove(spare().c_str());
+  }
+
+  const char *errorString() override { return error ? error : "No Error"; }
+
+  // The image that boots next, empty when nothing was ever committed
+  std::vector<uint8_t> image() const { return readFile(path); }
+  bool spareLeft() const { return std::filesystem::exists(spare()); }
+
+  // Puts an image in place as if it had been flashed before
+  void preload(const std::vector<uint8_t> &data) {
+    FILE *f = fopen(path.c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), f);
+    fclose(f);
+  }
+
+private:
+  FILE *file = NULL;
+  size_t written = 0;
+  const char *error = NULL;
+
+  std::string spare() const { return path + ".new"; }
+
+  static std::vector<uint8_t> readFile(const std::string &name) {
+    std::vector<uint8_t> data;
+    FILE *f = fopen(name.c_str(), "rb");
+    if (!f) return data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+    fclose(f);
+    return data;
+  }
+};
+
+#endif
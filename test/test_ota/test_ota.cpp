@@ -0,0 +1,316 @@
+// Host tests for the OTA sink in src/ota_sink.cpp against file-backed fake partitions,
+// run with:
+//   pio test -e native -f test_ota
+// installImage() and performOTA() feed the sink 4 KB at a time from their download
+// task; install() below does the same from memory, a resume keeps feeding the same sink.
+
+#include <unity.h>
+#include "file_partition.h"
+#include <string.h>
+#include <zlib.h>
+
+#define CHUNK 4096
+
+// An app image: the magic byte, then data that compresses somewhat, like code does
+static std::vector<uint8_t> makeImage(size_t size, uint32_t seed) {
+  std::vector<uint8_t> img(size);
+  uint32_t x = seed;
+  for (size_t i = 0; i < size; i++) {
+    x = x * 1103515245 + 12345;
+    img[i] = (x >> 16) % 4 == 0 ? (uint8_t)(x >> 24) : (uint8_t)(i / 64);
+  }
+  img[0] = 0xE9;
+  return img;
+}
+
+// gzip of data with the file name in the header, like "gzip firmware.bin" writes it,
+// allFields adds FEXTRA, FCOMMENT and FHCRC
+static std::vector<uint8_t> gzipOf(const std::vector<uint8_t> &data, bool allFields = false) {
+  z_stream z = z_stream();
+  deflateInit2(&z, 9, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  gz_header head = gz_header();
+  head.name = (Bytef *)"firmware.bin";
+  static uint8_t extra[300];
+  if (allFields) {
+    for (size_t i = 0; i < sizeof(extra); i++) extra[i] = i;
+    head.extra = extra;
+    head.extra_len = sizeof(extra);
+    head.comment = (Bytef *)"Bruce build";
+    head.hcrc = 1;
+  }
+  deflateSetHeader(&z, &head);
+  std::vector<uint8_t> out(deflateBound(&z, data.size()) + 64);
+  z.next_in = (Bytef *)data.data();
+  z.avail_in = data.size();
+  z.next_out = out.data();
+  z.avail_out = out.size();
+  TEST_ASSERT_EQUAL(Z_STREAM_END, deflate(&z, Z_FINISH));
+  out.resize(z.total_out);
+  deflateEnd(&z);
+  return out;
+}
+
+static void sha256Of(const std::vector<uint8_t> &data, uint8_t digest[32]) {
+  mbedtls_sha256_context ctx;
+  mbedtls_sha256_init(&ctx);
+  mbedtls_sha256_starts(&ctx, 0);
+  mbedtls_sha256_update(&ctx, data.data(), data.size());
+  mbedtls_sha256_finish(&ctx, digest);
+  mbedtls_sha256_free(&ctx);
+}
+
+// Feeds bytes [from, to) of the download in chunks, returns how many were fed
+static size_t feed(OtaSink &sink, const std::vector<uint8_t> &download, size_t from, size_t to) {
+  for (size_t pos = from; pos < to; pos += CHUNK) otaFeed(sink, download.data() + pos, to - pos < CHUNK ? to - pos : CHUNK);
+  return to - from;
+}
+
+static const char *install(FilePartition &part, const std::vector<uint8_t> &download, int command,
+                           const uint8_t *expected, size_t received = SIZE_MAX) {
+  OtaSink sink;
+  otaSinkBegin(sink, &part, download.size(), command);
+  received = feed(sink, download, 0, received < download.size() ? received : download.size());
+  return otaSinkFinish(sink, received, expected);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// FIPS 180-2 examples of one and two blocks, through parseSha256() and the sink: fed a
+// byte at a time and in one piece, so the hash runs across the writes like a download
+void test_sink_digest_matches_fips(void) {
+  static const char *vectors[][2] = {
+    { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad  abc.bin\n" },
+    { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+      "248D6A61D20638B8E5C026930C3E6039A33CE45964FF2167F6ECEDD419DB06C1" },
+  };
+  for (auto &v : vectors) {
+    uint8_t expected[32];
+    TEST_ASSERT_TRUE(parseSha256(v[1], expected));
+    std::vector<uint8_t> data((const uint8_t *)v[0], (const uint8_t *)v[0] + strlen(v[0]));
+    FilePartition fs("bruce_ota_fs", 4096);
+    OtaSink sink;
+    otaSinkBegin(sink, &fs, data.size(), U_SPIFFS);
+    for (uint8_t b : data) otaFeed(sink, &b, 1);
+    TEST_ASSERT_NULL(otaSinkFinish(sink, data.size(), expected));
+    TEST_ASSERT_NULL(install(fs, data, U_SPIFFS, expected));
+    expected[31] ^= 1;
+    TEST_ASSERT_EQUAL_STRING("SHA-256 mismatch, update discarded.", install(fs, data, U_SPIFFS, expected));
+  }
+  uint8_t out[32];
+  TEST_ASSERT_FALSE(parseSha256("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015a", out));   // 63 digits
+  TEST_ASSERT_FALSE(parseSha256("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f200 5ad", out));
+  TEST_ASSERT_FALSE(parseSha256("", out));
+}
+
+void test_gzip_header(void) {
+  std::vector<uint8_t> gz = gzipOf(makeImage(1000, 1));
+  TEST_ASSERT_EQUAL(10 + strlen("firmware.bin") + 1, gzipHeader(gz.data(), gz.size()));
+  static const uint8_t extra[] = {0x1F, 0x8B, 8, 0x04, 0, 0, 0, 0, 0, 3, 4, 0, 'a', 'b', 'c', 'd', 0x03};
+  TEST_ASSERT_EQUAL(16, gzipHeader(extra, sizeof(extra)));
+  TEST_ASSERT_EQUAL(-1, gzipHeader(extra, 8));                 // cut short
+  TEST_ASSERT_EQUAL(-1, gzipHeader(extra, 15));
+  static const uint8_t store[] = {0x1F, 0x8B, 0, 0, 0, 0, 0, 0, 0, 3, 0};
+  TEST_ASSERT_EQUAL(-1, gzipHeader(store, sizeof(store)));     // not deflate
+  static const uint8_t reserved[] = {0x1F, 0x8B, 8, 0x20, 0, 0, 0, 0, 0, 3, 0};
+  TEST_ASSERT_EQUAL(-1, gzipHeader(reserved, sizeof(reserved)));
+}
+
+void test_raw_image(void) {
+  FilePartition app("bruce_ota_app", 256 * 1024);
+  std::vector<uint8_t> img = makeImage(200 * 1024 + 123, 2);
+  uint8_t digest[32];
+  sha256Of(img, digest);
+  TEST_ASSERT_NULL(install(app, img, U_FLASH, digest));
+  TEST_ASSERT_EQUAL(U_FLASH, app.command);
+  TEST_ASSERT_EQUAL(img.size(), app.sizeGiven);
+  TEST_ASSERT_EQUAL(1, app.commits);
+  TEST_ASSERT_TRUE(app.image() == img);
+  TEST_ASSERT_FALSE(app.spareLeft());
+}
+
+void test_gzip_image(void) {
+  FilePartition app("bruce_ota_app", 256 * 1024);
+  std::vector<uint8_t> img = makeImage(200 * 1024, 3);
+  std::vector<uint8_t> gz = gzipOf(img);
+  TEST_ASSERT_TRUE(gz.size() < img.size());
+  uint8_t digest[32];
+  sha256Of(img, digest);   // the digest is of the image, not of the download
+  TEST_ASSERT_NULL(install(app, gz, U_FLASH, digest));
+  TEST_ASSERT_EQUAL(OTA_SIZE_UNKNOWN, app.sizeGiven);
+  TEST_ASSERT_TRUE(app.image() == img);
+}
+
+// Matches reaching almost the whole 32 KB window back, fed in odd sized chunks: copies
+// start before the end of the sink's circular dictionary and finish after it wraps.
+// The first chunk is a single byte, the magic number comes in two writes.
+void test_gzip_dictionary_wraps(void) {
+  FilePartition app("bruce_ota_app", 256 * 1024);
+  std::vector<uint8_t> img = makeImage(160 * 1024, 12);
+  for (size_t i = 0; i + 32000 < img.size(); i += 32000 + 7)
+    for (size_t j = 1; j < 300 && i + 32000 + j < img.size(); j++) img[i + 32000 + j] = img[i + j];
+  std::vector<uint8_t> gz = gzipOf(img);
+  uint8_t digest[32];
+  sha256Of(img, digest);
+  OtaSink sink;
+  otaSinkBegin(sink, &app, gz.size(), U_FLASH);
+  size_t pos = 0;
+  for (size_t n = 1; pos < gz.size(); n = n * 7 % 5003 + 1) {
+    size_t len = n < gz.size() - pos ? n : gz.size() - pos;
+    otaFeed(sink, gz.data() + pos, len);
+    pos += len;
+  }
+  TEST_ASSERT_NULL(otaSinkFinish(sink, pos, digest));
+  TEST_ASSERT_TRUE(app.image() == img);
+}
+
+// Every header field and the trailer split over one byte writes
+void test_gzip_header_and_trailer_split(void) {
+  std::vector<uint8_t> img = makeImage(50 * 1024, 13);
+  std::vector<uint8_t> gz = gzipOf(img, true);
+  TEST_ASSERT_EQUAL(10 + 2 + 300 + strlen("firmware.bin") + 1 + strlen("Bruce build") + 1 + 2,
+                    gzipHeader(gz.data(), gz.size()));
+  FilePartition app("bruce_ota_app", 256 * 1024);
+  OtaSink sink;
+  otaSinkBegin(sink, &app, gz.size(), U_FLASH);
+  for (size_t i = 0; i < 400; i++) otaFeed(sink, &gz[i], 1);
+  feed(sink, gz, 400, gz.size() - 8);
+  for (size_t i = gz.size() - 8; i < gz.size(); i++) otaFeed(sink, &gz[i], 1);
+  TEST_ASSERT_NULL(otaSinkFinish(sink, gz.size(), NULL));
+  TEST_ASSERT_TRUE(app.image() == img);
+
+  // a raw image whose magic byte comes alone
+  std::vector<uint8_t> raw = makeImage(10 * 1024, 14);
+  otaSinkBegin(sink, &app, raw.size(), U_FLASH);
+  otaFeed(sink, raw.data(), 1);
+  feed(sink, raw, 1, raw.size());
+  TEST_ASSERT_NULL(otaSinkFinish(sink, raw.size(), NULL));
+  TEST_ASSERT_TRUE(app.image() == raw);
+}
+
+// Without a published digest the gzip CRC-32 and ISIZE are all that catch a bad image
+void test_gzip_trailer_is_checked(void) {
+  FilePartition app("bruce_ota_app", 256 * 1024);
+  std::vector<uint8_t> old = makeImage(100 * 1024, 15);
+  std::vector<uint8_t> img = makeImage(60 * 1024, 16);
+  app.preload(old);
+  std::vector<uint8_t> gz = gzipOf(img);
+
+  std::vector<uint8_t> bad = gz;
+  bad[bad.size() - 8] ^= 0x01;   // CRC-32
+  TEST_ASSERT_EQUAL_STRING("Corrupted gzip image.", install(app, bad, U_FLASH, NULL));
+  bad = gz;
+  bad[bad.size() - 4] ^= 0x01;   // ISIZE
+  TEST_ASSERT_EQUAL_STRING("Corrupted gzip image.", install(app, bad, U_FLASH, NULL));
+  TEST_ASSERT_NOT_NULL(strstr(install(app, gz, U_FLASH, NULL, gz.size() - 3), "Written only"));
+  TEST_ASSERT_TRUE(app.image() == old);
+  TEST_ASSERT_EQUAL(0, app.commits);
+}
+
+void test_littlefs_image(void) {
+  FilePartition fs("bruce_ota_fs", 128 * 1024);
+  std::vector<uint8_t> img = makeImage(128 * 1024, 4);
+  img[0] = 0x00;           // a filesystem has no app header
+  TEST_ASSERT_NULL(install(fs, img, U_SPIFFS, NULL));
+  TEST_ASSERT_EQUAL(U_SPIFFS, fs.command);
+  TEST_ASSERT_TRUE(fs.image() == img);
+}
+
+void test_truncated_download_keeps_running_image(void) {
+  FilePartition app("bruce_ota_app", 256 * 1024);
+  std::vector<uint8_t> old = makeImage(100 * 1024, 5);
+  std::vector<uint8_t> img = makeImage(150 * 1024, 6);
+  app.preload(old);
+
+  TEST_ASSERT_EQUAL_STRING("Written only: 81920/153600. Retry?", install(app, img, U_FLASH, NULL, 80 * 1024));
+  TEST_ASSERT_TRUE(app.image() == old);
+  TEST_ASSERT_FALSE(app.spareLeft());
+
+  // a gzip image without the end of its deflate stream
+  std::vector<uint8_t> gz = gzipOf(img);
+  TEST_ASSERT_NOT_NULL(strstr(install(app, gz, U_FLASH, NULL, gz.size() / 2), "Written only"));
+  TEST_ASSERT_TRUE(app.image() == old);
+  TEST_ASSERT_EQUAL(0, app.commits);
+}
+
+void test_resumed_download(void) {
+  // performOTA() keeps the sink across Range requests, a gzip stream goes on inflating
+  FilePartition app("bruce_ota_app", 256 * 1024);
+  std::vector<uint8_t> img = makeImage(180 * 1024, 7);
+  std::vector<uint8_t> gz = gzipOf(img);
+  uint8_t digest[32];
+  sha256Of(img, digest);
+  OtaSink sink;
+  otaSinkBegin(sink, &app, gz.size(), U_FLASH);
+  size_t received = feed(sink, gz, 0, 10000);
+  received += feed(sink, gz, received, gz.size());
+  TEST_ASSERT_NULL(otaSinkFinish(sink, received, digest));
+  TEST_ASSERT_TRUE(app.image() == img);
+}
+
+void test_sha_mismatch_is_discarded(void) {
+  FilePartition app("bruce_ota_app", 256 * 1024);
+  std::vector<uint8_t> old = makeImage(100 * 1024, 8);
+  std::vector<uint8_t> img = makeImage(120 * 1024, 9);
+  app.preload(old);
+  uint8_t digest[32];
+  sha256Of(img, digest);
+  img[img.size() / 2] ^= 0x10;   // one bit flipped on the way
+  TEST_ASSERT_EQUAL_STRING("SHA-256 mismatch, update discarded.", install(app, img, U_FLASH, digest));
+  TEST_ASSERT_TRUE(app.image() == old);
+  TEST_ASSERT_FALSE(app.spareLeft());
+
+  std::vector<uint8_t> gz = gzipOf(img);
+  TEST_ASSERT_EQUAL_STRING("SHA-256 mismatch, update discarded.", install(app, gz, U_FLASH, digest));
+  TEST_ASSERT_TRUE(app.image() == old);
+}
+
+void test_image_larger_than_partition(void) {
+  FilePartition app("bruce_ota_app", 64 * 1024);
+  std::vector<uint8_t> img = makeImage(64 * 1024 + 1, 10);
+  TEST_ASSERT_EQUAL_STRING("Not enough space to begin OTA update", install(app, img, U_FLASH, NULL));
+  TEST_ASSERT_TRUE(app.image().empty());
+
+  // the size of a gzip image is only known once it is inflated
+  TEST_ASSERT_EQUAL_STRING("Not Enough Space", install(app, gzipOf(img), U_FLASH, NULL));
+  TEST_ASSERT_TRUE(app.image().empty());
+  TEST_ASSERT_FALSE(app.spareLeft());
+}
+
+void test_bad_images(void) {
+  FilePartition app("bruce_ota_app", 64 * 1024);
+  std::vector<uint8_t> img = makeImage(32 * 1024, 11);
+  img[0] = 0x00;
+  TEST_ASSERT_EQUAL_STRING("Wrong Magic Byte", install(app, img, U_FLASH, NULL));
+
+  img[0] = 0xE9;
+  std::vector<uint8_t> gz = gzipOf(img);
+  size_t body = gzipHeader(gz.data(), gz.size());
+  gz[body] = 0x07;         // final block of the reserved type 3
+  TEST_ASSERT_EQUAL_STRING("Corrupted gzip image.", install(app, gz, U_FLASH, NULL));
+
+  gz[3] = 0x04;            // FEXTRA longer than the download
+  gz[10] = 0xFF;
+  gz[11] = 0xFF;
+  TEST_ASSERT_EQUAL_STRING("Bad gzip header.", install(app, gz, U_FLASH, NULL));
+  TEST_ASSERT_TRUE(app.image().empty());
+  TEST_ASSERT_EQUAL(0, app.commits);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sink_digest_matches_fips);
+  RUN_TEST(test_gzip_header);
+  RUN_TEST(test_raw_image);
+  RUN_TEST(test_gzip_image);
+  RUN_TEST(test_gzip_dictionary_wraps);
+  RUN_TEST(test_gzip_header_and_trailer_split);
+  RUN_TEST(test_gzip_trailer_is_checked);
+  RUN_TEST(test_littlefs_image);
+  RUN_TEST(test_truncated_download_keeps_running_image);
+  RUN_TEST(test_resumed_download);
+  RUN_TEST(test_sha_mismatch_is_discarded);
+  RUN_TEST(test_image_larger_than_partition);
+  RUN_TEST(test_bad_images);
+  return UNITY_END();
+}
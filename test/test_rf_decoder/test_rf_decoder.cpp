@@ -0,0 +1,223 @@
+// Host tests for src/rf_decoder.cpp, run with: pio test -e native -f test_rf_decoder
+// The .rfp fixtures come from make_fixtures.py in this directory.
+
+#include <unity.h>
+#include <rf_decoder.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define FIXTURES "test/test_rf_decoder/"
+
+struct Burst {
+  uint32_t timeMs;
+  std::vector<RfPulse> pulses;
+};
+
+static size_t readVarint(const std::vector<uint8_t> &data, size_t &pos, uint32_t &value) {
+  value = 0;
+  for (int shift = 0; pos < data.size() && shift < 35; shift += 7) {
+    uint8_t b = data[pos++];
+    value |= (uint32_t)(b & 0x7F) << shift;
+    if (b < 0x80) return pos;
+  }
+  return 0;
+}
+
+// Same pairing as rmtToPulses() in rf.cpp: a leading space is dropped, marks in a
+// row are merged and the last mark of a burst has no space.
+static void addDuration(std::vector<RfPulse> &out, bool mark, uint32_t us) {
+  if (mark) {
+    if (!out.empty() && out.back().space == 0) out.back().mark = rfPulseAdd(out.back().mark, us);
+    else out.push_back({rfPulseAdd(0, us), 0});
+  } else if (!out.empty()) {
+    out.back().space = rfPulseAdd(out.back().space, us);
+  }
+}
+
+static std::vector<Burst> loadRfp(const char *name) {
+  std::vector<Burst> bursts;
+  std::string path = std::string(FIXTURES) + name;
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) {
+    TEST_FAIL_MESSAGE(("can't open " + path).c_str());
+    return bursts;
+  }
+  std::vector<uint8_t> data;
+  uint8_t chunk[512];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) data.insert(data.end(), chunk, chunk + n);
+  fclose(f);
+
+  TEST_ASSERT_TRUE(data.size() >= 12 && memcmp(data.data(), "RFP1", 4) == 0);
+  uint32_t tickNs = data[4] | data[5] << 8 | data[6] << 16 | (uint32_t)data[7] << 24;
+  size_t end = data.size();
+  if (end >= 28 && memcmp(&data[end - 4], "RFPX", 4) == 0)
+    end = data[end - 16] | data[end - 15] << 8 | data[end - 14] << 16 | (uint32_t)data[end - 13] << 24;
+
+  size_t pos = 12;
+  uint32_t timeMs = 0;
+  while (pos < end) {
+    uint32_t dt, count, v;
+    if (!readVarint(data, pos, dt) || !readVarint(data, pos, count) || pos >= end) break;
+    bool mark = data[pos++];
+    int32_t prev[2] = {0, 0};
+    Burst b;
+    timeMs += dt;
+    b.timeMs = timeMs;
+    for (uint32_t k = 0; k < count; k++) {
+      if (!readVarint(data, pos, v)) break;
+      int32_t d = prev[k & 1] + (int32_t)((v >> 1) ^ -(v & 1));
+      prev[k & 1] = d;
+      addDuration(b.pulses, mark, (uint64_t)d * tickNs / 1000);
+      mark = !mark;
+    }
+    bursts.push_back(b);
+  }
+  return bursts;
+}
+
+static std::vector<RfPulse> pwmFrame(uint64_t code, uint8_t bits, uint16_t shortUs, uint16_t longUs) {
+  std::vector<RfPulse> p;
+  for (int i = bits - 1; i >= 0; i--) {
+    bool bit = (code >> i) & 1;
+    p.push_back({bit ? longUs : shortUs, bit ? shortUs : longUs});
+  }
+  p.push_back({shortUs, 0});
+  return p;
+}
+
+static std::vector<RfPulse> ppmFrame(uint64_t code, uint8_t bits, uint16_t mark, uint16_t shortUs, uint16_t longUs) {
+  std::vector<RfPulse> p;
+  for (int i = bits - 1; i >= 0; i--) p.push_back({mark, ((code >> i) & 1) ? longUs : shortUs});
+  p.push_back({mark, 0});
+  return p;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_ev1527_frame(void) {
+  std::vector<RfPulse> p = pwmFrame(0xA5C3E2, 24, 350, 1050);
+  RfMessage msg;
+  char line[48];
+  TEST_ASSERT_TRUE(rfDecodeFrame(p.data(), p.size(), msg));
+  TEST_ASSERT_EQUAL_STRING("EV1527/PT2262", rfProtocols[msg.protocol].name);
+  TEST_ASSERT_EQUAL_UINT8(24, msg.bits);
+  TEST_ASSERT_EQUAL_UINT32(0xA5C3E2, (uint32_t)msg.data);
+  rfFormatMessage(msg, line, sizeof(line));
+  TEST_ASSERT_EQUAL_STRING("EV1527 A5C3E btn 2", line);
+}
+
+void test_nexus_negative_temperature(void) {
+  uint64_t code = 0x5AULL << 28 | 1ULL << 27 | 1ULL << 24 | (uint64_t)(-35 & 0xFFF) << 12 | 0xF << 8 | 91;
+  std::vector<RfPulse> p = ppmFrame(code, 36, 500, 1000, 2000);
+  RfMessage msg;
+  char line[48];
+  TEST_ASSERT_TRUE(rfDecodeFrame(p.data(), p.size(), msg));
+  TEST_ASSERT_EQUAL_STRING("Nexus-TH", rfProtocols[msg.protocol].name);
+  rfFormatMessage(msg, line, sizeof(line));
+  TEST_ASSERT_EQUAL_STRING("Nexus id90 ch2 -3.5C 91%", line);
+}
+
+void test_rejects_short_and_off_timing(void) {
+  RfMessage msg;
+  std::vector<RfPulse> p = pwmFrame(0x5A, 8, 350, 1050);
+  TEST_ASSERT_FALSE(rfDecodeFrame(p.data(), 4, msg));  // under 8 pulses
+
+  // 30% off every protocol: EV1527 allows 35% of 350, so use a long that no table entry has
+  p = pwmFrame(0xA5C3E2, 24, 350, 1700);
+  TEST_ASSERT_FALSE(rfDecodeFrame(p.data(), p.size(), msg));
+
+  // one broken pulse in the middle fails the whole frame
+  p = pwmFrame(0xA5C3E2, 24, 350, 1050);
+  p[10].space = 5000;
+  TEST_ASSERT_FALSE(rfDecodeFrame(p.data(), p.size(), msg));
+}
+
+void test_long_pulses_saturate(void) {
+  // a 70 ms gap used to wrap to 4.5 ms, a plausible sync space for some remotes
+  std::vector<RfPulse> p;
+  addDuration(p, true, 350);
+  addDuration(p, false, 40000);
+  addDuration(p, false, 30000);
+  TEST_ASSERT_EQUAL(RF_PULSE_MAX, p[0].space);
+  addDuration(p, true, 65000);
+  addDuration(p, true, 1000);   // merged into the mark before
+  TEST_ASSERT_EQUAL(2, p.size());
+  TEST_ASSERT_EQUAL(RF_PULSE_MAX, p[1].mark);
+  TEST_ASSERT_EQUAL(RF_PULSE_MAX, rfPulseAdd(RF_PULSE_MAX, 0xFFFFFFF0));
+  TEST_ASSERT_EQUAL(RF_PULSE_MAX - 1, rfPulseAdd(RF_PULSE_MAX - 2, 1));
+}
+
+void test_fixture_ev1527(void) {
+  std::vector<Burst> bursts = loadRfp("ev1527.rfp");
+  TEST_ASSERT_EQUAL(14, bursts.size());
+  uint32_t codes[2] = {0, 0};
+  int decoded = 0;
+  for (const Burst &b : bursts) {
+    RfMessage msg;
+    if (!rfDecodeFrame(b.pulses.data(), b.pulses.size(), msg)) continue;
+    TEST_ASSERT_EQUAL_STRING("EV1527/PT2262", rfProtocols[msg.protocol].name);
+    codes[decoded / 6] = (uint32_t)msg.data;
+    decoded++;
+  }
+  TEST_ASSERT_EQUAL(12, decoded);  // the noise bursts give nothing
+  TEST_ASSERT_EQUAL_HEX32(0xA5C3E2, codes[0]);
+  TEST_ASSERT_EQUAL_HEX32(0x3F0871, codes[1]);
+}
+
+void test_fixture_nexus(void) {
+  std::vector<Burst> bursts = loadRfp("nexus.rfp");
+  TEST_ASSERT_EQUAL(22, bursts.size());
+  int decoded = 0;
+  char line[48];
+  for (const Burst &b : bursts) {
+    RfMessage msg;
+    if (!rfDecodeFrame(b.pulses.data(), b.pulses.size(), msg)) continue;
+    rfFormatMessage(msg, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING(decoded < 10 ? "Nexus id90 ch2 21.7C 48%" : "Nexus id90 ch2 -3.5C 91%", line);
+    decoded++;
+  }
+  TEST_ASSERT_EQUAL(20, decoded);
+}
+
+// Not a pass/fail check, prints what the decoder costs per frame on this host.
+// Worst case is a frame no protocol takes, every table entry gets tried.
+void test_throughput(void) {
+  std::vector<Burst> bursts = loadRfp("ev1527.rfp");
+  std::vector<Burst> more = loadRfp("nexus.rfp");
+  bursts.insert(bursts.end(), more.begin(), more.end());
+
+  const int rounds = 20000;
+  uint32_t frames = 0, pulses = 0, decoded = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    for (const Burst &b : bursts) {
+      RfMessage msg;
+      decoded += rfDecodeFrame(b.pulses.data(), b.pulses.size(), msg);
+      frames++;
+      pulses += b.pulses.size();
+    }
+  }
+  double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  char report[128];
+  snprintf(report, sizeof(report), "%u frames, %u pulses in %.3f s: %.0f frames/s, %.1f Mpulses/s, %.2f us/frame",
+           frames, pulses, s, frames / s, pulses / s / 1e6, s * 1e6 / frames);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_EQUAL(32 * rounds, decoded);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_ev1527_frame);
+  RUN_TEST(test_nexus_negative_temperature);
+  RUN_TEST(test_rejects_short_and_off_timing);
+  RUN_TEST(test_long_pulses_saturate);
+  RUN_TEST(test_fixture_ev1527);
+  RUN_TEST(test_fixture_nexus);
+  RUN_TEST(test_throughput);
+  return UNITY_END();
+}
@@ -0,0 +1,130 @@
+// Host tests for src/rle.h and the assets tools/rle_assets.py generates, run with:
+// pio test -e native -f test_rle
+// The boot logo in src/assets.h is decoded and compared pixel for pixel with the XBM it
+// was made from (media/xbm). Then it is drawn on host_fb.h framebuffers two ways:
+//   before: drawXBitmap() with a background, one drawPixel per pixel
+//   after:  rleDraw(), one window and a pushBlock per span
+// and both must give the same picture, on screen and partly off screen.
+
+#include <stdint.h>
+
+// StickC Plus2 / Cardputer screen
+#define WIDTH  240
+#define HEIGHT 135
+
+#include <unity.h>
+#include "host_fb.h"
+#include <rle.h>
+#include <assets.h>
+#include "../../media/xbm/bruce_logo.xbm"
+#include <chrono>
+#include <vector>
+
+#define SPI_HZ 20000000   // SPI_FREQUENCY of all three boards
+#define FG 0xA80F
+#define BG 0x0000
+
+static bool xbmPixel(const uint8_t *bits, int w, int x, int y) {
+  return bits[y * ((w + 7) / 8) + x / 8] & (1 << (x & 7));
+}
+
+// TFT_eSPI::drawXBitmap(x, y, bitmap, w, h, color, bgcolor)
+template <class Gfx>
+static void drawXBitmap(Gfx &gfx, int x, int y, const uint8_t *bitmap, int w, int h, uint16_t color, uint16_t bgcolor) {
+  for (int j = 0; j < h; j++)
+    for (int i = 0; i < w; i++)
+      gfx.drawPixel(x + i, y + j, xbmPixel(bitmap, w, i, j) ? color : bgcolor);
+}
+
+static HostFb rle, xbm;
+
+void setUp(void) {
+  rle.fillScreen(0x1234);
+  xbm.fillScreen(0x1234);
+}
+void tearDown(void) {}
+
+void test_logo_matches_xbm(void) {
+  TEST_ASSERT_EQUAL(bruce_logo_width, bruce_logo.width);
+  TEST_ASSERT_EQUAL(bruce_logo_height, bruce_logo.height);
+  std::vector<bool> pixels;
+  rleDecode(bruce_logo, [&](bool set, uint32_t n) { pixels.insert(pixels.end(), n, set); });
+  TEST_ASSERT_EQUAL(bruce_logo.width * bruce_logo.height, pixels.size());
+  for (int y = 0; y < bruce_logo.height; y++)
+    for (int x = 0; x < bruce_logo.width; x++)
+      if (pixels[y * bruce_logo.width + x] != xbmPixel(bruce_logo_bits, bruce_logo.width, x, y)) {
+        char where[48];
+        snprintf(where, sizeof(where), "pixel %d,%d differs", x, y);
+        TEST_FAIL_MESSAGE(where);
+      }
+}
+
+// Runs, literals that go over the end of a row and a varint of two bytes
+void test_tokens(void) {
+  static const uint8_t data[] PROGMEM = {
+    (5 << 2) | 1,              // 5 set
+    (6 << 2) | RLE_LITERAL,    // 6 literal: set clear clear set set clear
+    0x19,
+    0x80, 0x01,                // 32 clear, 32 << 2 = 128 needs two bytes
+    (7 << 2) | 1,              // 7 set
+  };
+  static const RleImage img = { 10, 5, sizeof(data), data };
+  std::vector<bool> pixels;
+  int spans = 0;
+  rleDecode(img, [&](bool set, uint32_t n) { pixels.insert(pixels.end(), n, set); spans++; });
+  const bool expected[50] = {1,1,1,1,1, 1,0,0,1,1, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0,0,0, 0,0,0, 1,1,1,1,1,1,1};
+  TEST_ASSERT_EQUAL(50, pixels.size());
+  for (int i = 0; i < 50; i++) TEST_ASSERT_EQUAL(expected[i], pixels[i]);
+  TEST_ASSERT_EQUAL(7, spans);   // a literal gives a span per change of colour
+}
+
+void test_clipped_draw_matches_xbm(void) {
+  const int at[][2] = { { -20, 4 }, { 30, -7 }, { 10, 40 }, { -300, 0 } };
+  for (auto &p : at) {
+    setUp();
+    rleDraw(rle, p[0], p[1], bruce_logo, FG, BG);
+    drawXBitmap(xbm, p[0], p[1], bruce_logo_bits, bruce_logo_width, bruce_logo_height, FG, BG);
+    TEST_ASSERT_TRUE(rle == xbm);
+  }
+}
+
+void test_draw_benchmark(void) {
+  rle.resetCounts();
+  rleDraw(rle, 1, 1, bruce_logo, FG, BG);
+  xbm.resetCounts();
+  drawXBitmap(xbm, 1, 1, bruce_logo_bits, bruce_logo_width, bruce_logo_height, FG, BG);
+  TEST_ASSERT_TRUE(rle == xbm);
+
+  // CPU side of the draw: reading the pixels out of flash, without the bus
+  const int rounds = 200;
+  volatile uint32_t sink = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) rleDecode(bruce_logo, [&](bool set, uint32_t n) { sink = sink + n; });
+  double rleSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++)
+    for (int y = 0; y < bruce_logo_height; y++)
+      for (int x = 0; x < bruce_logo_width; x++) sink = sink + xbmPixel(bruce_logo_bits, bruce_logo_width, x, y);
+  double xbmSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  char line[160];
+  snprintf(line, sizeof(line), "logo %ux%u, flash %u -> %u bytes, bus bytes %llu -> %llu (%u windows -> %u)",
+           bruce_logo.width, bruce_logo.height, (unsigned)sizeof(bruce_logo_bits), (unsigned)bruce_logo.size,
+           (unsigned long long)xbm.busBytes(), (unsigned long long)rle.busBytes(), xbm.windows, rle.windows);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "draw time at %u MHz SPI: drawXBitmap %.2f ms -> drawRle %.2f ms, host decode %.0f us -> %.0f us",
+           SPI_HZ / 1000000, xbm.busBytes() * 8e3 / SPI_HZ, rle.busBytes() * 8e3 / SPI_HZ,
+           xbmSec * 1e6 / rounds, rleSec * 1e6 / rounds);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_EQUAL(1, rle.windows);
+  TEST_ASSERT_TRUE(rle.busBytes() * 3 < xbm.busBytes());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_logo_matches_xbm);
+  RUN_TEST(test_tokens);
+  RUN_TEST(test_clipped_draw_matches_xbm);
+  RUN_TEST(test_draw_benchmark);
+  return UNITY_END();
+}
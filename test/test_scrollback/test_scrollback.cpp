@@ -0,0 +1,157 @@
+// Host tests and a benchmark for src/scrollback.cpp and the terminal's scroll out hook,
+// run with: pio test -e native -f test_scrollback
+// The benchmark fills the 256 KB PSRAM ring with shell-like 40 column output (the
+// Cardputer terminal is 40x16 cells) and reports memory per line and how long a search
+// over the whole ring takes, in the 256 line steps the clients run between frames.
+
+#include <unity.h>
+#include <scrollback.h>
+#include <terminal.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define COLS 40
+
+static void pushTo(const TermCell *row, uint8_t cols, void *ctx) {
+  ((Scrollback *)ctx)->push(row, cols);
+}
+
+static void pushText(Scrollback &sb, const char *text) {
+  TermCell row[COLS];
+  for (int x = 0; x < COLS; x++) row[x] = {' ', TERM_DEFAULT_FG, TERM_DEFAULT_BG, 0};
+  for (int x = 0; x < COLS && text[x]; x++) row[x].ch = text[x];
+  sb.push(row, COLS);
+}
+
+static std::string lineAt(const Scrollback &sb, uint32_t back) {
+  char text[SCROLLBACK_LINE_MAX + 1];
+  if (!sb.line(back, text, sizeof(text))) return "<gone>";
+  return text;
+}
+
+// Alternating ls -l, dmesg and prompt lines, numbered so every line is different
+static void shellLine(uint32_t i, char *out, size_t max) {
+  switch (i % 3) {
+    case 0: snprintf(out, max, "-rw-r--r--  1 root %6u log%u.txt", i * 37 % 100000, i); break;
+    case 1: snprintf(out, max, "[%5u.%03u] wlan0: assoc id %u", i / 10, i % 1000, i % 97); break;
+    default: snprintf(out, max, "root@bruce:~# cat   /tmp/%u", i); break;
+  }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Only a line feed scrolling the whole screen feeds the scrollback. Scroll regions,
+// DL at the top row and SU rearrange the screen and must not copy rows into history.
+void test_only_full_screen_line_feeds_scroll_out(void) {
+  static uint8_t mem[4096];
+  Scrollback sb(mem, sizeof(mem));
+  Terminal t(COLS, 4);
+  t.onScrollOut(pushTo, &sb);
+
+  t.write("one\r\ntwo\r\nthree\r\nfour");
+  TEST_ASSERT_EQUAL(0, sb.count());
+  t.write("\r\nfive\r\nsix");
+  TEST_ASSERT_EQUAL(2, sb.count());
+  TEST_ASSERT_EQUAL_STRING("two", lineAt(sb, 0).c_str());
+  TEST_ASSERT_EQUAL_STRING("one", lineAt(sb, 1).c_str());
+
+  t.write("\x1b[1;3r\x1b[3;1H\nstatus\n\n");    // region from the top row, not the whole screen
+  TEST_ASSERT_EQUAL(2, sb.count());
+  t.write("\x1b[r\x1b[1;1H\x1b[M\x1b[2M");        // DL at the top row
+  TEST_ASSERT_EQUAL(2, sb.count());
+  t.write("\x1b[S\x1b[3S");                       // SU
+  TEST_ASSERT_EQUAL(2, sb.count());
+  TEST_ASSERT_EQUAL(2, t.getStats().scrolls);
+
+  t.write("\x1b[2J\x1b[Hseven\r\n\r\n\r\n\r\neight");  // back to a plain shell
+  TEST_ASSERT_EQUAL(3, sb.count());
+  TEST_ASSERT_EQUAL_STRING("seven", lineAt(sb, 0).c_str());
+}
+
+void test_lines_round_trip_and_evict(void) {
+  static uint8_t mem[1024];
+  Scrollback sb(mem, sizeof(mem));
+  char text[64];
+  for (uint32_t i = 0; i < 200; i++) {
+    shellLine(i, text, sizeof(text));
+    pushText(sb, text);
+    TEST_ASSERT_TRUE(sb.bytesUsed() <= sb.capacity());
+  }
+  TEST_ASSERT_EQUAL(200, sb.pushed());
+  TEST_ASSERT_TRUE(sb.count() < 200);
+  for (uint32_t back = 0; back < sb.count(); back++) {
+    shellLine(199 - back, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING(text, lineAt(sb, back).c_str());
+  }
+  TEST_ASSERT_EQUAL_STRING("<gone>", lineAt(sb, sb.count()).c_str());
+
+  // the one pass walk sees the same lines oldest first
+  char walked[SCROLLBACK_LINE_MAX + 1];
+  uint32_t pos = sb.oldest();
+  for (uint32_t i = 0; i < sb.count(); i++) {
+    pos = sb.next(pos, walked, sizeof(walked));
+    TEST_ASSERT_EQUAL_STRING(lineAt(sb, sb.count() - 1 - i).c_str(), walked);
+  }
+}
+
+void test_search_follows_new_output(void) {
+  static uint8_t mem[8192];
+  Scrollback sb(mem, sizeof(mem));
+  pushText(sb, "Error: first");
+  for (int i = 0; i < 50; i++) pushText(sb, "ok");
+  pushText(sb, "second ERROR here");
+  for (int i = 0; i < 50; i++) pushText(sb, "ok");
+
+  ScrollbackSearch s;
+  sb.searchStart(s, "error");
+  TEST_ASSERT_EQUAL(-1, sb.searchStep(s, 10));
+  for (int i = 0; i < 5; i++) pushText(sb, "more output");   // arrives between frames
+  int32_t hit = sb.searchStep(s, 100);
+  TEST_ASSERT_EQUAL(55, hit);
+  TEST_ASSERT_EQUAL_STRING("second ERROR here", lineAt(sb, hit).c_str());
+  hit = sb.searchStep(s, 100);
+  TEST_ASSERT_EQUAL_STRING("Error: first", lineAt(sb, hit).c_str());
+  TEST_ASSERT_EQUAL(-2, sb.searchStep(s, 100));
+}
+
+void test_benchmark(void) {
+  std::vector<uint8_t> mem(256 * 1024);
+  Scrollback sb(mem.data(), mem.size());
+  char text[64];
+  uint32_t i = 0;
+  while (sb.pushed() == sb.count()) {   // until the ring starts evicting
+    shellLine(i++, text, sizeof(text));
+    pushText(sb, text);
+  }
+  uint32_t lines = sb.count();
+  double perLine = (double)sb.bytesUsed() / lines;
+
+  const int rounds = 20;
+  uint32_t steps = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    ScrollbackSearch s;
+    sb.searchStart(s, "no such text");
+    while (sb.searchStep(s, 256) == -1) steps++;
+  }
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / rounds;
+
+  char report[160];
+  snprintf(report, sizeof(report), "%u lines in %u KB: %.1f bytes per line (%u as cells), full search %.2f ms in %u steps",
+           lines, (unsigned)(mem.size() / 1024), perLine, (unsigned)(COLS * sizeof(TermCell)), ms, steps / rounds + 1);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_TRUE(perLine < COLS);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_only_full_screen_line_feeds_scroll_out);
+  RUN_TEST(test_lines_round_trip_and_evict);
+  RUN_TEST(test_search_follows_new_output);
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
@@ -0,0 +1,193 @@
+// Host tests for the settings blob checks in src/settings_blob.h, run with:
+//   pio test -e native -f test_settings
+// settingsBegin() keeps whatever settingsLoad() leaves in bruceConfig only when it
+// returns true, otherwise it migrates/defaults; settingsWrite() goes through
+// settingsStore(). A fake Preferences stands in for NVS and can lose power mid-write.
+
+#include <unity.h>
+#include <settings_blob.h>
+#include <stddef.h>
+#include <map>
+#include <string>
+#include <vector>
+
+class FakePreferences {
+public:
+  std::map<std::string, std::vector<uint8_t>> entries;
+  int cutAfter = -1;        // the next putBytes loses power after this many bytes
+  bool atomic = true;       // NVS writes the new entry before it drops the old one
+
+  size_t getBytesLength(const char *key) {
+    auto e = entries.find(key);
+    return e == entries.end() ? 0 : e->second.size();
+  }
+  size_t getBytes(const char *key, void *buf, size_t maxLen) {
+    auto e = entries.find(key);
+    if (e == entries.end() || e->second.size() > maxLen) return 0;
+    memcpy(buf, e->second.data(), e->second.size());
+    return e->second.size();
+  }
+  size_t putBytes(const char *key, const void *value, size_t len) {
+    const uint8_t *p = (const uint8_t *)value;
+    if (cutAfter < 0) {
+      entries[key].assign(p, p + len);
+      return len;
+    }
+    size_t reached = (size_t)cutAfter < len ? cutAfter : len;
+    cutAfter = -1;
+    if (!atomic) {
+      // a store that overwrites in place keeps the part that got written
+      std::vector<uint8_t> &e = entries[key];
+      if (e.size() < reached) e.resize(reached);
+      memcpy(e.data(), p, reached);
+    }
+    return 0;
+  }
+};
+
+static BruceConfig makeConfig(uint8_t seed) {
+  BruceConfig c;
+  memset(&c, 0, sizeof(c));
+  c.rotation = seed & 3;
+  c.bright = 10 + seed;
+  c.color = seed % 8;
+  c.irTx = 19;
+  c.irRx = 33;
+  c.rfTx = 32;
+  c.rfRx = 33;
+  c.tmz = seed % 9;
+  snprintf(c.wifiPwd, sizeof(c.wifiPwd), "password-%u", seed);
+  return c;
+}
+
+static const BruceConfig defaults = makeConfig(0);
+static const BruceConfig first = makeConfig(1);
+static const BruceConfig second = makeConfig(2);
+
+// What settingsBegin() ends up with
+static BruceConfig boot(FakePreferences &prefs) {
+  BruceConfig cfg = defaults;
+  settingsLoad(prefs, cfg);
+  return cfg;
+}
+
+static SettingsBlob storedBlob(FakePreferences &prefs) {
+  SettingsBlob blob;
+  memcpy(&blob, prefs.entries[SETTINGS_KEY].data(), sizeof(blob));
+  return blob;
+}
+
+static void putBlob(FakePreferences &prefs, const SettingsBlob &blob) {
+  const uint8_t *p = (const uint8_t *)&blob;
+  prefs.entries[SETTINGS_KEY].assign(p, p + sizeof(blob));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_crc_matches_rom(void) {
+  TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32_le(0, (const uint8_t *)"123456789", 9));
+}
+
+void test_round_trip(void) {
+  FakePreferences prefs;
+  TEST_ASSERT_TRUE(settingsStore(prefs, first));
+  TEST_ASSERT_EQUAL(sizeof(SettingsBlob), prefs.getBytesLength(SETTINGS_KEY));
+  BruceConfig cfg = boot(prefs);
+  TEST_ASSERT_EQUAL_MEMORY(&first, &cfg, sizeof(cfg));
+}
+
+void test_empty_store_gives_defaults(void) {
+  FakePreferences prefs;
+  BruceConfig cfg = defaults;
+  TEST_ASSERT_FALSE(settingsLoad(prefs, cfg));
+  TEST_ASSERT_EQUAL_MEMORY(&defaults, &cfg, sizeof(cfg));
+}
+
+void test_power_cut_keeps_previous_config(void) {
+  FakePreferences prefs;
+  TEST_ASSERT_TRUE(settingsStore(prefs, first));
+  for (int cut = 0; cut < (int)sizeof(SettingsBlob); cut += 7) {
+    prefs.cutAfter = cut;
+    TEST_ASSERT_FALSE(settingsStore(prefs, second));
+    BruceConfig cfg = boot(prefs);
+    TEST_ASSERT_EQUAL_MEMORY(&first, &cfg, sizeof(cfg));
+  }
+}
+
+void test_torn_write_gives_defaults(void) {
+  // without the NVS ordering the blob is half new, half old: the CRC has to catch it
+  FakePreferences prefs;
+  prefs.atomic = false;
+  for (int cut = 1; cut < (int)sizeof(SettingsBlob); cut += 5) {
+    prefs.entries.clear();
+    TEST_ASSERT_TRUE(settingsStore(prefs, first));
+    prefs.cutAfter = cut;
+    settingsStore(prefs, second);
+    BruceConfig cfg = boot(prefs);
+    // the cut may fall where the two blobs agree, a mix of them never gets through
+    bool whole = memcmp(&cfg, &first, sizeof(cfg)) == 0 || memcmp(&cfg, &second, sizeof(cfg)) == 0;
+    TEST_ASSERT_TRUE(whole || memcmp(&cfg, &defaults, sizeof(cfg)) == 0);
+    // the fixed fields differ at the start of cfg, the passwords further on
+    if (cut > (int)offsetof(SettingsBlob, crc) && cut <= (int)offsetof(SettingsBlob, cfg) + 16)
+      TEST_ASSERT_EQUAL_MEMORY(&defaults, &cfg, sizeof(cfg));
+  }
+}
+
+void test_truncated_blob_gives_defaults(void) {
+  FakePreferences prefs;
+  TEST_ASSERT_TRUE(settingsStore(prefs, first));
+  prefs.entries[SETTINGS_KEY].resize(sizeof(SettingsBlob) - 10);
+  BruceConfig cfg = boot(prefs);
+  TEST_ASSERT_EQUAL_MEMORY(&defaults, &cfg, sizeof(cfg));
+
+  prefs.entries[SETTINGS_KEY].resize(sizeof(SettingsBlob) + 4);  // longer is not ours either
+  cfg = boot(prefs);
+  TEST_ASSERT_EQUAL_MEMORY(&defaults, &cfg, sizeof(cfg));
+}
+
+void test_corrupt_blob_gives_defaults(void) {
+  FakePreferences prefs;
+  TEST_ASSERT_TRUE(settingsStore(prefs, first));
+  for (size_t bit = offsetof(SettingsBlob, cfg) * 8; bit < sizeof(SettingsBlob) * 8; bit += 13) {
+    TEST_ASSERT_TRUE(settingsStore(prefs, first));
+    prefs.entries[SETTINGS_KEY][bit / 8] ^= 1 << (bit % 8);
+    BruceConfig cfg = boot(prefs);
+    TEST_ASSERT_EQUAL_MEMORY(&defaults, &cfg, sizeof(cfg));
+  }
+}
+
+void test_other_version_or_layout_gives_defaults(void) {
+  // the CRC is right in both, only the header check can refuse them
+  FakePreferences prefs;
+  TEST_ASSERT_TRUE(settingsStore(prefs, first));
+  SettingsBlob blob = storedBlob(prefs);
+  blob.version = SETTINGS_VERSION + 1;
+  putBlob(prefs, blob);
+  BruceConfig cfg = boot(prefs);
+  TEST_ASSERT_EQUAL_MEMORY(&defaults, &cfg, sizeof(cfg));
+
+  blob.version = SETTINGS_VERSION;
+  blob.size = sizeof(BruceConfig) - 1;
+  putBlob(prefs, blob);
+  cfg = boot(prefs);
+  TEST_ASSERT_EQUAL_MEMORY(&defaults, &cfg, sizeof(cfg));
+
+  blob.size = sizeof(BruceConfig);
+  putBlob(prefs, blob);
+  cfg = boot(prefs);
+  TEST_ASSERT_EQUAL_MEMORY(&first, &cfg, sizeof(cfg));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_crc_matches_rom);
+  RUN_TEST(test_round_trip);
+  RUN_TEST(test_empty_store_gives_defaults);
+  RUN_TEST(test_power_cut_keeps_previous_config);
+  RUN_TEST(test_torn_write_gives_defaults);
+  RUN_TEST(test_truncated_blob_gives_defaults);
+  RUN_TEST(test_corrupt_blob_gives_defaults);
+  RUN_TEST(test_other_version_or_layout_gives_defaults);
+  return UNITY_END();
+}
@@ -0,0 +1,118 @@
+// A small Telnet server on 127.0.0.1 for the client tests. On connect it asks for the
+// window size and terminal type, offers echo, then echoes every data byte back. Two
+// bytes are commands: 'B' answers with a burst of numbered lines ending in "done",
+// 'Q' closes the connection. The negotiation the client sent is kept for checking
+// once the session is over.
+
+#ifndef LOOPBACK_SERVER_H
+#define LOOPBACK_SERVER_H
+
+#include <lwip/sockets.h>
+#include <telnet.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BURST_LINES 2000
+
+class LoopbackServer {
+public:
+  std::vector<uint8_t> negotiation;   // every IAC sequence the client sent
+  std::string data;                   // everything else
+  uint16_t port = 0;
+
+  bool start() {
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    int yes = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrLen = sizeof(addr);
+    if (bind(listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listener, 1) != 0) return false;
+    getsockname(listener, (struct sockaddr *)&addr, &addrLen);
+    port = ntohs(addr.sin_port);
+    thread = std::thread([this] { serve(); });
+    return true;
+  }
+
+  // Waits for the session to end, the client closes its side first
+  void join() {
+    if (thread.joinable()) thread.join();
+    close(listener);
+  }
+
+  // A connected client socket, like telnet_loop() opens
+  int connectClient() {
+    int sock = socket(AF_INET, SOCK_STREAM, IPPROTO_IP);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    addr.sin_port = htons(port);
+    if (connect(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+      close(sock);
+      return -1;
+    }
+    return sock;
+  }
+
+  static std::vector<uint8_t> burst() {
+    std::string text;
+    char line[48];
+    for (int i = 0; i < BURST_LINES; i++) {
+      snprintf(line, sizeof(line), "%05d the quick brown fox\r\n", i);
+      text += line;
+    }
+    text += "done";
+    return std::vector<uint8_t>(text.begin(), text.end());
+  }
+
+private:
+  int listener = -1;
+  std::thread thread;
+
+  void serve() {
+    int conn = accept(listener, NULL, NULL);
+    if (conn < 0) return;
+    int one = 1;
+    setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    const uint8_t hello[] = {
+      TN_IAC, TN_DO, TN_NAWS, TN_IAC, TN_DO, TN_TTYPE, TN_IAC, TN_WILL, TN_ECHO, TN_IAC, TN_WILL, TN_SGA,
+      TN_IAC, TN_SB, TN_TTYPE, 1, TN_IAC, TN_SE,
+      'l', 'o', 'g', 'i', 'n', ':', ' ',
+    };
+    send(conn, hello, sizeof(hello), 0);
+
+    uint8_t buf[256];
+    bool inIac = false, inSb = false;
+    int len;
+    while ((len = recv(conn, buf, sizeof(buf), 0)) > 0) {
+      for (int i = 0; i < len; i++) {
+        uint8_t c = buf[i];
+        // sequences are at most IAC verb option or IAC SB ... IAC SE
+        if (inIac || inSb || c == TN_IAC) {
+          negotiation.push_back(c);
+          if (inSb) inSb = !(c == TN_SE && negotiation[negotiation.size() - 2] == TN_IAC);
+          else if (c == TN_SB) { inSb = true; inIac = false; }
+          else if (c == TN_IAC) inIac = true;
+          else if (c < TN_WILL) inIac = false;
+          continue;
+        }
+        data += (char)c;
+        if (c == 'B') {
+          std::vector<uint8_t> text = burst();
+          send(conn, text.data(), text.size(), 0);
+        } else if (c == 'Q') {
+          close(conn);
+          return;
+        } else {
+          send(conn, &c, 1, 0);
+        }
+      }
+    }
+    close(conn);
+  }
+};
+
+#endif
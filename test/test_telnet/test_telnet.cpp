@@ -0,0 +1,195 @@
+// Host tests for src/telnet.cpp, run with: pio test -e native -f test_telnet
+// telnetFilter is checked byte for byte against the sequences RFC 854/1073/1091 expect.
+// The session tests run telnetPoll, the loop telnet_loop() runs every frame, against
+// loopback_server.h over a real TCP socket on 127.0.0.1 and measure:
+//   - keystroke to echo latency, the old client slept a second after every command
+//   - how many frames a burst larger than any buffer takes, the old client read
+//     127 bytes per command and dropped the rest
+
+#include <unity.h>
+#include <telnet.h>
+#include "loopback_server.h"
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#define COLS 40
+#define ROWS 16
+#define FRAME_US 20000
+
+static TelnetParser newParser(uint8_t cols = COLS, uint8_t rows = ROWS) {
+  TelnetParser tn;
+  memset(&tn, 0, sizeof(tn));
+  tn.cols = cols;
+  tn.rows = rows;
+  return tn;
+}
+
+static std::vector<uint8_t> filter(TelnetParser &tn, std::vector<uint8_t> in) {
+  size_t n = telnetFilter(tn, in.data(), in.size());
+  in.resize(n);
+  return in;
+}
+
+static std::vector<uint8_t> takeReply(TelnetParser &tn) {
+  std::vector<uint8_t> r(tn.reply, tn.reply + tn.replyLen);
+  tn.replyLen = 0;
+  return r;
+}
+
+static std::string screenRow(const Terminal &t, uint8_t y) {
+  std::string s;
+  for (uint8_t x = 0; x < t.width(); x++) s += t.row(y)[x].ch;
+  return s.substr(0, s.find_last_not_of(' ') + 1);
+}
+
+#define ASSERT_BYTES(expected, actual) do { \
+    std::vector<uint8_t> e = expected, a = actual; \
+    TEST_ASSERT_EQUAL(e.size(), a.size()); \
+    TEST_ASSERT_EQUAL_MEMORY(e.data(), a.data(), e.size()); \
+  } while (0)
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_naws_sequence(void) {
+  TelnetParser tn = newParser();
+  TEST_ASSERT_EQUAL(0, filter(tn, {TN_IAC, TN_DO, TN_NAWS}).size());
+  ASSERT_BYTES(std::vector<uint8_t>({TN_IAC, TN_WILL, TN_NAWS,
+                                     TN_IAC, TN_SB, TN_NAWS, 0, COLS, 0, ROWS, TN_IAC, TN_SE}), takeReply(tn));
+
+  // a 255 in the size is doubled so the server does not read it as IAC
+  TelnetParser wide = newParser(255, 255);
+  filter(wide, {TN_IAC, TN_DO, TN_NAWS});
+  ASSERT_BYTES(std::vector<uint8_t>({TN_IAC, TN_WILL, TN_NAWS,
+                                     TN_IAC, TN_SB, TN_NAWS, 0, TN_IAC, TN_IAC, 0, TN_IAC, TN_IAC, TN_IAC, TN_SE}),
+               takeReply(wide));
+}
+
+void test_option_answers(void) {
+  TelnetParser tn = newParser();
+  filter(tn, {TN_IAC, TN_WILL, TN_ECHO, TN_IAC, TN_WILL, TN_SGA, TN_IAC, TN_WILL, 34});
+  ASSERT_BYTES(std::vector<uint8_t>({TN_IAC, TN_DO, TN_ECHO, TN_IAC, TN_DO, TN_SGA, TN_IAC, TN_DONT, 34}), takeReply(tn));
+  filter(tn, {TN_IAC, TN_DO, TN_TTYPE, TN_IAC, TN_DO, 32, TN_IAC, TN_WONT, TN_ECHO, TN_IAC, TN_DONT, TN_NAWS});
+  ASSERT_BYTES(std::vector<uint8_t>({TN_IAC, TN_WILL, TN_TTYPE, TN_IAC, TN_WONT, 32}), takeReply(tn));
+  filter(tn, {TN_IAC, TN_SB, TN_TTYPE, 1, TN_IAC, TN_SE});
+  ASSERT_BYTES(std::vector<uint8_t>({TN_IAC, TN_SB, TN_TTYPE, 0, 'V', 'T', '1', '0', '0', TN_IAC, TN_SE}), takeReply(tn));
+}
+
+// Commands split over recv() blocks, escaped 255 and NOP/GA leave only the data
+void test_filter_keeps_data_across_blocks(void) {
+  TelnetParser tn = newParser();
+  ASSERT_BYTES(std::vector<uint8_t>({'a'}), filter(tn, {'a', TN_IAC}));
+  ASSERT_BYTES(std::vector<uint8_t>({}), filter(tn, {TN_DO}));
+  ASSERT_BYTES(std::vector<uint8_t>({'c', 0xFF, 'd'}), filter(tn, {TN_NAWS, 'c', TN_IAC, TN_IAC, 'd', TN_IAC, TN_SB, TN_TTYPE}));
+  ASSERT_BYTES(std::vector<uint8_t>({}), filter(tn, {1, TN_IAC}));
+  ASSERT_BYTES(std::vector<uint8_t>({'e', 'f'}), filter(tn, {TN_SE, 'e', TN_IAC, 241, TN_IAC, 249, 'f'}));
+  std::vector<uint8_t> reply = takeReply(tn);
+  TEST_ASSERT_EQUAL(3 + 9 + 11, reply.size());   // WILL NAWS, the size, TTYPE IS
+}
+
+void test_session_over_loopback(void) {
+  LoopbackServer server;
+  TEST_ASSERT_TRUE(server.start());
+  int sock = server.connectClient();
+  TEST_ASSERT_TRUE(sock >= 0);
+  Terminal term(COLS, ROWS);
+  TelnetParser tn = newParser();
+
+  for (int frame = 0; frame < 50 && screenRow(term, 0) != "login:"; frame++) telnetPoll(sock, tn, term, FRAME_US);
+  TEST_ASSERT_EQUAL_STRING("login:", screenRow(term, 0).c_str());
+
+  send(sock, "root", 4, 0);
+  for (int frame = 0; frame < 50 && screenRow(term, 0) != "login: root"; frame++) telnetPoll(sock, tn, term, FRAME_US);
+  TEST_ASSERT_EQUAL_STRING("login: root", screenRow(term, 0).c_str());
+
+  send(sock, "Q", 1, 0);
+  int got = 0;
+  for (int frame = 0; frame < 50 && got >= 0; frame++) got = telnetPoll(sock, tn, term, FRAME_US);
+  TEST_ASSERT_EQUAL(-1, got);
+  close(sock);
+  server.join();
+
+  // the server saw our answers in order and the data bytes without any IAC
+  ASSERT_BYTES(std::vector<uint8_t>({TN_IAC, TN_WILL, TN_NAWS, TN_IAC, TN_SB, TN_NAWS, 0, COLS, 0, ROWS, TN_IAC, TN_SE,
+                                     TN_IAC, TN_WILL, TN_TTYPE, TN_IAC, TN_DO, TN_ECHO, TN_IAC, TN_DO, TN_SGA,
+                                     TN_IAC, TN_SB, TN_TTYPE, 0, 'V', 'T', '1', '0', '0', TN_IAC, TN_SE}),
+               server.negotiation);
+  TEST_ASSERT_EQUAL_STRING("rootQ", server.data.c_str());
+}
+
+void test_burst_is_drained(void) {
+  LoopbackServer server;
+  TEST_ASSERT_TRUE(server.start());
+  int sock = server.connectClient();
+  Terminal term(COLS, ROWS);
+  TelnetParser tn = newParser();
+  for (int frame = 0; frame < 50 && screenRow(term, 0) != "login:"; frame++) telnetPoll(sock, tn, term, FRAME_US);
+  uint32_t start = tn.rxBytes;
+
+  const size_t expected = LoopbackServer::burst().size();
+  send(sock, "B", 1, 0);
+  int frames = 0, wakeups = 0;
+  while (tn.rxBytes - start < expected && frames < 500) {
+    if (telnetPoll(sock, tn, term, FRAME_US) > 0) wakeups++;
+    frames++;
+  }
+  TEST_ASSERT_EQUAL(expected, tn.rxBytes - start);
+  TEST_ASSERT_EQUAL_STRING("done", screenRow(term, ROWS - 1).c_str());
+  TEST_ASSERT_EQUAL_STRING("01999 the quick brown fox", screenRow(term, ROWS - 2).c_str());
+  TEST_ASSERT_EQUAL(BURST_LINES - (ROWS - 1), term.getStats().scrolls);   // every line reached the terminal
+
+  char report[128];
+  snprintf(report, sizeof(report), "%u byte burst drained in %d frames (%d with data), lockstep 127 B reads would take %u commands",
+           (unsigned)expected, frames, wakeups, (unsigned)((expected + 126) / 127));
+  TEST_MESSAGE(report);
+  TEST_ASSERT_TRUE(frames < 50);
+
+  close(sock);
+  server.join();
+}
+
+void test_keystroke_latency(void) {
+  LoopbackServer server;
+  TEST_ASSERT_TRUE(server.start());
+  int sock = server.connectClient();
+  int one = 1;
+  setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  Terminal term(COLS, ROWS);
+  TelnetParser tn = newParser();
+  for (int frame = 0; frame < 50 && screenRow(term, 0) != "login:"; frame++) telnetPoll(sock, tn, term, FRAME_US);
+
+  const int rounds = 500;
+  std::vector<double> us;
+  for (int i = 0; i < rounds; i++) {
+    char key = 'a' + i % 26;
+    auto t0 = std::chrono::steady_clock::now();
+    send(sock, &key, 1, 0);
+    int got = 0;
+    for (int frame = 0; frame < 50 && got == 0; frame++) got = telnetPoll(sock, tn, term, FRAME_US);
+    TEST_ASSERT_EQUAL(1, got);
+    us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+  }
+  std::sort(us.begin(), us.end());
+  char report[128];
+  snprintf(report, sizeof(report), "keystroke to echo over loopback, %d rounds: median %.0f us, p99 %.0f us, max %.0f us",
+           rounds, us[rounds / 2], us[rounds * 99 / 100], us[rounds - 1]);
+  TEST_MESSAGE(report);
+  TEST_ASSERT_TRUE(us[rounds / 2] < FRAME_US);   // answered within the frame it arrived in
+
+  close(sock);
+  server.join();
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_naws_sequence);
+  RUN_TEST(test_option_answers);
+  RUN_TEST(test_filter_keeps_data_across_blocks);
+  RUN_TEST(test_session_over_loopback);
+  RUN_TEST(test_burst_is_drained);
+  RUN_TEST(test_keystroke_latency);
+  return UNITY_END();
+}
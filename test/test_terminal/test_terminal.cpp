@@ -0,0 +1,179 @@
+// Host tests for src/terminal.cpp, run with: pio test -e native -f test_terminal
+// Each test feeds a VT100 byte stream the way the SSH and Telnet clients do and checks
+// the cell grid afterwards. Rows are compared as text, trailing blanks included.
+
+#include <unity.h>
+#include <terminal.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+static std::string line(const Terminal &t, uint8_t y) {
+  std::string s;
+  for (uint8_t x = 0; x < t.width(); x++) s += t.row(y)[x].ch;
+  return s;
+}
+
+static std::string screen(const Terminal &t) {
+  std::string s;
+  for (uint8_t y = 0; y < t.height(); y++) s += line(t, y) + "|";
+  return s;
+}
+
+// 8x5, rows filled with 0...., 1.... so moves and scrolls can be told apart
+static void fill(Terminal &t) {
+  for (int y = 0; y < t.height(); y++) {
+    char text[32];
+    snprintf(text, sizeof(text), "\x1b[%d;1H%d%.*s", y + 1, y, t.width() - 1, "abcdefghijklmnop");
+    t.write(text);
+  }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_cursor_position(void) {
+  Terminal t(8, 5);
+  t.write("\x1b[2;3Hab\x1b[5;8Hz\x1b[Hq\x1b[3dm\x1b[6Gn");
+  TEST_ASSERT_EQUAL_STRING("q       |  ab    | m   n  |        |       z|", screen(t).c_str());
+  TEST_ASSERT_EQUAL(6, t.cursorX());
+  TEST_ASSERT_EQUAL(2, t.cursorY());
+  // out of range rows and columns stop at the edge
+  t.write("\x1b[99;99H");
+  TEST_ASSERT_EQUAL(7, t.cursorX());
+  TEST_ASSERT_EQUAL(4, t.cursorY());
+}
+
+void test_erase_in_display_and_line(void) {
+  Terminal t(8, 5);
+  fill(t);
+  t.write("\x1b[2;4H\x1b[K");   // EL 0, cursor to end of line
+  t.write("\x1b[3;4H\x1b[1K");  // EL 1, start of line to cursor
+  t.write("\x1b[4;4H\x1b[2K");  // EL 2, whole line
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|1ab     |    defg|        |4abcdefg|", screen(t).c_str());
+
+  fill(t);
+  t.write("\x1b[3;4H\x1b[J");   // ED 0, cursor to end of screen
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|1abcdefg|2ab     |        |        |", screen(t).c_str());
+  fill(t);
+  t.write("\x1b[3;4H\x1b[1J");  // ED 1, start of screen to cursor
+  TEST_ASSERT_EQUAL_STRING("        |        |    defg|3abcdefg|4abcdefg|", screen(t).c_str());
+  t.write("\x1b[2J");
+  TEST_ASSERT_EQUAL_STRING("        |        |        |        |        |", screen(t).c_str());
+}
+
+void test_scroll_region(void) {
+  Terminal t(8, 5);
+  fill(t);
+  t.write("\x1b[2;4r");          // DECSTBM homes the cursor
+  TEST_ASSERT_EQUAL(0, t.cursorY());
+  t.write("\x1b[4;1H\nX");       // LF on the bottom margin scrolls rows 2..4 only
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|2abcdefg|3abcdefg|X       |4abcdefg|", screen(t).c_str());
+  t.write("\x1b[2;1H\x1bMY");    // RI on the top margin scrolls the region down
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|Y       |2abcdefg|3abcdefg|4abcdefg|", screen(t).c_str());
+  t.write("\x1b[3;1H\x1b[L");    // IL inside the region pushes rows to the bottom margin
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|Y       |        |2abcdefg|4abcdefg|", screen(t).c_str());
+  t.write("\x1b[M");             // DL pulls them back
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|Y       |2abcdefg|        |4abcdefg|", screen(t).c_str());
+  t.write("\x1b[5;1H\x1b[L");    // IL below the region does nothing
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|Y       |2abcdefg|        |4abcdefg|", screen(t).c_str());
+  t.write("\x1b[5;1H\n\nZ");     // LF below the region stops at the last row
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|Y       |2abcdefg|        |Zabcdefg|", screen(t).c_str());
+  t.write("\x1b[r");             // back to the whole screen
+  t.write("\x1b[5;1H\n");
+  TEST_ASSERT_EQUAL_STRING("Y       |2abcdefg|        |Zabcdefg|        |", screen(t).c_str());
+}
+
+void test_autowrap(void) {
+  Terminal t(8, 3);
+  t.write("12345678");           // the last column holds the cursor until the next char
+  TEST_ASSERT_EQUAL(7, t.cursorX());
+  TEST_ASSERT_EQUAL(0, t.cursorY());
+  t.write("\r\n");
+  TEST_ASSERT_EQUAL_STRING("12345678|        |        |", screen(t).c_str());
+  t.write("abcdefghij");
+  TEST_ASSERT_EQUAL_STRING("12345678|abcdefgh|ij      |", screen(t).c_str());
+  t.write("\x1b[3;8Hxy");        // a wrap on the last row scrolls
+  TEST_ASSERT_EQUAL_STRING("abcdefgh|ij     x|y       |", screen(t).c_str());
+}
+
+void test_sgr(void) {
+  Terminal t(8, 2);
+  t.write("\x1b[1;31;44mA\x1b[4;7;92mB\x1b[22;24;27;39;49mC\x1b[0;33mD\x1b[mE\x1b[38;5;200;42mF\x1b[48;2;1;2;3;35mG");
+  const TermCell *r = t.row(0);
+  TEST_ASSERT_EQUAL(1, r[0].fg);
+  TEST_ASSERT_EQUAL(4, r[0].bg);
+  TEST_ASSERT_EQUAL(TERM_ATTR_BOLD, r[0].attr);
+  TEST_ASSERT_EQUAL(10, r[1].fg);
+  TEST_ASSERT_EQUAL(TERM_ATTR_BOLD | TERM_ATTR_UNDER | TERM_ATTR_INVERSE, r[1].attr);
+  TEST_ASSERT_EQUAL(TERM_DEFAULT_FG, r[2].fg);
+  TEST_ASSERT_EQUAL(TERM_DEFAULT_BG, r[2].bg);
+  TEST_ASSERT_EQUAL(0, r[2].attr);
+  TEST_ASSERT_EQUAL(3, r[3].fg);
+  TEST_ASSERT_EQUAL(TERM_DEFAULT_FG, r[4].fg);
+  TEST_ASSERT_EQUAL(2, r[5].bg);                // 38;5;n is skipped, 42 still applies
+  TEST_ASSERT_EQUAL(TERM_DEFAULT_FG, r[5].fg);
+  TEST_ASSERT_EQUAL(5, r[6].fg);                // 48;2;r;g;b is skipped, 35 applies
+  // erased cells take the pen's background, not its attributes
+  t.write("\x1b[0;1;41m\x1b[2;1H\x1b[K");
+  TEST_ASSERT_EQUAL(1, t.row(1)[5].bg);
+  TEST_ASSERT_EQUAL(0, t.row(1)[5].attr);
+}
+
+// Parameters up to 10000 reach the handlers, counts past the screen must not wrap
+// around in 8 bits: 256 used to scroll nothing and 257;5r set a region from row 1
+void test_large_parameters(void) {
+  Terminal t(8, 5);
+  fill(t);
+  t.write("\x1b[256S");
+  TEST_ASSERT_EQUAL_STRING("        |        |        |        |        |", screen(t).c_str());
+  fill(t);
+  t.write("\x1b[256T");
+  TEST_ASSERT_EQUAL_STRING("        |        |        |        |        |", screen(t).c_str());
+  fill(t);
+  t.write("\x1b[2;1H\x1b[512M");
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|        |        |        |        |", screen(t).c_str());
+  fill(t);
+  t.write("\x1b[4;1H\x1b[768L");
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|1abcdefg|2abcdefg|        |        |", screen(t).c_str());
+  fill(t);
+  t.write("\x1b[3;1H\x1b[260P\x1b[4;2H\x1b[263@\x1b[5;3H\x1b[65535X");
+  TEST_ASSERT_EQUAL_STRING("0abcdefg|1abcdefg|        |3       |4a      |", screen(t).c_str());
+  fill(t);
+  t.write("\x1b[257;5r");        // top past the screen, ignored
+  t.write("\x1b[5;1H\n");
+  TEST_ASSERT_EQUAL_STRING("1abcdefg|2abcdefg|3abcdefg|4abcdefg|        |", screen(t).c_str());
+  t.write("\x1b[65535;65535H");
+  TEST_ASSERT_EQUAL(7, t.cursorX());
+  TEST_ASSERT_EQUAL(4, t.cursorY());
+}
+
+// A shell session chopped at every byte boundary ends on the same screen as in one write
+void test_split_stream(void) {
+  const char *session =
+    "\x1b[?25l\x1b]0;root@bruce: ~\x07\x1b[H\x1b[2J"
+    "\x1b[1;32mroot@bruce\x1b[0m:\x1b[1;34m~\x1b[0m$ ls\r\n"
+    "\x1b[0m\x1b[01;34mbin\x1b[0m  \x1b[01;32mrun.sh\x1b[0m\r\n"
+    "\x1b[2;4r\x1b[4;1H\nwrap me over the edge\x1b[r\x1b[1;1H\x1b[2K\xe2\x94\x80\xc3\xa9!"
+    "\x1b[?25h";
+  Terminal whole(12, 5), split(12, 5);
+  whole.write(session);
+  for (const char *p = session; *p; p++) split.write((const uint8_t *)p, 1);
+  TEST_ASSERT_EQUAL_STRING(screen(whole).c_str(), screen(split).c_str());
+  TEST_ASSERT_EQUAL_STRING("?" "?!         |            |wrap me over| the edge   |            |", screen(whole).c_str());
+  TEST_ASSERT_TRUE(whole.cursorVisible());
+  TEST_ASSERT_EQUAL(whole.getStats().sequences, split.getStats().sequences);
+  TEST_ASSERT_EQUAL(0, whole.getStats().unknown);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_cursor_position);
+  RUN_TEST(test_erase_in_display_and_line);
+  RUN_TEST(test_scroll_region);
+  RUN_TEST(test_autowrap);
+  RUN_TEST(test_sgr);
+  RUN_TEST(test_large_parameters);
+  RUN_TEST(test_split_stream);
+  return UNITY_END();
+}
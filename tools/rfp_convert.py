@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Decoder and converter for the .rfp pulse recordings made by RF > Record RAW.
+
+Usage:
+    rfp_convert.py info capture.rfp
+    rfp_convert.py csv  capture.rfp out.csv     # burst,time_ms,level,duration_us
+    rfp_convert.py ook  capture.rfp out.ook     # rtl_433 pulse data (-r out.ook)
+    rfp_convert.py sub  capture.rfp out.sub     # Flipper Zero RAW .sub
+
+File layout is described on top of rf_record() in src/rf.cpp.
+"""
+import struct
+import sys
+
+HEADER_SIZE = 12
+FOOTER_SIZE = 16
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if b < 0x80:
+            return value, pos
+        shift += 7
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def load(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"RFP1":
+        raise ValueError("not an .rfp file")
+    tick_ns, start_ms = struct.unpack_from("<II", data, 4)
+
+    body_end = len(data)
+    index = []
+    if len(data) >= HEADER_SIZE + FOOTER_SIZE and data[-4:] == b"RFPX":
+        index_off, count, _bursts = struct.unpack_from("<III", data, len(data) - FOOTER_SIZE)
+        index = [struct.unpack_from("<II", data, index_off + 8 * i) for i in range(count)]
+        body_end = index_off
+    # a recording cut by a power loss has no footer, every complete burst is still valid
+
+    bursts = []
+    pos = HEADER_SIZE
+    time_ms = 0
+    while pos < body_end:
+        try:
+            dt, pos = read_varint(data, pos)
+            n, pos = read_varint(data, pos)
+            level = data[pos]
+            pos += 1
+            prev = [0, 0]
+            durations = []
+            for k in range(n):
+                v, pos = read_varint(data, pos)
+                d = prev[k & 1] + unzigzag(v)
+                prev[k & 1] = d
+                durations.append(d * tick_ns // 1000)
+        except IndexError:
+            break
+        time_ms += dt
+        bursts.append((time_ms, level, durations))
+    return {"tick_ns": tick_ns, "start_ms": start_ms, "index": index, "bursts": bursts}
+
+
+def pulses(level, durations):
+    for d in durations:
+        yield level, d
+        level ^= 1
+
+
+def write_csv(rec, out):
+    out.write("burst,time_ms,level,duration_us\n")
+    for i, (t, level, durations) in enumerate(rec["bursts"]):
+        for lv, d in pulses(level, durations):
+            out.write("%d,%d,%d,%d\n" % (i, t, lv, d))
+
+
+def write_ook(rec, out):
+    out.write(";pulse data\n;version 1\n;timescale 1us\n;freq1 433920000\n")
+    for t, level, durations in rec["bursts"]:
+        out.write(";received %d ms\n" % t)
+        items = list(pulses(level, durations))
+        if items and items[0][0] == 0:
+            items.insert(0, (1, 0))
+        for i in range(0, len(items), 2):
+            mark = items[i][1]
+            space = items[i + 1][1] if i + 1 < len(items) else 10000
+            out.write("%d %d\n" % (mark, space))
+        out.write(";end\n")
+
+
+def write_sub(rec, out):
+    out.write("Filetype: Flipper SubGhz RAW File\nVersion: 1\n")
+    out.write("Frequency: 433920000\nPreset: FuriHalSubGhzPresetOok650Async\nProtocol: RAW\n")
+    values = []
+    for _t, level, durations in rec["bursts"]:
+        values.extend(d if lv else -d for lv, d in pulses(level, durations))
+    for i in range(0, len(values), 512):
+        out.write("RAW_Data: " + " ".join(str(v) for v in values[i:i + 512]) + "\n")
+
+
+def main(argv):
+    if len(argv) < 3 or argv[1] not in ("info", "csv", "ook", "sub"):
+        print(__doc__)
+        return 1
+    rec = load(argv[2])
+    if argv[1] == "info":
+        total = sum(len(b[2]) for b in rec["bursts"])
+        span = rec["bursts"][-1][0] if rec["bursts"] else 0
+        print("tick: %d ns" % rec["tick_ns"])
+        print("bursts: %d, pulses: %d, span: %.1f s" % (len(rec["bursts"]), total, span / 1000.0))
+        print("index entries: %d" % len(rec["index"]))
+        return 0
+    writer = {"csv": write_csv, "ook": write_ook, "sub": write_sub}[argv[1]]
+    with open(argv[3], "w") as out:
+        writer(rec, out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
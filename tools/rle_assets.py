@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""Converts 1 bit images into the run length encoded arrays drawn by drawRle().
+
+Usage:
+    rle_assets.py src/assets.h media/xbm/bruce_logo.xbm
+    rle_assets.py src/assets.h icon.png             # PNG needs Pillow, dark pixels are set
+
+Pixels are read row by row like the display fills a window, spans may go over the
+end of a row. The image is a list of tokens, each a varint (7 bits per byte, low
+bits first, high bit = more bytes) holding count << 2 | kind:
+    kind 0  count clear pixels
+    kind 1  count set pixels
+    kind 2  count literal pixels, followed by (count + 7) / 8 bytes, low bit first
+Runs shorter than MIN_RUN go in literals, dithered parts of the logo cost one bit
+per pixel instead of a varint per run.
+"""
+import os
+import re
+import sys
+
+MIN_RUN = 16
+
+
+def read_xbm(path):
+    text = open(path).read()
+    width = int(re.search(r"_width\s+(\d+)", text).group(1))
+    height = int(re.search(r"_height\s+(\d+)", text).group(1))
+    data = [int(v, 16) for v in re.findall(r"0x([0-9A-Fa-f]{2})", text)]
+    stride = (width + 7) // 8
+    if len(data) < stride * height:
+        raise ValueError("%s: %d bytes, %d expected" % (path, len(data), stride * height))
+    pixels = []
+    for y in range(height):
+        for x in range(width):
+            pixels.append(bool(data[y * stride + x // 8] & (1 << (x & 7))))
+    return width, height, pixels, stride * height
+
+
+def read_png(path):
+    from PIL import Image
+    img = Image.open(path).convert("L")
+    width, height = img.size
+    pixels = [v < 128 for v in img.getdata()]
+    return width, height, pixels, (width + 7) // 8 * height
+
+
+def write_varint(out, value):
+    while value >= 0x80:
+        out.append((value & 0x7F) | 0x80)
+        value >>= 7
+    out.append(value)
+
+
+def read_varint(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        b = data[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if b < 0x80:
+            return value, pos
+        shift += 7
+
+
+def pack_bits(pixels):
+    out = bytearray((len(pixels) + 7) // 8)
+    for i, p in enumerate(pixels):
+        if p:
+            out[i // 8] |= 1 << (i & 7)
+    return out
+
+
+def encode(pixels):
+    out = bytearray()
+    literal_from = 0
+    i = 0
+    while i <= len(pixels):
+        j = i
+        while j < len(pixels) and pixels[j] == pixels[i]:
+            j += 1
+        if j - i >= MIN_RUN or i == len(pixels):
+            if literal_from < i:
+                write_varint(out, (i - literal_from) << 2 | 2)
+                out += pack_bits(pixels[literal_from:i])
+            if i == len(pixels):
+                break
+            write_varint(out, (j - i) << 2 | pixels[i])
+            literal_from = j
+        i = j
+    return out
+
+
+def decode(data):
+    pixels = []
+    pos = 0
+    while pos < len(data):
+        token, pos = read_varint(data, pos)
+        count, kind = token >> 2, token & 3
+        if kind == 2:
+            pixels.extend(bool(data[pos + k // 8] & (1 << (k & 7))) for k in range(count))
+            pos += (count + 7) // 8
+        else:
+            pixels.extend([kind == 1] * count)
+    return pixels
+
+
+def c_array(data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("  " + " ".join("0x%02X," % b for b in data[i:i + 16]))
+    return "\n".join(lines)
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__)
+        return 1
+    out_path, inputs = argv[1], argv[2:]
+    parts = []
+    for path in inputs:
+        name = os.path.splitext(os.path.basename(path))[0]
+        if path.lower().endswith(".png"):
+            width, height, pixels, raw = read_png(path)
+        else:
+            width, height, pixels, raw = read_xbm(path)
+        rle = encode(pixels)
+        if decode(rle) != pixels:
+            raise ValueError("%s: round trip failed" % path)
+        print("%-16s %3dx%-3d %5d bytes as bitmap, %5d as RLE" % (name, width, height, raw, len(rle)))
+        parts.append(
+            "// %s, %dx%d: %d bytes as bitmap, %d as RLE\n"
+            "static const uint8_t %s_rle[] PROGMEM = {\n%s\n};\n"
+            "static const RleImage %s = { %d, %d, sizeof(%s_rle), %s_rle };\n"
+            % (os.path.basename(path), width, height, raw, len(rle),
+               name, c_array(rle), name, width, height, name, name))
+
+    with open(out_path, "w") as f:
+        f.write("// Generated by tools/rle_assets.py from %s, do not edit\n"
+                % ", ".join(p.replace(os.sep, "/") for p in inputs))
+        f.write("#ifndef ASSETS_H\n#define ASSETS_H\n\n#include \"rle.h\"\n\n")
+        f.write("\n".join(parts))
+        f.write("\n#endif\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))